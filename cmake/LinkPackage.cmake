@@ -8,13 +8,13 @@ function(link_package NAME)
         # which (later) cmake considers to be an error. Work around this with by stripping the incoming string.
         if(LP_TARGET AND TARGET ${LP_TARGET})
             string(STRIP "${LP_TARGET}" LP_TARGET)
-            target_link_libraries(openttd ${LP_TARGET})
+            target_link_libraries(openttd_lib ${LP_TARGET})
             message(STATUS "${NAME} found -- -DWITH_${UCNAME} -- ${LP_TARGET}")
         else()
             string(STRIP "${${NAME}_LIBRARY}" ${NAME}_LIBRARY)
             string(STRIP "${${NAME}_LIBRARIES}" ${NAME}_LIBRARIES)
             include_directories(${${NAME}_INCLUDE_DIRS} ${${NAME}_INCLUDE_DIR})
-            target_link_libraries(openttd ${${NAME}_LIBRARIES} ${${NAME}_LIBRARY})
+            target_link_libraries(openttd_lib ${${NAME}_LIBRARIES} ${${NAME}_LIBRARY})
             message(STATUS "${NAME} found -- -DWITH_${UCNAME} -- ${${NAME}_INCLUDE_DIRS} ${${NAME}_INCLUDE_DIR} -- ${${NAME}_LIBRARIES} ${${NAME}_LIBRARY}")
         endif()
     elseif(LP_ENCOURAGED)
@@ -65,6 +65,7 @@ function(set_options)
         option(OPTION_USE_THREADS "Use threads" ON)
     endif()
     option(OPTION_USE_NSIS "Use NSIS to create windows installer; enable only for stable releases" OFF)
+    option(OPTION_MAP_PLANES "Store the map as a separate array per tile member instead of an array of tiles" OFF)
     option(OPTION_TOOLS_ONLY "Build only tools target" OFF)
     option(OPTION_DOCS_ONLY "Build only docs target" OFF)
 
@@ -84,6 +85,7 @@ function(show_options)
     message(STATUS "Option Use assert - ${OPTION_USE_ASSERTS}")
     message(STATUS "Option Use threads - ${OPTION_USE_THREADS}")
     message(STATUS "Option Use NSIS - ${OPTION_USE_NSIS}")
+    message(STATUS "Option Map planes - ${OPTION_MAP_PLANES}")
 endfunction()
 
 # Add the definitions for the options that are selected.
@@ -99,6 +101,10 @@ function(add_definitions_based_on_options)
         add_definitions(-DNO_THREADS)
     endif()
 
+    if(OPTION_MAP_PLANES)
+        add_definitions(-DWITH_MAP_PLANES)
+    endif()
+
     if(OPTION_USE_ASSERTS)
         add_definitions(-DWITH_ASSERT)
     else()
@@ -16,11 +16,54 @@ function(add_files)
         endif()
     endif()
 
+    foreach(FILE IN LISTS PARAM_FILES)
+        target_sources(openttd_lib PRIVATE ${CMAKE_CURRENT_SOURCE_DIR}/${FILE})
+    endforeach()
+endfunction()
+
+# Add a file to be compiled into the game only, and not into the unit tests.
+# This is for the file with main(), as the unit tests have their own.
+#
+# add_main_files([file1 ...] CONDITION condition [condition ...])
+#
+# See add_files() for the CONDITION.
+#
+function(add_main_files)
+    cmake_parse_arguments(PARAM "" "" "CONDITION" ${ARGN})
+    set(PARAM_FILES "${PARAM_UNPARSED_ARGUMENTS}")
+
+    if(PARAM_CONDITION)
+        if(NOT (${PARAM_CONDITION}))
+            return()
+        endif()
+    endif()
+
     foreach(FILE IN LISTS PARAM_FILES)
         target_sources(openttd PRIVATE ${CMAKE_CURRENT_SOURCE_DIR}/${FILE})
     endforeach()
 endfunction()
 
+# Add a file to be compiled into the unit tests.
+#
+# add_test_files([file1 ...] CONDITION condition [condition ...])
+#
+# See add_files() for the CONDITION.
+#
+function(add_test_files)
+    cmake_parse_arguments(PARAM "" "" "CONDITION" ${ARGN})
+    set(PARAM_FILES "${PARAM_UNPARSED_ARGUMENTS}")
+
+    if(PARAM_CONDITION)
+        if(NOT (${PARAM_CONDITION}))
+            return()
+        endif()
+    endif()
+
+    foreach(FILE IN LISTS PARAM_FILES)
+        target_sources(openttd_test PRIVATE ${CMAKE_CURRENT_SOURCE_DIR}/${FILE})
+    endforeach()
+endfunction()
+
 # This function works around an 'issue' with CMake, where
 # set_source_files_properties() only works in the scope of the file. We want
 # to set properties for the source file on a more global level. To solve this,
@@ -175,6 +175,7 @@ typedef SQInteger (*SQFUNCTION)(HSQUIRRELVM);
 typedef SQInteger (*SQRELEASEHOOK)(SQUserPointer,SQInteger size);
 typedef void (*SQCOMPILERERROR)(HSQUIRRELVM,const SQChar * /*desc*/,const SQChar * /*source*/,SQInteger /*line*/,SQInteger /*column*/);
 typedef void (*SQPRINTFUNCTION)(HSQUIRRELVM,const SQChar * ,...);
+typedef bool (*SQSUSPENDCHECK)(HSQUIRRELVM);
 
 typedef SQInteger (*SQWRITEFUNC)(SQUserPointer,SQUserPointer,SQInteger);
 typedef SQInteger (*SQREADFUNC)(SQUserPointer,SQUserPointer,SQInteger);
@@ -205,6 +206,7 @@ void sq_setforeignptr(HSQUIRRELVM v,SQUserPointer p);
 SQUserPointer sq_getforeignptr(HSQUIRRELVM v);
 void sq_setprintfunc(HSQUIRRELVM v, SQPRINTFUNCTION printfunc);
 SQPRINTFUNCTION sq_getprintfunc(HSQUIRRELVM v);
+void sq_setsuspendcheck(HSQUIRRELVM v, SQSUSPENDCHECK check);
 SQRESULT sq_suspendvm(HSQUIRRELVM v);
 bool sq_resumecatch(HSQUIRRELVM v, int suspend = -1);
 bool sq_resumeerror(HSQUIRRELVM v);
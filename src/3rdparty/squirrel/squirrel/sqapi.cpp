@@ -1304,6 +1304,11 @@ void sq_setprintfunc(HSQUIRRELVM v, SQPRINTFUNCTION printfunc)
 	_ss(v)->_printfunc = printfunc;
 }
 
+void sq_setsuspendcheck(HSQUIRRELVM v, SQSUSPENDCHECK check)
+{
+	_ss(v)->_suspendcheck = check;
+}
+
 SQPRINTFUNCTION sq_getprintfunc(HSQUIRRELVM v)
 {
 	return _ss(v)->_printfunc;
@@ -23,7 +23,7 @@
 #define DEREF_NO_DEREF	-1
 #define DEREF_FIELD		-2
 
-SQInteger _last_stacksize;
+thread_local SQInteger _last_stacksize;
 
 struct ExpState
 {
@@ -69,7 +69,7 @@ public:
 	}
 	NORETURN void Error(const SQChar *s, ...) WARN_FORMAT(2, 3)
 	{
-		static SQChar temp[256];
+		static thread_local SQChar temp[256];
 		va_list vl;
 		va_start(vl, s);
 		vseprintf(temp, lastof(temp), s, vl);
@@ -95,6 +95,7 @@ SQSharedState::SQSharedState()
 {
 	_compilererrorhandler = nullptr;
 	_printfunc = nullptr;
+	_suspendcheck = nullptr;
 	_debuginfo = false;
 	_notifyallexceptions = false;
 	_scratchpad=nullptr;
@@ -106,6 +106,7 @@ public:
 
 	SQCOMPILERERROR _compilererrorhandler;
 	SQPRINTFUNCTION _printfunc;
+	SQSUSPENDCHECK _suspendcheck;
 	bool _debuginfo;
 	bool _notifyallexceptions;
 private:
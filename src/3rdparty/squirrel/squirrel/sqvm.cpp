@@ -1186,6 +1186,10 @@ bool SQVM::CallNative(SQNativeClosure *nclosure,SQInteger nargs,SQInteger stackb
 		this->_can_suspend = false;
 		ret = (nclosure->_function)(this);
 		this->_can_suspend = can_suspend;
+
+		/* Native functions can take much longer than their opcode count suggests,
+		 * so give the host the chance to suspend the VM after them. */
+		if (can_suspend && _ss(this)->_suspendcheck != nullptr && _ops_till_suspend > 0 && _ss(this)->_suspendcheck(this)) _ops_till_suspend = 0;
 	} catch (...) {
 		_nnativecalls--;
 		suspend = false;
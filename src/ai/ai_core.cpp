@@ -12,15 +12,20 @@
 #include "../core/bitmath_func.hpp"
 #include "../company_base.h"
 #include "../company_func.h"
+#include "../genworld.h"
 #include "../network/network.h"
 #include "../window_func.h"
 #include "../framerate_type.h"
+#include "../thread.h"
+#include "../script/squirrel.hpp"
 #include "ai_scanner.hpp"
 #include "ai_instance.hpp"
 #include "ai_config.hpp"
 #include "ai_info.hpp"
 #include "ai.hpp"
 
+#include <atomic>
+
 #include "../safeguards.h"
 
 /* static */ uint AI::frame_counter = 0;
@@ -64,6 +69,55 @@
 	return;
 }
 
+/**
+ * Run the game loop of an AI.
+ * @param company The company of the AI.
+ */
+static void RunAI(CompanyID company)
+{
+	PerformanceMeasurer framerate((PerformanceElement)(PFE_AI0 + company));
+	_current_company = company;
+	Company::Get(company)->ai_instance->GameLoop();
+}
+
+/**
+ * Run the game loops of AIs, till there are no AIs left to run.
+ * @param companies The companies of the AIs.
+ * @param next The index of the next AI to run, shared by all threads running AIs.
+ */
+static void RunAIs(const std::vector<CompanyID> *companies, std::atomic<size_t> *next)
+{
+	for (size_t i = (*next)++; i < companies->size(); i = (*next)++) {
+		ScriptGameLock lock;
+		RunAI((*companies)[i]);
+	}
+}
+
+/**
+ * Run the game loops of AIs on multiple threads. Their Squirrel code runs
+ * concurrently, the rest takes turns; see #ScriptGameLock.
+ * @param companies The companies of the AIs.
+ */
+static void RunAIsConcurrently(const std::vector<CompanyID> &companies)
+{
+	std::atomic<size_t> next(0);
+	ScriptGameLock::SetConcurrent(true);
+
+	/* This thread runs AIs as well. */
+	size_t num_threads = std::min<size_t>(companies.size(), std::max(std::thread::hardware_concurrency(), 1U)) - 1;
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < num_threads; i++) {
+		std::thread thread;
+		if (!StartNewThread(&thread, "ottd:ai", &RunAIs, &companies, &next)) break;
+		threads.push_back(std::move(thread));
+	}
+
+	RunAIs(&companies, &next);
+	for (std::thread &thread : threads) thread.join();
+
+	ScriptGameLock::SetConcurrent(false);
+}
+
 /* static */ void AI::GameLoop()
 {
 	/* If we are in networking, only servers run this function, and that only if it is allowed */
@@ -75,15 +129,31 @@
 	if ((AI::frame_counter & ((1 << (4 - _settings_game.difficulty.competitor_speed)) - 1)) != 0) return;
 
 	Backup<CompanyID> cur_company(_current_company, FILE_LINE);
+	std::vector<CompanyID> companies;
 	for (const Company *c : Company::Iterate()) {
 		if (c->is_ai) {
-			PerformanceMeasurer framerate((PerformanceElement)(PFE_AI0 + c->index));
-			cur_company.Change(c->index);
-			c->ai_instance->GameLoop();
+			companies.push_back(c->index);
 		} else {
 			PerformanceMeasurer::SetInactive((PerformanceElement)(PFE_AI0 + c->index));
 		}
 	}
+
+	/* Without network the commands of the AIs are deferred till the end of the
+	 * tick, so the AIs do not change the game and can run concurrently. In
+	 * network games they run one after another, so their commands are queued
+	 * in a deterministic order. */
+	if (!_networking && !_generating_world && companies.size() > 1) {
+		RunAIsConcurrently(companies);
+	} else {
+		for (CompanyID company : companies) RunAI(company);
+	}
+
+	/* Execute the commands the AIs deferred in the order of the companies. */
+	for (const Company *c : Company::Iterate()) {
+		if (!c->is_ai || c->ai_instance == nullptr) continue;
+		cur_company.Change(c->index);
+		c->ai_instance->ApplyDeferredCommands();
+	}
 	cur_company.Restore();
 
 	/* Occasionally collect garbage; every 255 ticks do one company.
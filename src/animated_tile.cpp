@@ -8,16 +8,40 @@
 /** @file animated_tile.cpp Everything related to animated tiles. */
 
 #include "stdafx.h"
-#include "core/alloc_func.hpp"
-#include "core/smallvec_type.hpp"
 #include "tile_cmd.h"
 #include "viewport_func.h"
 #include "framerate_type.h"
 
+#include <unordered_map>
+
 #include "safeguards.h"
 
-/** The table/list with animated tiles. */
+/** The table/list with animated tiles; deleted tiles are replaced by INVALID_TILE until the table is compacted. */
 std::vector<TileIndex> _animated_tiles;
+/** Position of every animated tile in #_animated_tiles. */
+static std::unordered_map<TileIndex, size_t> _animated_tile_positions;
+/** Number of deleted tiles in #_animated_tiles. */
+static size_t _animated_tiles_deleted = 0;
+/** Whether the animated tiles are being animated, so the table may not be compacted. */
+static bool _animating_tiles = false;
+
+/**
+ * Remove the deleted and duplicate tiles from the animated tile table, keeping
+ * the order of the remaining tiles, and determine the position of every tile.
+ */
+void RebuildAnimatedTiles()
+{
+	_animated_tile_positions.clear();
+
+	size_t count = 0;
+	for (TileIndex tile : _animated_tiles) {
+		if (tile == INVALID_TILE || !_animated_tile_positions.emplace(tile, count).second) continue;
+		_animated_tiles[count++] = tile;
+	}
+
+	_animated_tiles.resize(count);
+	_animated_tiles_deleted = 0;
+}
 
 /**
  * Removes the given tile from the animated tile table.
@@ -25,12 +49,17 @@ std::vector<TileIndex> _animated_tiles;
  */
 void DeleteAnimatedTile(TileIndex tile)
 {
-	auto to_remove = std::find(_animated_tiles.begin(), _animated_tiles.end(), tile);
-	if (to_remove != _animated_tiles.end()) {
-		/* The order of the remaining elements must stay the same, otherwise the animation loop may miss a tile. */
-		_animated_tiles.erase(to_remove);
-		MarkTileDirtyByTile(tile);
-	}
+	auto to_remove = _animated_tile_positions.find(tile);
+	if (to_remove == _animated_tile_positions.end()) return;
+
+	/* Keep the slot so the order of the remaining elements stays the same and
+	 * the animation loop does not miss a tile; the slot is reclaimed later. */
+	_animated_tiles[to_remove->second] = INVALID_TILE;
+	_animated_tile_positions.erase(to_remove);
+	_animated_tiles_deleted++;
+	MarkTileDirtyByTile(tile);
+
+	if (!_animating_tiles && _animated_tiles_deleted > _animated_tiles.size() / 2) RebuildAnimatedTiles();
 }
 
 /**
@@ -41,7 +70,7 @@ void DeleteAnimatedTile(TileIndex tile)
 void AddAnimatedTile(TileIndex tile)
 {
 	MarkTileDirtyByTile(tile);
-	include(_animated_tiles, tile);
+	if (_animated_tile_positions.emplace(tile, _animated_tiles.size()).second) _animated_tiles.push_back(tile);
 }
 
 /**
@@ -51,21 +80,16 @@ void AnimateAnimatedTiles()
 {
 	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
 
-	const TileIndex *ti = _animated_tiles.data();
-	while (ti < _animated_tiles.data() + _animated_tiles.size()) {
-		const TileIndex curr = *ti;
-		AnimateTile(curr);
-		/* During the AnimateTile call, DeleteAnimatedTile could have been called,
-		 * deleting an element we've already processed and pushing the rest one
-		 * slot to the left. We can detect this by checking whether the index
-		 * in the current slot has changed - if it has, an element has been deleted,
-		 * and we should process the current slot again instead of going forward.
-		 * NOTE: this will still break if more than one animated tile is being
-		 *       deleted during the same AnimateTile call, but no code seems to
-		 *       be doing this anyway.
-		 */
-		if (*ti == curr) ++ti;
+	/* Tiles deleted during an AnimateTile call are only marked as deleted, and
+	 * tiles added are appended, so indices of the other tiles do not change. */
+	_animating_tiles = true;
+	for (size_t i = 0; i < _animated_tiles.size(); i++) {
+		const TileIndex curr = _animated_tiles[i];
+		if (curr != INVALID_TILE) AnimateTile(curr);
 	}
+	_animating_tiles = false;
+
+	if (_animated_tiles_deleted != 0) RebuildAnimatedTiles();
 }
 
 /**
@@ -74,4 +98,6 @@ void AnimateAnimatedTiles()
 void InitializeAnimatedTiles()
 {
 	_animated_tiles.clear();
+	_animated_tile_positions.clear();
+	_animated_tiles_deleted = 0;
 }
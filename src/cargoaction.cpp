@@ -203,8 +203,9 @@ bool StationCargoReroute::operator()(CargoPacket *cp)
 		this->destination->AddToCache(cp_new);
 	}
 
-	/* Legal, as insert doesn't invalidate iterators in the MultiMap, however
-	 * this might insert the packet between range.first and range.second (which might be end())
+	/* Legal, as next != avoid and inserting only invalidates iterators into the
+	 * range for next in the MultiMap, however this might insert the packet
+	 * between range.first and range.second (which might be end())
 	 * This is why we check for GetKey above to avoid infinite loops. */
 	this->destination->packets.Insert(next, cp_new);
 	return cp_new == cp;
@@ -227,7 +228,8 @@ bool VehicleCargoReroute::operator()(CargoPacket *cp)
 		this->destination->AddToMeta(cp_new, VehicleCargoList::MTA_TRANSFER);
 	}
 
-	/* Legal, as front pushing doesn't invalidate iterators in std::list. */
+	/* Legal, as VehicleCargoList::ShiftCargo doesn't keep iterators across
+	 * actions and accounts for packets pushed to the front of its own list. */
 	this->destination->packets.push_front(cp_new);
 	return cp_new == cp;
 }
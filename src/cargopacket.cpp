@@ -284,11 +284,15 @@ void VehicleCargoList::Append(CargoPacket *cp, MoveToAction action)
 template<class Taction>
 void VehicleCargoList::ShiftCargo(Taction action)
 {
-	Iterator it(this->packets.begin());
-	while (it != this->packets.end() && action.MaxMove() > 0) {
-		CargoPacket *cp = *it;
+	/* Rerouting may push packets to the front of this very list, so track
+	 * the position by index and skip whatever got pushed in front of it. */
+	size_t pos = 0;
+	while (pos < this->packets.size() && action.MaxMove() > 0) {
+		CargoPacket *cp = this->packets[pos];
+		size_t size = this->packets.size();
 		if (action(cp)) {
-			it = this->packets.erase(it);
+			pos += this->packets.size() - size;
+			this->packets.erase(this->packets.begin() + pos);
 		} else {
 			break;
 		}
@@ -306,18 +310,10 @@ void VehicleCargoList::ShiftCargo(Taction action)
 template<class Taction>
 void VehicleCargoList::PopCargo(Taction action)
 {
-	if (this->packets.empty()) return;
-	Iterator it(--(this->packets.end()));
-	Iterator begin(this->packets.begin());
-	while (action.MaxMove() > 0) {
-		CargoPacket *cp = *it;
+	while (!this->packets.empty() && action.MaxMove() > 0) {
+		CargoPacket *cp = this->packets.back();
 		if (action(cp)) {
-			if (it != begin) {
-				this->packets.erase(it--);
-			} else {
-				this->packets.erase(it);
-				break;
-			}
+			this->packets.pop_back();
 		} else {
 			break;
 		}
@@ -448,18 +444,19 @@ bool VehicleCargoList::Stage(bool accepted, StationID current_station, StationID
 	this->AssertCountConsistency();
 	assert(this->action_counts[MTA_LOAD] == 0);
 	this->action_counts[MTA_TRANSFER] = this->action_counts[MTA_DELIVER] = this->action_counts[MTA_KEEP] = 0;
-	Iterator deliver = this->packets.end();
-	Iterator it = this->packets.begin();
+
+	/* Rebuild the list as [transfer (reversed), deliver, keep]. Kept packets
+	 * are collected separately and appended once all others are placed. */
+	CargoPacketList staged;
+	staged.swap(this->packets);
+	CargoPacketList keep;
 	uint sum = 0;
 
 	bool force_keep = (order_flags & OUFB_NO_UNLOAD) != 0;
 	bool force_unload = (order_flags & OUFB_UNLOAD) != 0;
 	bool force_transfer = (order_flags & (OUFB_TRANSFER | OUFB_UNLOAD)) != 0;
-	assert(this->count > 0 || it == this->packets.end());
-	while (sum < this->count) {
-		CargoPacket *cp = *it;
-
-		this->packets.erase(it++);
+	assert(this->count > 0 || staged.empty());
+	for (CargoPacket *cp : staged) {
 		StationID cargo_next = INVALID_STATION;
 		MoveToAction action = MTA_LOAD;
 		if (force_keep) {
@@ -510,11 +507,10 @@ bool VehicleCargoList::Stage(bool accepted, StationID current_station, StationID
 		Money share;
 		switch (action) {
 			case MTA_KEEP:
-				this->packets.push_back(cp);
-				if (deliver == this->packets.end()) --deliver;
+				keep.push_back(cp);
 				break;
 			case MTA_DELIVER:
-				this->packets.insert(deliver, cp);
+				this->packets.push_back(cp);
 				break;
 			case MTA_TRANSFER:
 				this->packets.push_front(cp);
@@ -530,6 +526,8 @@ bool VehicleCargoList::Stage(bool accepted, StationID current_station, StationID
 		this->action_counts[action] += cp->count;
 		sum += cp->count;
 	}
+	assert(sum == this->count);
+	this->packets.insert(this->packets.end(), keep.begin(), keep.end());
 	this->AssertCountConsistency();
 	return this->action_counts[MTA_DELIVER] > 0 || this->action_counts[MTA_TRANSFER] > 0;
 }
@@ -577,14 +575,14 @@ uint VehicleCargoList::Reassign<VehicleCargoList::MTA_DELIVER, VehicleCargoList:
 	max_move = std::min(this->action_counts[MTA_DELIVER], max_move);
 
 	uint sum = 0;
-	for (Iterator it(this->packets.begin()); sum < this->action_counts[MTA_TRANSFER] + max_move;) {
-		CargoPacket *cp = *it++;
+	for (size_t pos = 0; sum < this->action_counts[MTA_TRANSFER] + max_move;) {
+		CargoPacket *cp = this->packets[pos++];
 		sum += cp->Count();
 		if (sum <= this->action_counts[MTA_TRANSFER]) continue;
 		if (sum > this->action_counts[MTA_TRANSFER] + max_move) {
 			CargoPacket *cp_split = cp->Split(sum - this->action_counts[MTA_TRANSFER] + max_move);
 			sum -= cp_split->Count();
-			this->packets.insert(it, cp_split);
+			this->packets.insert(this->packets.begin() + pos, cp_split);
 		}
 		cp->next_station = next_station;
 	}
@@ -39,6 +39,9 @@
 #include "engine_base.h"
 #include "road.h"
 #include "rail.h"
+#include "vehicle_func.h"
+#include "spritecache.h"
+#include "framerate_type.h"
 #include "game/game.hpp"
 #include "table/strings.h"
 #include "walltime_func.h"
@@ -225,6 +228,66 @@ DEF_CONSOLE_CMD(ConResetEnginePool)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConBenchmarkMap)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Measure the time of scans over the whole map and of running the tile loop. Usage: 'benchmark_map [<iterations>]'.");
+		IConsolePrint(CC_HELP, "Every iteration runs the tile loop once over every tile, which changes the game like normal play does.");
+		return true;
+	}
+
+	if (_game_mode == GM_MENU) {
+		IConsolePrint(CC_ERROR, "This command is only available in-game and in the editor.");
+		return true;
+	}
+
+	uint32 iterations = 10;
+	if (argc > 2 || (argc == 2 && (!GetArgumentInteger(&iterations, argv[1]) || iterations == 0))) return false;
+
+#ifdef WITH_MAP_PLANES
+	static const char *layout = "planes";
+#else
+	static const char *layout = "tile structs";
+#endif
+	IConsolePrint(CC_INFO, "Map of {}x{} tiles stored as {}, {} iterations.", MapSizeX(), MapSizeY(), layout, iterations);
+
+	/* The sums make sure the scans are not optimised away. */
+	uint64 sum = 0;
+	TimingMeasurement start = GetPerformanceTimer();
+	for (uint32 i = 0; i < iterations; i++) {
+		for (TileIndex t = 0; t < MapSize(); t++) sum += GetTileType(t);
+	}
+	TimingMeasurement types = GetPerformanceTimer() - start;
+
+	start = GetPerformanceTimer();
+	for (uint32 i = 0; i < iterations; i++) {
+		for (TileIndex t = 0; t < MapSize(); t++) sum += TileHeight(t);
+	}
+	TimingMeasurement heights = GetPerformanceTimer() - start;
+
+	start = GetPerformanceTimer();
+	for (uint32 i = 0; i < iterations; i++) {
+		for (uint y = 0; y < MapMaxY(); y++) {
+			for (uint x = 0; x < MapMaxX(); x++) sum += GetTileSlope(TileXY(x, y));
+		}
+	}
+	TimingMeasurement slopes = GetPerformanceTimer() - start;
+
+	start = GetPerformanceTimer();
+	for (uint32 i = 0; i < iterations; i++) {
+		/* The tile loop visits every tile once in 256 calls. */
+		for (uint j = 0; j < 256; j++) RunTileLoop();
+	}
+	TimingMeasurement tile_loop = GetPerformanceTimer() - start;
+
+	IConsolePrint(CC_INFO, "Tile type scan:   {:.2f}ms per iteration", types / 1000.0 / iterations);
+	IConsolePrint(CC_INFO, "Tile height scan: {:.2f}ms per iteration", heights / 1000.0 / iterations);
+	IConsolePrint(CC_INFO, "Tile slope scan:  {:.2f}ms per iteration", slopes / 1000.0 / iterations);
+	IConsolePrint(CC_INFO, "Tile loop:        {:.2f}ms per iteration", tile_loop / 1000.0 / iterations);
+	IConsolePrint(CC_DEBUG, "Checksum: {}", sum);
+	return true;
+}
+
 #ifdef _DEBUG
 /**
  * Reset a tile to bare land in debug mode.
@@ -327,6 +390,31 @@ DEF_CONSOLE_CMD(ConSave)
 	return false;
 }
 
+DEF_CONSOLE_CMD(ConCheckpoint)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Save a checkpoint of the current game. Usage: 'checkpoint <filename> [full]'.");
+		IConsolePrint(CC_HELP, "Only the parts of the game that changed since the last full checkpoint are saved, unless 'full' is given.");
+		IConsolePrint(CC_HELP, "Loading such a checkpoint also loads the last full checkpoint, so keep that savegame.");
+		return true;
+	}
+
+	if (argc == 2 || (argc == 3 && strcmp(argv[2], "full") == 0)) {
+		char *filename = str_fmt("%s.sav", argv[1]);
+		IConsolePrint(CC_DEFAULT, "Saving checkpoint...");
+
+		if (SaveCheckpoint(filename, SAVE_DIR, argc == 3) != SL_OK) {
+			IConsolePrint(CC_ERROR, "Saving checkpoint failed.");
+		} else {
+			IConsolePrint(CC_INFO, "Checkpoint successfully saved to '{}'.", filename);
+		}
+		free(filename);
+		return true;
+	}
+
+	return false;
+}
+
 /**
  * Explicitly save the configuration.
  * @return True.
@@ -2279,12 +2367,38 @@ static void ConDumpCargoTypes()
 }
 
 
+static void ConDumpVehicleHash()
+{
+	IConsolePrint(CC_DEFAULT, "  Hash layout: buckets, used buckets, vehicles, longest chain, average chain length per lookup");
+	for (bool legacy : { true, false }) {
+		VehicleTileHashStats stats = GetVehicleTileHashStats(legacy);
+		IConsolePrint(CC_DEFAULT, "  {:>7}: {:8} {:8} {:8} {:6} {:10.2f}",
+				legacy ? "128x128" : "map",
+				stats.buckets,
+				stats.used_buckets,
+				stats.vehicles,
+				stats.longest_chain,
+				stats.vehicles == 0 ? 0.0 : (double)stats.lookup_length / stats.vehicles);
+	}
+}
+
+static void ConDumpSpriteCache()
+{
+	SpriteCacheStats stats = GetSpriteCacheStats();
+	uint64 requests = stats.hits + stats.misses;
+	IConsolePrint(CC_DEFAULT, "  Memory:      {} of {} KiB in use", stats.used_bytes / 1024, stats.total_bytes / 1024);
+	IConsolePrint(CC_DEFAULT, "  Sprites:     {} cached", stats.cached_sprites);
+	IConsolePrint(CC_DEFAULT, "  Requests:    {} hits, {} misses ({:.1f}% hit rate)", stats.hits, stats.misses, requests == 0 ? 0.0 : 100.0 * stats.hits / requests);
+	IConsolePrint(CC_DEFAULT, "  Evictions:   {}", stats.evictions);
+	IConsolePrint(CC_DEFAULT, "  Compactions: {}", stats.compactions);
+}
+
 DEF_CONSOLE_CMD(ConDumpInfo)
 {
 	if (argc != 2) {
 		IConsolePrint(CC_HELP, "Dump debugging information.");
-		IConsolePrint(CC_HELP, "Usage: 'dump_info roadtypes|railtypes|cargotypes'.");
-		IConsolePrint(CC_HELP, "  Show information about road/tram types, rail types or cargo types.");
+		IConsolePrint(CC_HELP, "Usage: 'dump_info roadtypes|railtypes|cargotypes|vehiclehash|spritecache'.");
+		IConsolePrint(CC_HELP, "  Show information about road/tram types, rail types, cargo types, the vehicle tile hash or the sprite cache.");
 		return true;
 	}
 
@@ -2303,6 +2417,16 @@ DEF_CONSOLE_CMD(ConDumpInfo)
 		return true;
 	}
 
+	if (strcasecmp(argv[1], "vehiclehash") == 0) {
+		ConDumpVehicleHash();
+		return true;
+	}
+
+	if (strcasecmp(argv[1], "spritecache") == 0) {
+		ConDumpSpriteCache();
+		return true;
+	}
+
 	return false;
 }
 
@@ -2331,6 +2455,7 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("quit",                    ConExit);
 	IConsole::CmdRegister("resetengines",            ConResetEngines,     ConHookNoNetwork);
 	IConsole::CmdRegister("reset_enginepool",        ConResetEnginePool,  ConHookNoNetwork);
+	IConsole::CmdRegister("benchmark_map",           ConBenchmarkMap,     ConHookNoNetwork);
 	IConsole::CmdRegister("return",                  ConReturn);
 	IConsole::CmdRegister("screenshot",              ConScreenShot);
 	IConsole::CmdRegister("script",                  ConScript);
@@ -2339,6 +2464,7 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("load",                    ConLoad);
 	IConsole::CmdRegister("rm",                      ConRemove);
 	IConsole::CmdRegister("save",                    ConSave);
+	IConsole::CmdRegister("checkpoint",              ConCheckpoint);
 	IConsole::CmdRegister("saveconfig",              ConSaveConfig);
 	IConsole::CmdRegister("ls",                      ConListFiles);
 	IConsole::CmdRegister("cd",                      ConChangeDirectory);
@@ -11,7 +11,7 @@
 #define MULTIMAP_HPP
 
 #include <map>
-#include <list>
+#include <deque>
 
 template<typename Tkey, typename Tvalue, typename Tcompare>
 class MultiMap;
@@ -274,16 +274,17 @@ bool operator!=(const Tmap_iter2 &iter2, const MultiMapIterator<Tmap_iter1, Tlis
 
 
 /**
- * Hand-rolled multimap as map of lists. Behaves mostly like a list, but is sorted
+ * Hand-rolled multimap as map of deques. Behaves mostly like a list, but is sorted
  * by Tkey so that you can easily look up ranges of equal keys. Those ranges are
  * internally ordered in a deterministic way (contrary to STL multimap). All
  * STL-compatible members are named in STL style, all others are named in OpenTTD
- * style.
+ * style. The items of a range are stored contiguously in blocks, so inserting
+ * into a range invalidates iterators pointing into that same range.
  */
 template<typename Tkey, typename Tvalue, typename Tcompare = std::less<Tkey> >
-class MultiMap : public std::map<Tkey, std::list<Tvalue>, Tcompare > {
+class MultiMap : public std::map<Tkey, std::deque<Tvalue>, Tcompare > {
 public:
-	typedef typename std::list<Tvalue> List;
+	typedef typename std::deque<Tvalue> List;
 	typedef typename List::iterator ListIterator;
 	typedef typename List::const_iterator ConstListIterator;
 
@@ -9,6 +9,7 @@
 
 #include "framerate_type.h"
 #include <chrono>
+#include <algorithm>
 #include "gfx_func.h"
 #include "window_gui.h"
 #include "window_func.h"
@@ -38,6 +39,13 @@ namespace {
 	/** %Units a second is divided into in performance measurements */
 	const TimingMeasurement TIMESTAMP_PRECISION = 1000000;
 
+	/** Whether every measurement is currently being recorded for a benchmark report */
+	bool _pf_benchmark_active = false;
+	/** Time the benchmark recording was started */
+	TimingMeasurement _pf_benchmark_start;
+	/** Time the benchmark recording was stopped */
+	TimingMeasurement _pf_benchmark_end;
+
 	struct PerformanceData {
 		/** Duration value indicating the value is not valid should be considered a gap in measurements */
 		static const TimingMeasurement INVALID_DURATION = UINT64_MAX;
@@ -60,17 +68,37 @@ namespace {
 		/** Start time for current accumulation cycle */
 		TimingMeasurement acc_timestamp;
 
+		/** Number of parts measured in the current accumulation cycle, see #PerformanceAccumulator::AddParts */
+		uint acc_parts;
+		/** Summed duration of the parts measured in the current accumulation cycle */
+		TimingMeasurement acc_parts_duration;
+		/** Longest duration of a part measured in the current accumulation cycle */
+		TimingMeasurement acc_parts_max;
+		/** Number of parts measured in the previous accumulation cycle */
+		uint parts;
+		/** Summed duration of the parts measured in the previous accumulation cycle */
+		TimingMeasurement parts_duration;
+		/** Longest duration of a part measured in the previous accumulation cycle */
+		TimingMeasurement parts_max;
+
+		/** All durations recorded since the benchmark was started, see #StartFramerateBenchmark */
+		std::vector<TimingMeasurement> benchmark_durations;
+		/** Whether the element has begun an accumulation cycle while benchmarking */
+		bool benchmark_accumulating;
+
 		/**
 		 * Initialize a data element with an expected collection rate
 		 * @param expected_rate
 		 * Expected number of cycles per second of the performance element. Use 1 if unknown or not relevant.
 		 * The rate is used for highlighting slow-running elements in the GUI.
 		 */
-		explicit PerformanceData(double expected_rate) : expected_rate(expected_rate), next_index(0), prev_index(0), num_valid(0) { }
+		explicit PerformanceData(double expected_rate) : expected_rate(expected_rate), next_index(0), prev_index(0), num_valid(0), acc_parts(0), acc_parts_duration(0), acc_parts_max(0), parts(0), parts_duration(0), parts_max(0), benchmark_accumulating(false) { }
 
 		/** Collect a complete measurement, given start and ending times for a processing block */
 		void Add(TimingMeasurement start_time, TimingMeasurement end_time)
 		{
+			if (_pf_benchmark_active) this->benchmark_durations.push_back(end_time - start_time);
+
 			this->durations[this->next_index] = end_time - start_time;
 			this->timestamps[this->next_index] = start_time;
 			this->prev_index = this->next_index;
@@ -82,6 +110,12 @@ namespace {
 		/** Begin an accumulation of multiple measurements into a single value, from a given start time */
 		void BeginAccumulate(TimingMeasurement start_time)
 		{
+			if (_pf_benchmark_active) {
+				/* The first cycle finished here started before the benchmark did, so do not record it. */
+				if (this->benchmark_accumulating) this->benchmark_durations.push_back(this->acc_duration);
+				this->benchmark_accumulating = true;
+			}
+
 			this->timestamps[this->next_index] = this->acc_timestamp;
 			this->durations[this->next_index] = this->acc_duration;
 			this->prev_index = this->next_index;
@@ -91,6 +125,13 @@ namespace {
 
 			this->acc_duration = 0;
 			this->acc_timestamp = start_time;
+
+			this->parts = this->acc_parts;
+			this->parts_duration = this->acc_parts_duration;
+			this->parts_max = this->acc_parts_max;
+			this->acc_parts = 0;
+			this->acc_parts_duration = 0;
+			this->acc_parts_max = 0;
 		}
 
 		/** Accumulate a period onto the current measurement */
@@ -99,6 +140,14 @@ namespace {
 			this->acc_duration += duration;
 		}
 
+		/** Record the duration of a part of the current measurement, which may have run in parallel to other parts */
+		void AddPart(TimingMeasurement duration)
+		{
+			this->acc_parts++;
+			this->acc_parts_duration += duration;
+			this->acc_parts_max = std::max(this->acc_parts_max, duration);
+		}
+
 		/** Indicate a pause/expected discontinuity in processing the element */
 		void AddPause(TimingMeasurement start_time)
 		{
@@ -220,7 +269,7 @@ namespace {
  * The basis of the timestamp is implementation defined, but the value should be steady,
  * so differences can be taken to reliably measure intervals.
  */
-static TimingMeasurement GetPerformanceTimer()
+TimingMeasurement GetPerformanceTimer()
 {
 	using namespace std::chrono;
 	return (TimingMeasurement)time_point_cast<microseconds>(high_resolution_clock::now()).time_since_epoch().count();
@@ -307,6 +356,19 @@ void PerformanceAccumulator::Reset(PerformanceElement elem)
 	_pf_data[elem].BeginAccumulate(GetPerformanceTimer());
 }
 
+/**
+ * Record the durations of parts of the accumulating value that were processed
+ * in parallel, e.g. the screen tiles of a viewport.
+ * @note Must only be called from the thread that also accumulates the value.
+ * @param elem The element the parts belong to.
+ * @param durations Durations of the parts.
+ * @param count Number of parts.
+ */
+void PerformanceAccumulator::AddParts(PerformanceElement elem, const TimingMeasurement *durations, size_t count)
+{
+	for (size_t i = 0; i < count; i++) _pf_data[elem].AddPart(durations[i]);
+}
+
 
 void ShowFrametimeGraphWindow(PerformanceElement elem);
 
@@ -1073,9 +1135,120 @@ void ConPrintFramerate()
 			pf.GetAverageDurationMilliseconds(count2),
 			pf.GetAverageDurationMilliseconds(count3));
 		printed_anything = true;
+		if (pf.parts > 0) {
+			IConsolePrint(TC_LIGHT_BLUE, "  {} parts in last cycle: {:.2f}ms average, {:.2f}ms longest",
+				pf.parts,
+				(double)pf.parts_duration * 1000 / TIMESTAMP_PRECISION / pf.parts,
+				(double)pf.parts_max * 1000 / TIMESTAMP_PRECISION);
+		}
 	}
 
 	if (!printed_anything) {
 		IConsolePrint(CC_ERROR, "No performance measurements have been taken yet.");
 	}
 }
+
+/**
+ * Start recording every measurement of every performance element, so a report
+ * covering the whole period can be written with #WriteFramerateBenchmarkReport.
+ * Any previously recorded benchmark data is discarded.
+ */
+void StartFramerateBenchmark()
+{
+	for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
+		_pf_data[e].benchmark_durations.clear();
+		_pf_data[e].benchmark_accumulating = false;
+	}
+	_pf_benchmark_start = GetPerformanceTimer();
+	_pf_benchmark_active = true;
+}
+
+/** Stop recording measurements for the benchmark started with #StartFramerateBenchmark. */
+void StopFramerateBenchmark()
+{
+	if (!_pf_benchmark_active) return;
+
+	/* Accumulating elements only store their value when the next cycle begins, so collect the pending ones. */
+	for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
+		auto &pf = _pf_data[e];
+		if (pf.benchmark_accumulating) pf.benchmark_durations.push_back(pf.acc_duration);
+		pf.benchmark_accumulating = false;
+	}
+	_pf_benchmark_end = GetPerformanceTimer();
+	_pf_benchmark_active = false;
+}
+
+/**
+ * Write a machine-readable report of the measurements taken during the last benchmark.
+ * The format is CSV when the filename ends in ".csv", otherwise JSON.
+ * Only elements with at least one measurement are included.
+ * @param filename The file to write the report to.
+ * @return True iff the report was written.
+ */
+bool WriteFramerateBenchmarkReport(const char *filename)
+{
+	/** Identifiers of the elements in the report, in #PerformanceElement order; AI elements are named separately. */
+	static const char *REPORT_NAMES[PFE_AI0] = {
+		"gameloop",
+		"gl_economy",
+		"gl_trains",
+		"gl_roadvehs",
+		"gl_ships",
+		"gl_aircraft",
+		"gl_landscape",
+		"gl_linkgraph",
+		"drawing",
+		"drawworld",
+		"video",
+		"sound",
+		"allscripts",
+		"gamescript",
+	};
+
+	StopFramerateBenchmark();
+
+	FILE *f = fopen(filename, "w");
+	if (f == nullptr) return false;
+
+	const char *ext = strrchr(filename, '.');
+	bool csv = ext != nullptr && strcasecmp(ext, ".csv") == 0;
+
+	/* Milliseconds per timing unit. */
+	const double to_ms = 1000.0 / TIMESTAMP_PRECISION;
+
+	if (csv) {
+		fmt::print(f, "element,samples,total_ms,mean_ms,p50_ms,p90_ms,p99_ms,max_ms\n");
+	} else {
+		fmt::print(f, "{{\n\t\"wall_time_ms\": {:.3f},\n\t\"ticks\": {},\n\t\"elements\": [", (_pf_benchmark_end - _pf_benchmark_start) * to_ms, _pf_data[PFE_GAMELOOP].benchmark_durations.size());
+	}
+
+	bool first = true;
+	for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
+		std::vector<TimingMeasurement> durations = _pf_data[e].benchmark_durations;
+		if (durations.empty()) continue;
+		std::sort(durations.begin(), durations.end());
+
+		TimingMeasurement total = 0;
+		for (TimingMeasurement d : durations) total += d;
+
+		/* Nearest-rank percentile of the sorted durations. */
+		auto percentile = [&durations](uint p) -> TimingMeasurement {
+			size_t rank = (durations.size() * p + 99) / 100;
+			return durations[std::max<size_t>(rank, 1) - 1];
+		};
+
+		std::string name = e < PFE_AI0 ? REPORT_NAMES[e] : fmt::format("ai{}", e - PFE_AI0 + 1);
+		const char *format = csv ? "{},{},{:.3f},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f}\n" :
+				"{{\"name\": \"{}\", \"samples\": {}, \"total_ms\": {:.3f}, \"mean_ms\": {:.4f}, \"p50_ms\": {:.4f}, \"p90_ms\": {:.4f}, \"p99_ms\": {:.4f}, \"max_ms\": {:.4f}}}";
+
+		if (!csv) fmt::print(f, "{}\n\t\t", first ? "" : ",");
+		fmt::print(f, format, name, durations.size(), total * to_ms, (double)total / durations.size() * to_ms,
+				percentile(50) * to_ms, percentile(90) * to_ms, percentile(99) * to_ms, durations.back() * to_ms);
+		first = false;
+	}
+
+	if (!csv) fmt::print(f, "\n\t]\n}}\n");
+
+	fclose(f);
+	return true;
+}
@@ -118,8 +118,15 @@ public:
 	PerformanceAccumulator(PerformanceElement elem);
 	~PerformanceAccumulator();
 	static void Reset(PerformanceElement elem);
+	static void AddParts(PerformanceElement elem, const TimingMeasurement *durations, size_t count);
 };
 
+TimingMeasurement GetPerformanceTimer();
+
 void ShowFramerateWindow();
 
+void StartFramerateBenchmark();
+void StopFramerateBenchmark();
+bool WriteFramerateBenchmarkReport(const char *filename);
+
 #endif /* FRAMERATE_TYPE_H */
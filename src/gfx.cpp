@@ -20,6 +20,7 @@
 #include "window_func.h"
 #include "newgrf_debug.h"
 #include "thread.h"
+#include "smallmap_gui.h"
 
 #include "table/palettes.h"
 #include "table/string_colours.h"
@@ -449,21 +450,32 @@ void DrawBox(int x, int y, int dx1, int dy1, int dx2, int dy2, int dx3, int dy3)
 }
 
 /**
- * Set the colour remap to be for the given colour.
- * @param colour the new colour of the remap.
+ * Fill a colour remap for the given colour.
+ * @param colour the colour of the remap.
+ * @param[out] remap the remap to fill.
  */
-static void SetColourRemap(TextColour colour)
+static void FillColourRemap(TextColour colour, byte remap[3])
 {
-	if (colour == TC_INVALID) return;
-
 	/* Black strings have no shading ever; the shading is black, so it
 	 * would be invisible at best, but it actually makes it illegible. */
 	bool no_shade   = (colour & TC_NO_SHADE) != 0 || colour == TC_BLACK;
 	bool raw_colour = (colour & TC_IS_PALETTE_COLOUR) != 0;
 	colour &= ~(TC_NO_SHADE | TC_IS_PALETTE_COLOUR | TC_FORCED);
 
-	_string_colourremap[1] = raw_colour ? (byte)colour : _string_colourmap[colour];
-	_string_colourremap[2] = no_shade ? 0 : 1;
+	remap[0] = 0;
+	remap[1] = raw_colour ? (byte)colour : _string_colourmap[colour];
+	remap[2] = no_shade ? 0 : 1;
+}
+
+/**
+ * Set the colour remap to be for the given colour.
+ * @param colour the new colour of the remap.
+ */
+static void SetColourRemap(TextColour colour)
+{
+	if (colour == TC_INVALID) return;
+
+	FillColourRemap(colour, _string_colourremap);
 	_colour_remap_ptr = _string_colourremap;
 }
 
@@ -1029,6 +1041,40 @@ void DrawSpriteViewport(SpriteID img, PaletteID pal, int x, int y, const SubSpri
 	}
 }
 
+/**
+ * Look up everything needed to draw a sprite in a viewport. The sprite can
+ * then be drawn with #DrawPreparedSpriteViewport without using the sprite
+ * cache or any other global state, as long as the sprite cache is not changed
+ * in the meantime.
+ * @param img Image number to draw
+ * @param pal Palette to use.
+ * @param[out] ps The prepared sprite.
+ * @return False if the sprite cannot be prepared and has to be drawn with #DrawSpriteViewport.
+ */
+bool PrepareSpriteViewport(SpriteID img, PaletteID pal, PreparedViewportSprite &ps)
+{
+	SpriteID real_sprite = GB(img, 0, SPRITE_WIDTH);
+	ps.remap = nullptr;
+	if (HasBit(img, PALETTE_MODIFIER_TRANSPARENT)) {
+		ps.remap = GetNonSprite(GB(pal, 0, PALETTE_WIDTH), ST_RECOLOUR) + 1;
+		ps.mode = BM_TRANSPARENT;
+	} else if (pal != PAL_NONE) {
+		if (HasBit(pal, PALETTE_TEXT_RECOLOUR)) {
+			/* An invalid colour keeps whatever remap was set before. */
+			if ((TextColour)GB(pal, 0, PALETTE_WIDTH) == TC_INVALID) return false;
+			FillColourRemap((TextColour)GB(pal, 0, PALETTE_WIDTH), ps.text_remap);
+		} else {
+			ps.remap = GetNonSprite(GB(pal, 0, PALETTE_WIDTH), ST_RECOLOUR) + 1;
+		}
+		ps.mode = GetBlitterMode(pal);
+	} else {
+		ps.mode = BM_NORMAL;
+	}
+	ps.sprite = GetSprite(real_sprite, ST_NORMAL);
+	ps.sprite_id = real_sprite;
+	return true;
+}
+
 /**
  * Draw a sprite, not in a viewport
  * @param img  Image number to draw
@@ -1058,6 +1104,8 @@ void DrawSprite(SpriteID img, PaletteID pal, int x, int y, const SubSprite *sub,
 
 /**
  * The code for setting up the blitter mode and sprite information before finally drawing the sprite.
+ * @param dpi    The area to draw to.
+ * @param remap  The colour remap to use.
  * @param sprite The sprite to draw.
  * @param x      The X location to draw.
  * @param y      The Y location to draw.
@@ -1068,9 +1116,8 @@ void DrawSprite(SpriteID img, PaletteID pal, int x, int y, const SubSprite *sub,
  * @tparam SCALED_XY Whether the X and Y are scaled or unscaled.
  */
 template <int ZOOM_BASE, bool SCALED_XY>
-static void GfxBlitter(const Sprite * const sprite, int x, int y, BlitterMode mode, const SubSprite * const sub, SpriteID sprite_id, ZoomLevel zoom)
+static void GfxBlitter(const DrawPixelInfo *dpi, const byte *remap, const Sprite * const sprite, int x, int y, BlitterMode mode, const SubSprite * const sub, SpriteID sprite_id, ZoomLevel zoom)
 {
-	const DrawPixelInfo *dpi = _cur_dpi;
 	Blitter::BlitterParams bp;
 
 	if (SCALED_XY) {
@@ -1117,7 +1164,7 @@ static void GfxBlitter(const Sprite * const sprite, int x, int y, BlitterMode mo
 
 	bp.dst = dpi->dst_ptr;
 	bp.pitch = dpi->pitch;
-	bp.remap = _colour_remap_ptr;
+	bp.remap = remap;
 
 	assert(sprite->width > 0);
 	assert(sprite->height > 0);
@@ -1187,12 +1234,25 @@ static void GfxBlitter(const Sprite * const sprite, int x, int y, BlitterMode mo
 
 static void GfxMainBlitterViewport(const Sprite *sprite, int x, int y, BlitterMode mode, const SubSprite *sub, SpriteID sprite_id)
 {
-	GfxBlitter<ZOOM_LVL_BASE, false>(sprite, x, y, mode, sub, sprite_id, _cur_dpi->zoom);
+	GfxBlitter<ZOOM_LVL_BASE, false>(_cur_dpi, _colour_remap_ptr, sprite, x, y, mode, sub, sprite_id, _cur_dpi->zoom);
 }
 
 static void GfxMainBlitter(const Sprite *sprite, int x, int y, BlitterMode mode, const SubSprite *sub, SpriteID sprite_id, ZoomLevel zoom)
 {
-	GfxBlitter<1, true>(sprite, x, y, mode, sub, sprite_id, zoom);
+	GfxBlitter<1, true>(_cur_dpi, _colour_remap_ptr, sprite, x, y, mode, sub, sprite_id, zoom);
+}
+
+/**
+ * Draw a sprite prepared by #PrepareSpriteViewport in a viewport.
+ * @param dpi  Area of the viewport to draw to.
+ * @param ps   The prepared sprite.
+ * @param x    Left coordinate of image in viewport, scaled by zoom
+ * @param y    Top coordinate of image in viewport, scaled by zoom
+ * @param sub  If available, draw only specified part of the sprite
+ */
+void DrawPreparedSpriteViewport(const DrawPixelInfo *dpi, const PreparedViewportSprite &ps, int x, int y, const SubSprite *sub)
+{
+	GfxBlitter<ZOOM_LVL_BASE, false>(dpi, ps.remap != nullptr ? ps.remap : ps.text_remap, ps.sprite, x, y, (BlitterMode)ps.mode, sub, ps.sprite_id, dpi->zoom);
 }
 
 void DoPaletteAnimations();
@@ -1689,6 +1749,7 @@ void AddDirtyBlock(int left, int top, int right, int bottom)
 void MarkWholeScreenDirty()
 {
 	AddDirtyBlock(0, 0, _screen.width, _screen.height);
+	InvalidateSmallMapColours();
 }
 
 /**
@@ -223,6 +223,20 @@ struct SubSprite {
 	int left, top, right, bottom;
 };
 
+struct Sprite;
+
+/**
+ * Sprite of a viewport with the sprite cache lookups done in advance, so
+ * it can be drawn by any thread. See #PrepareSpriteViewport.
+ */
+struct PreparedViewportSprite {
+	const Sprite *sprite; ///< Sprite data in the sprite cache.
+	const byte *remap;    ///< Recolour sprite to use, or \c nullptr for #text_remap.
+	SpriteID sprite_id;   ///< Sprite number of the sprite.
+	byte mode;            ///< #BlitterMode to draw the sprite with.
+	byte text_remap[3];   ///< Colour remap for sprites recoloured to a text colour.
+};
+
 enum Colours {
 	COLOUR_BEGIN,
 	COLOUR_DARK_BLUE = COLOUR_BEGIN,
@@ -64,6 +64,94 @@ IndustrySpec _industry_specs[NUM_INDUSTRYTYPES];
 IndustryTileSpec _industry_tile_specs[NUM_INDUSTRYTILES];
 IndustryBuildData _industry_builder; ///< In-game manager of industries.
 
+static_assert(65536 % INDUSTRY_PRODUCE_TICKS == 0 && INDUSTRY_PRODUCE_TICKS % 64 == 0);
+
+/** Number of times the industry tick handler has run; not saved as only differences matter. */
+static uint16 _industry_ticks;
+/** The industry tick at which Industry::counter of all industries was last brought up to date. */
+static uint16 _industry_counter_tick;
+/** The industries with a lower index have been handled by the currently running industry tick. */
+static IndustryID _industry_tick_cursor = INVALID_INDUSTRY;
+/**
+ * Industries by the industry tick, modulo #INDUSTRY_PRODUCE_TICKS, at which
+ * their counter becomes a multiple of #INDUSTRY_PRODUCE_TICKS. Every tick only
+ * the industries of a few of these buckets need to be handled.
+ */
+static std::vector<IndustryID> _industry_tick_buckets[INDUSTRY_PRODUCE_TICKS];
+
+/**
+ * Get the number of industry ticks an industry has been handled for so far.
+ * This differs for industries before and after the one being handled right now.
+ * @param i The industry to get it for.
+ * @return The number of handled industry ticks.
+ */
+static inline uint16 GetIndustryTicksDone(const Industry *i)
+{
+	return i->index < _industry_tick_cursor ? _industry_ticks : _industry_ticks - 1;
+}
+
+/**
+ * Get the current value of the counter. The counter is not decreased every
+ * tick; instead the value stored in #counter is the value at the tick
+ * #_industry_counter_tick.
+ * @return The value the counter would have when decreasing it every tick.
+ */
+uint16 Industry::GetCounter() const
+{
+	return this->counter - (uint16)(GetIndustryTicksDone(this) - _industry_counter_tick);
+}
+
+/**
+ * Get the bucket of the tick schedule an industry is in.
+ * @param i The industry to get it for.
+ * @return Index in #_industry_tick_buckets.
+ */
+static inline uint GetIndustryTickBucket(const Industry *i)
+{
+	return (uint16)(i->counter + _industry_counter_tick) % INDUSTRY_PRODUCE_TICKS;
+}
+
+/**
+ * Add an industry to the tick schedule.
+ * @param i The industry to add.
+ */
+static void AddIndustryToTickSchedule(const Industry *i)
+{
+	_industry_tick_buckets[GetIndustryTickBucket(i)].push_back(i->index);
+}
+
+/**
+ * Remove an industry from the tick schedule, if it is in there.
+ * @param i The industry to remove.
+ */
+static void RemoveIndustryFromTickSchedule(const Industry *i)
+{
+	std::vector<IndustryID> &bucket = _industry_tick_buckets[GetIndustryTickBucket(i)];
+	auto it = std::find(bucket.begin(), bucket.end(), i->index);
+	if (it == bucket.end()) return;
+
+	/* The order within a bucket does not matter. */
+	*it = bucket.back();
+	bucket.pop_back();
+}
+
+/** Store the current counter of all industries in Industry::counter, e.g. for saving. */
+void UpdateIndustryCounters()
+{
+	for (Industry *i : Industry::Iterate()) i->counter = i->GetCounter();
+	_industry_counter_tick = _industry_ticks;
+}
+
+/** Rebuild the tick schedule from the counters of all industries, e.g. after loading. */
+void RebuildIndustryTickSchedule()
+{
+	for (std::vector<IndustryID> &bucket : _industry_tick_buckets) bucket.clear();
+	_industry_counter_tick = _industry_ticks;
+	_industry_tick_cursor = INVALID_INDUSTRY;
+
+	for (const Industry *i : Industry::Iterate()) AddIndustryToTickSchedule(i);
+}
+
 /**
  * This function initialize the spec arrays of both
  * industry and industry tiles.
@@ -142,6 +230,8 @@ Industry::~Industry()
 {
 	if (CleaningPool()) return;
 
+	RemoveIndustryFromTickSchedule(this);
+
 	/* Industry can also be destroyed when not fully initialized.
 	 * This means that we do not have to clear tiles either.
 	 * Also we must not decrement industry counts in that case. */
@@ -1132,7 +1222,7 @@ static void ProduceIndustryGoods(Industry *i)
 	const IndustrySpec *indsp = GetIndustrySpec(i->type);
 
 	/* play a sound? */
-	if ((i->counter & 0x3F) == 0) {
+	if ((i->GetCounter() & 0x3F) == 0) {
 		uint32 r;
 		if (Chance16R(1, 14, r) && indsp->number_of_sounds != 0 && _settings_client.sound.ambient) {
 			for (size_t j = 0; j < lengthof(i->last_month_production); j++) {
@@ -1147,10 +1237,11 @@ static void ProduceIndustryGoods(Industry *i)
 		}
 	}
 
-	i->counter--;
+	/* This decreases the counter. */
+	_industry_tick_cursor = i->index + 1;
 
 	/* produce some cargo */
-	if ((i->counter % INDUSTRY_PRODUCE_TICKS) == 0) {
+	if ((i->GetCounter() % INDUSTRY_PRODUCE_TICKS) == 0) {
 		if (HasBit(indsp->callback_mask, CBM_IND_PRODUCTION_256_TICKS)) IndustryProductionCallback(i, 1);
 
 		IndustryBehaviour indbehav = indsp->behaviour;
@@ -1183,7 +1274,7 @@ static void ProduceIndustryGoods(Industry *i)
 			if (cb_res != CALLBACK_FAILED) {
 				cut = ConvertBooleanCallback(indsp->grf_prop.grffile, CBID_INDUSTRY_SPECIAL_EFFECT, cb_res);
 			} else {
-				cut = ((i->counter % INDUSTRY_CUT_TREE_TICKS) == 0);
+				cut = ((i->GetCounter() % INDUSTRY_CUT_TREE_TICKS) == 0);
 			}
 
 			if (cut) ChopLumberMillTrees(i);
@@ -1209,9 +1300,30 @@ void OnTick_Industry()
 
 	if (_game_mode == GM_EDITOR) return;
 
-	for (Industry *i : Industry::Iterate()) {
-		ProduceIndustryGoods(i);
+	/* The counters of all industries are decreased implicitly by advancing
+	 * the tick; only industries that might play a sound or produce cargo
+	 * are handled, in the order of their index. */
+	_industry_ticks++;
+
+	static std::vector<IndustryID> due;
+	due.clear();
+
+	/* Sounds depend on the counter before it is decreased... */
+	for (uint j = 0; j < INDUSTRY_PRODUCE_TICKS; j += 64) {
+		const std::vector<IndustryID> &bucket = _industry_tick_buckets[(uint16)(_industry_ticks - 1 + j) % INDUSTRY_PRODUCE_TICKS];
+		due.insert(due.end(), bucket.begin(), bucket.end());
 	}
+	/* ... production on the counter after it is decreased. */
+	const std::vector<IndustryID> &bucket = _industry_tick_buckets[_industry_ticks % INDUSTRY_PRODUCE_TICKS];
+	due.insert(due.end(), bucket.begin(), bucket.end());
+
+	std::sort(due.begin(), due.end());
+	for (IndustryID index : due) {
+		_industry_tick_cursor = index;
+		ProduceIndustryGoods(Industry::Get(index));
+	}
+
+	_industry_tick_cursor = INVALID_INDUSTRY;
 }
 
 /**
@@ -1754,7 +1866,8 @@ static void DoCreateNewIndustry(Industry *i, TileIndex tile, IndustryType type,
 
 	uint16 r = Random();
 	i->random_colour = GB(r, 0, 4);
-	i->counter = GB(r, 4, 12);
+	i->counter = GB(r, 4, 12) + (uint16)(GetIndustryTicksDone(i) - _industry_counter_tick);
+	AddIndustryToTickSchedule(i);
 	i->random = initial_random_bits;
 	i->was_cargo_delivered = false;
 	i->last_prod_year = _cur_year;
@@ -2948,6 +3061,7 @@ void IndustryMonthlyLoop()
 void InitializeIndustries()
 {
 	Industry::ResetIndustryCounts();
+	RebuildIndustryTickSchedule();
 	_industry_sound_tile = 0;
 
 	_industry_builder.Reset();
@@ -11,6 +11,7 @@
 #define LINKGRAPHSCHEDULE_H
 
 #include "linkgraph.h"
+#include <list>
 
 class LinkGraphJob;
 
@@ -2,6 +2,7 @@
 
 #include "../stdafx.h"
 #include "../core/math_func.hpp"
+#include "../thread.h"
 #include "mcf.h"
 #include <set>
 
@@ -9,6 +10,24 @@
 
 typedef std::map<NodeID, Path *> PathViaMap;
 
+/**
+ * Number of sources whose paths are searched in one batch. All paths of a
+ * batch are searched on the same state of the flows, which allows searching
+ * them in parallel. Afterwards the demand of the sources is assigned in order
+ * of their node IDs. This must not depend on the number of threads, so that
+ * all clients calculate the same flows.
+ */
+static const uint MCF_BATCH_SIZE = 64;
+
+/**
+ * Minimum size of a link graph component for searching paths in batches.
+ * Smaller components are calculated one source at a time.
+ */
+static const uint MCF_BATCH_MIN_NODES = 256;
+
+/** Maximum number of threads searching paths for a single link graph job. */
+static const uint MCF_MAX_THREADS = 8;
+
 /**
  * Distance-based annotation for use in the Dijkstra algorithm. This is close
  * to the original meaning of "annotation" in this context. Paths are rated
@@ -297,6 +316,67 @@ void MultiCommodityFlow::Dijkstra(NodeID source_node, PathVector &paths)
 	}
 }
 
+/**
+ * Run the Dijkstra algorithm for each source of a batch. The searches don't
+ * modify the link graph job and only depend on the state of the flows before
+ * the batch, so they are spread over multiple threads if available.
+ * @tparam Tannotation Annotation to be used.
+ * @tparam Tedge_iterator Iterator to be used for getting outgoing edges.
+ * @param sources Nodes where the algorithm starts.
+ * @param paths Container for the paths to be calculated, one per source.
+ */
+template<class Tannotation, class Tedge_iterator>
+void MultiCommodityFlow::Dijkstra(const std::vector<NodeID> &sources, std::vector<PathVector> &paths)
+{
+	paths.resize(sources.size());
+	std::atomic<size_t> next(0);
+	uint num_threads = std::min<uint>({std::thread::hardware_concurrency(), MCF_MAX_THREADS, (uint)sources.size()});
+	std::vector<std::thread> threads;
+	for (uint i = 1; i < num_threads; ++i) {
+		std::thread thread;
+		if (!StartNewThread(&thread, "ottd:mcf", &MultiCommodityFlow::DijkstraWorker<Tannotation, Tedge_iterator>, this, &sources, &paths, &next)) break;
+		threads.push_back(std::move(thread));
+	}
+	/* Also do some work ourselves; if no threads could be started this does the whole batch. */
+	MultiCommodityFlow::DijkstraWorker<Tannotation, Tedge_iterator>(this, &sources, &paths, &next);
+	for (std::thread &thread : threads) thread.join();
+}
+
+/**
+ * Search paths for sources of a batch until none are left.
+ * @tparam Tannotation Annotation to be used.
+ * @tparam Tedge_iterator Iterator to be used for getting outgoing edges.
+ * @param mcf Flow calculation the batch belongs to.
+ * @param sources Nodes where the algorithm starts.
+ * @param paths Container for the paths to be calculated, one per source.
+ * @param next Index of the next source to be searched.
+ */
+template<class Tannotation, class Tedge_iterator>
+/* static */ void MultiCommodityFlow::DijkstraWorker(MultiCommodityFlow *mcf, const std::vector<NodeID> *sources, std::vector<PathVector> *paths, std::atomic<size_t> *next)
+{
+	for (size_t i = (*next)++; i < sources->size(); i = (*next)++) {
+		mcf->Dijkstra<Tannotation, Tedge_iterator>((*sources)[i], (*paths)[i]);
+	}
+}
+
+/**
+ * Collect the next batch of sources that still have demand left.
+ * @param finished_sources Sources whose demand has been assigned already.
+ * @param first First node to be considered.
+ * @param sources Container for the sources of the batch.
+ * @return First node to be considered for the next batch.
+ */
+NodeID MultiCommodityFlow::NextSources(const std::vector<bool> &finished_sources, NodeID first, std::vector<NodeID> &sources) const
+{
+	uint16 size = this->job.Size();
+	uint batch_size = size < MCF_BATCH_MIN_NODES ? 1 : MCF_BATCH_SIZE;
+	sources.clear();
+	for (; first < size && sources.size() < batch_size; ++first) {
+		if (!finished_sources[first]) sources.push_back(first);
+	}
+	return first;
+}
+
 /**
  * Clean up paths that lead nowhere and the root path.
  * @param source_id ID of the root node.
@@ -490,7 +570,8 @@ bool MCF1stPass::EliminateCycles()
  */
 MCF1stPass::MCF1stPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 {
-	PathVector paths;
+	std::vector<PathVector> batch_paths;
+	std::vector<NodeID> sources;
 	uint16 size = job.Size();
 	uint accuracy = job.Settings().accuracy;
 	bool more_loops;
@@ -498,35 +579,39 @@ MCF1stPass::MCF1stPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 
 	do {
 		more_loops = false;
-		for (NodeID source = 0; source < size; ++source) {
-			if (finished_sources[source]) continue;
+		for (NodeID first = 0; first < size;) {
+			first = this->NextSources(finished_sources, first, sources);
 
 			/* First saturate the shortest paths. */
-			this->Dijkstra<DistanceAnnotation, GraphEdgeIterator>(source, paths);
-
-			bool source_demand_left = false;
-			for (NodeID dest = 0; dest < size; ++dest) {
-				Edge edge = job[source][dest];
-				if (edge.UnsatisfiedDemand() > 0) {
-					Path *path = paths[dest];
-					assert(path != nullptr);
-					/* Generally only allow paths that don't exceed the
-					 * available capacity. But if no demand has been assigned
-					 * yet, make an exception and allow any valid path *once*. */
-					if (path->GetFreeCapacity() > 0 && this->PushFlow(edge, path,
-							accuracy, this->max_saturation) > 0) {
-						/* If a path has been found there is a chance we can
-						 * find more. */
-						more_loops = more_loops || (edge.UnsatisfiedDemand() > 0);
-					} else if (edge.UnsatisfiedDemand() == edge.Demand() &&
-							path->GetFreeCapacity() > INT_MIN) {
-						this->PushFlow(edge, path, accuracy, UINT_MAX);
+			this->Dijkstra<DistanceAnnotation, GraphEdgeIterator>(sources, batch_paths);
+
+			for (size_t i = 0; i < sources.size(); ++i) {
+				NodeID source = sources[i];
+				PathVector &paths = batch_paths[i];
+				bool source_demand_left = false;
+				for (NodeID dest = 0; dest < size; ++dest) {
+					Edge edge = job[source][dest];
+					if (edge.UnsatisfiedDemand() > 0) {
+						Path *path = paths[dest];
+						assert(path != nullptr);
+						/* Generally only allow paths that don't exceed the
+						 * available capacity. But if no demand has been assigned
+						 * yet, make an exception and allow any valid path *once*. */
+						if (path->GetFreeCapacity() > 0 && this->PushFlow(edge, path,
+								accuracy, this->max_saturation) > 0) {
+							/* If a path has been found there is a chance we can
+							 * find more. */
+							more_loops = more_loops || (edge.UnsatisfiedDemand() > 0);
+						} else if (edge.UnsatisfiedDemand() == edge.Demand() &&
+								path->GetFreeCapacity() > INT_MIN) {
+							this->PushFlow(edge, path, accuracy, UINT_MAX);
+						}
+						if (edge.UnsatisfiedDemand() > 0) source_demand_left = true;
 					}
-					if (edge.UnsatisfiedDemand() > 0) source_demand_left = true;
 				}
+				finished_sources[source] = !source_demand_left;
+				this->CleanupPaths(source, paths);
 			}
-			finished_sources[source] = !source_demand_left;
-			this->CleanupPaths(source, paths);
 		}
 	} while ((more_loops || this->EliminateCycles()) && !job.IsJobAborted());
 }
@@ -539,32 +624,37 @@ MCF1stPass::MCF1stPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 MCF2ndPass::MCF2ndPass(LinkGraphJob &job) : MultiCommodityFlow(job)
 {
 	this->max_saturation = UINT_MAX; // disable artificial cap on saturation
-	PathVector paths;
+	std::vector<PathVector> batch_paths;
+	std::vector<NodeID> sources;
 	uint16 size = job.Size();
 	uint accuracy = job.Settings().accuracy;
 	bool demand_left = true;
 	std::vector<bool> finished_sources(size);
 	while (demand_left && !job.IsJobAborted()) {
 		demand_left = false;
-		for (NodeID source = 0; source < size; ++source) {
-			if (finished_sources[source]) continue;
+		for (NodeID first = 0; first < size;) {
+			first = this->NextSources(finished_sources, first, sources);
 
-			this->Dijkstra<CapacityAnnotation, FlowEdgeIterator>(source, paths);
+			this->Dijkstra<CapacityAnnotation, FlowEdgeIterator>(sources, batch_paths);
 
-			bool source_demand_left = false;
-			for (NodeID dest = 0; dest < size; ++dest) {
-				Edge edge = this->job[source][dest];
-				Path *path = paths[dest];
-				if (edge.UnsatisfiedDemand() > 0 && path->GetFreeCapacity() > INT_MIN) {
-					this->PushFlow(edge, path, accuracy, UINT_MAX);
-					if (edge.UnsatisfiedDemand() > 0) {
-						demand_left = true;
-						source_demand_left = true;
+			for (size_t i = 0; i < sources.size(); ++i) {
+				NodeID source = sources[i];
+				PathVector &paths = batch_paths[i];
+				bool source_demand_left = false;
+				for (NodeID dest = 0; dest < size; ++dest) {
+					Edge edge = this->job[source][dest];
+					Path *path = paths[dest];
+					if (edge.UnsatisfiedDemand() > 0 && path->GetFreeCapacity() > INT_MIN) {
+						this->PushFlow(edge, path, accuracy, UINT_MAX);
+						if (edge.UnsatisfiedDemand() > 0) {
+							demand_left = true;
+							source_demand_left = true;
+						}
 					}
 				}
+				finished_sources[source] = !source_demand_left;
+				this->CleanupPaths(source, paths);
 			}
-			finished_sources[source] = !source_demand_left;
-			this->CleanupPaths(source, paths);
 		}
 	}
 }
@@ -4,6 +4,7 @@
 #define MCF_H
 
 #include "linkgraphjob_base.h"
+#include <atomic>
 #include <vector>
 
 typedef std::vector<Path *> PathVector;
@@ -24,6 +25,14 @@ protected:
 	template<class Tannotation, class Tedge_iterator>
 	void Dijkstra(NodeID from, PathVector &paths);
 
+	template<class Tannotation, class Tedge_iterator>
+	void Dijkstra(const std::vector<NodeID> &sources, std::vector<PathVector> &paths);
+
+	template<class Tannotation, class Tedge_iterator>
+	static void DijkstraWorker(MultiCommodityFlow *mcf, const std::vector<NodeID> *sources, std::vector<PathVector> *paths, std::atomic<size_t> *next);
+
+	NodeID NextSources(const std::vector<bool> &finished_sources, NodeID first, std::vector<NodeID> &sources) const;
+
 	uint PushFlow(Edge &edge, Path *path, uint accuracy, uint max_saturation);
 
 	void CleanupPaths(NodeID source, PathVector &paths);
@@ -10,6 +10,7 @@
 #include "stdafx.h"
 #include "debug.h"
 #include "core/alloc_func.hpp"
+#include "core/mem_func.hpp"
 #include "water_map.h"
 #include "string_func.h"
 
@@ -27,8 +28,13 @@ uint _map_size_y;    ///< Size of the map along the Y
 uint _map_size;      ///< The number of tiles on the map
 uint _map_tile_mask; ///< _map_size - 1 (to mask the mapsize)
 
+#ifdef WITH_MAP_PLANES
+TilePlanes _m = {};          ///< Tiles of the map
+TileExtendedPlanes _me = {}; ///< Extended Tiles of the map
+#else
 Tile *_m = nullptr;          ///< Tiles of the map
 TileExtended *_me = nullptr; ///< Extended Tiles of the map
+#endif /* WITH_MAP_PLANES */
 
 
 /**
@@ -56,12 +62,102 @@ void AllocateMap(uint size_x, uint size_y)
 	_map_size = size_x * size_y;
 	_map_tile_mask = _map_size - 1;
 
+#ifdef WITH_MAP_PLANES
+	_m.Allocate(_map_size);
+	_me.Allocate(_map_size);
+#else
 	free(_m);
 	free(_me);
 
 	_m = CallocT<Tile>(_map_size);
 	_me = CallocT<TileExtended>(_map_size);
+#endif /* WITH_MAP_PLANES */
+}
+
+/**
+ * Reset all data, including the extended data, of a range of tiles to zero.
+ * @param begin First tile to clear.
+ * @param count Number of tiles to clear.
+ */
+void ClearMapTiles(TileIndex begin, uint count)
+{
+	assert(begin + count <= MapSize());
+#ifdef WITH_MAP_PLANES
+	_m.Clear(begin, count);
+	_me.Clear(begin, count);
+#else
+	MemSetT(_m + begin, 0, count);
+	MemSetT(_me + begin, 0, count);
+#endif /* WITH_MAP_PLANES */
+}
+
+#ifdef WITH_MAP_PLANES
+/**
+ * (Re)allocate the planes of the tile data, with all data set to zero.
+ * @param size Number of tiles of the map.
+ */
+void TilePlanes::Allocate(size_t size)
+{
+	free(this->type);
+	free(this->height);
+	free(this->m2);
+	free(this->m1);
+	free(this->m3);
+	free(this->m4);
+	free(this->m5);
+
+	this->type = CallocT<byte>(size);
+	this->height = CallocT<byte>(size);
+	this->m2 = CallocT<uint16>(size);
+	this->m1 = CallocT<byte>(size);
+	this->m3 = CallocT<byte>(size);
+	this->m4 = CallocT<byte>(size);
+	this->m5 = CallocT<byte>(size);
+}
+
+/**
+ * Reset the tile data of a range of tiles to zero.
+ * @param begin First tile to clear.
+ * @param count Number of tiles to clear.
+ */
+void TilePlanes::Clear(size_t begin, size_t count)
+{
+	MemSetT(this->type + begin, 0, count);
+	MemSetT(this->height + begin, 0, count);
+	MemSetT(this->m2 + begin, 0, count);
+	MemSetT(this->m1 + begin, 0, count);
+	MemSetT(this->m3 + begin, 0, count);
+	MemSetT(this->m4 + begin, 0, count);
+	MemSetT(this->m5 + begin, 0, count);
+}
+
+/**
+ * (Re)allocate the planes of the extended tile data, with all data set to zero.
+ * @param size Number of tiles of the map.
+ */
+void TileExtendedPlanes::Allocate(size_t size)
+{
+	free(this->m6);
+	free(this->m7);
+	free(this->m8);
+
+	this->m6 = CallocT<byte>(size);
+	this->m7 = CallocT<byte>(size);
+	this->m8 = CallocT<uint16>(size);
+}
+
+/**
+ * Reset the extended tile data of a range of tiles to zero.
+ * @param begin First tile to clear.
+ * @param count Number of tiles to clear.
+ */
+void TileExtendedPlanes::Clear(size_t begin, size_t count)
+{
+	MemSetT(this->m6 + begin, 0, count);
+	MemSetT(this->m7 + begin, 0, count);
+	MemSetT(this->m8 + begin, 0, count);
 }
+#endif /* WITH_MAP_PLANES */
 
 
 #ifdef _DEBUG
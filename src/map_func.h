@@ -25,6 +25,22 @@ extern uint _map_tile_mask;
 
 #define TILE_MASK(x) ((x) & _map_tile_mask)
 
+#ifdef WITH_MAP_PLANES
+/**
+ * The planes of the tile data.
+ *
+ * This variable contains the arrays with the data of the tiles of the map.
+ */
+extern TilePlanes _m;
+
+/**
+ * The planes of the extended tile data.
+ *
+ * This variable contains the arrays with the extended data of the tiles
+ * of the map.
+ */
+extern TileExtendedPlanes _me;
+#else
 /**
  * Pointer to the tile-array.
  *
@@ -40,8 +56,10 @@ extern Tile *_m;
  * of the map.
  */
 extern TileExtended *_me;
+#endif /* WITH_MAP_PLANES */
 
 void AllocateMap(uint size_x, uint size_y);
+void ClearMapTiles(TileIndex begin, uint count);
 
 /**
  * Logarithm of the map size along the X side.
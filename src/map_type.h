@@ -36,6 +36,73 @@ struct TileExtended {
 	uint16 m8; ///< General purpose
 };
 
+#ifdef WITH_MAP_PLANES
+/**
+ * References to the data of a single tile in #TilePlanes.
+ * Gives the same access to the data as #Tile.
+ */
+struct TileRef {
+	byte   &type;       ///< The type (bits 4..7), bridges (2..3), rainforest/desert (0..1)
+	byte   &height;     ///< The height of the northern corner.
+	uint16 &m2;         ///< Primarily used for indices to towns, industries and stations
+	byte   &m1;         ///< Primarily used for ownership information
+	byte   &m3;         ///< General purpose
+	byte   &m4;         ///< General purpose
+	byte   &m5;         ///< General purpose
+};
+
+/**
+ * References to the data of a single tile in #TileExtendedPlanes.
+ * Gives the same access to the data as #TileExtended.
+ */
+struct TileExtendedRef {
+	byte   &m6;         ///< General purpose
+	byte   &m7;         ///< Primarily used for newgrf support
+	uint16 &m8;         ///< General purpose
+};
+
+/**
+ * The data of the tiles of the map, stored as a separate array (plane) for
+ * each member of #Tile. Scanning the map for a single member, e.g. the type
+ * or the height, then only touches the memory of that member.
+ */
+struct TilePlanes {
+	byte   *type;       ///< Plane of Tile::type.
+	byte   *height;     ///< Plane of Tile::height.
+	uint16 *m2;         ///< Plane of Tile::m2.
+	byte   *m1;         ///< Plane of Tile::m1.
+	byte   *m3;         ///< Plane of Tile::m3.
+	byte   *m4;         ///< Plane of Tile::m4.
+	byte   *m5;         ///< Plane of Tile::m5.
+
+	void Allocate(size_t size);
+	void Clear(size_t begin, size_t count);
+
+	inline TileRef operator[](size_t t) const
+	{
+		return { this->type[t], this->height[t], this->m2[t], this->m1[t], this->m3[t], this->m4[t], this->m5[t] };
+	}
+};
+
+/**
+ * The extended data of the tiles of the map, stored as a separate array
+ * (plane) for each member of #TileExtended.
+ */
+struct TileExtendedPlanes {
+	byte   *m6;         ///< Plane of TileExtended::m6.
+	byte   *m7;         ///< Plane of TileExtended::m7.
+	uint16 *m8;         ///< Plane of TileExtended::m8.
+
+	void Allocate(size_t size);
+	void Clear(size_t begin, size_t count);
+
+	inline TileExtendedRef operator[](size_t t) const
+	{
+		return { this->m6[t], this->m7[t], this->m8[t] };
+	}
+};
+#endif /* WITH_MAP_PLANES */
+
 /**
  * An offset value between to tiles.
  *
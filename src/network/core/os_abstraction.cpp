@@ -172,3 +172,80 @@ NetworkError GetSocketError(SOCKET d)
 
 	return NetworkError(err);
 }
+
+/** Create an empty set of sockets to check. */
+SocketReadiness::SocketReadiness()
+{
+#ifndef HAVE_POLL
+	FD_ZERO(&this->read_fd);
+	FD_ZERO(&this->write_fd);
+#endif
+}
+
+/**
+ * Add a socket to check. It is always checked for being readable.
+ * @param s The socket to check.
+ * @param write Whether to check for the socket being writable as well.
+ * @return The index to get the readiness of the socket with.
+ */
+size_t SocketReadiness::Add(SOCKET s, bool write)
+{
+#ifdef HAVE_POLL
+	struct pollfd fd;
+	fd.fd = s;
+	fd.events = POLLIN | (write ? POLLOUT : 0);
+	fd.revents = 0;
+	this->fds.push_back(fd);
+	return this->fds.size() - 1;
+#else
+	FD_SET(s, &this->read_fd);
+	if (write) FD_SET(s, &this->write_fd);
+	this->sockets.push_back(s);
+	return this->sockets.size() - 1;
+#endif
+}
+
+/**
+ * Determine which of the sockets are readable and writable, without blocking.
+ * @return False iff the readiness could not be determined.
+ */
+bool SocketReadiness::Check()
+{
+#ifdef HAVE_POLL
+	if (this->fds.empty()) return true;
+	return poll(this->fds.data(), this->fds.size(), 0) >= 0;
+#else
+	struct timeval tv;
+	tv.tv_sec = tv.tv_usec = 0; // don't block at all.
+	return select(FD_SETSIZE, &this->read_fd, &this->write_fd, nullptr, &tv) >= 0;
+#endif
+}
+
+/**
+ * Whether a socket can be read from, or has been closed by the other side.
+ * @param index The index #Add returned for the socket.
+ * @return True iff reading from the socket will not block.
+ */
+bool SocketReadiness::IsReadable(size_t index) const
+{
+#ifdef HAVE_POLL
+	/* Errors and hang ups are reported by the following read. */
+	return (this->fds[index].revents & (POLLIN | POLLERR | POLLHUP)) != 0;
+#else
+	return FD_ISSET(this->sockets[index], &this->read_fd) != 0;
+#endif
+}
+
+/**
+ * Whether a socket can be written to.
+ * @param index The index #Add returned for the socket.
+ * @return True iff writing to the socket will not block.
+ */
+bool SocketReadiness::IsWritable(size_t index) const
+{
+#ifdef HAVE_POLL
+	return (this->fds[index].revents & POLLOUT) != 0;
+#else
+	return FD_ISSET(this->sockets[index], &this->write_fd) != 0;
+#endif
+}
@@ -14,6 +14,8 @@
 #ifndef NETWORK_CORE_OS_ABSTRACTION_H
 #define NETWORK_CORE_OS_ABSTRACTION_H
 
+#include <vector>
+
 /**
  * Abstraction of a network error where all implementation details of the
  * error codes are encapsulated in this class and the abstraction layer.
@@ -99,6 +101,15 @@ typedef unsigned long in_addr_t;
 #	include <sys/time.h>
 #	include <netdb.h>
 
+/* On Linux use poll() instead of select(), so the number of sockets is not
+ * limited by FD_SETSIZE, and writev() to send multiple packets at once. */
+#	if defined(__linux__)
+#		include <poll.h>
+#		include <sys/uio.h>
+#		define HAVE_POLL
+#		define HAVE_WRITEV
+#	endif
+
 #   if defined(__EMSCRIPTEN__)
 /* Emscripten doesn't support AI_ADDRCONFIG and errors out on it. */
 #		undef AI_ADDRCONFIG
@@ -198,6 +209,29 @@ bool SetNonBlocking(SOCKET d);
 bool SetNoDelay(SOCKET d);
 NetworkError GetSocketError(SOCKET d);
 
+/**
+ * The readiness for reading and writing of a number of sockets, determined
+ * with a single call to the operating system without blocking.
+ */
+class SocketReadiness {
+private:
+#ifdef HAVE_POLL
+	std::vector<struct pollfd> fds; ///< The sockets and the events to check for.
+#else
+	std::vector<SOCKET> sockets;    ///< The sockets to check.
+	fd_set read_fd;                 ///< Sockets that are, or have to be checked for being, readable.
+	fd_set write_fd;                ///< Sockets that are, or have to be checked for being, writable.
+#endif
+
+public:
+	SocketReadiness();
+
+	size_t Add(SOCKET s, bool write);
+	bool Check();
+	bool IsReadable(size_t index) const;
+	bool IsWritable(size_t index) const;
+};
+
 /* Make sure these structures have the size we expect them to be */
 static_assert(sizeof(in_addr)  ==  4); ///< IPv4 addresses should be 4 bytes.
 static_assert(sizeof(in6_addr) == 16); ///< IPv6 addresses should be 16 bytes.
@@ -14,8 +14,64 @@
 
 #include "packet.h"
 
+#include <mutex>
+
 #include "../../safeguards.h"
 
+/** Maximum number of buffers of destroyed packets to keep for reuse. */
+static const size_t PACKET_BUFFER_POOL_SIZE = 256;
+
+/** Buffers of destroyed packets, kept so new packets do not need to allocate memory. */
+struct PacketBufferPool {
+	std::mutex mutex;                       ///< Packets are made by several threads.
+	std::vector<std::vector<byte>> buffers; ///< The unused buffers.
+};
+
+/**
+ * Get the pool with packet buffers. It is never destroyed, so packets that
+ * are destroyed while the program exits can still release their buffer.
+ * @return The pool.
+ */
+static PacketBufferPool &GetPacketBufferPool()
+{
+	static PacketBufferPool *pool = new PacketBufferPool();
+	return *pool;
+}
+
+/**
+ * Get an empty buffer for a packet, from the pool when possible.
+ * @return The buffer.
+ */
+static std::vector<byte> AcquirePacketBuffer()
+{
+	PacketBufferPool &pool = GetPacketBufferPool();
+	std::lock_guard<std::mutex> lock(pool.mutex);
+
+	if (pool.buffers.empty()) return std::vector<byte>();
+
+	std::vector<byte> buffer = std::move(pool.buffers.back());
+	pool.buffers.pop_back();
+	return buffer;
+}
+
+/**
+ * Return the buffer of a destroyed packet to the pool.
+ * @param buffer The buffer.
+ */
+static void ReleasePacketBuffer(std::vector<byte> &&buffer)
+{
+	/* Do not keep buffers that never got any memory, or that are unusually large. */
+	if (buffer.capacity() == 0 || buffer.capacity() > TCP_MTU) return;
+
+	PacketBufferPool &pool = GetPacketBufferPool();
+	std::lock_guard<std::mutex> lock(pool.mutex);
+
+	if (pool.buffers.size() >= PACKET_BUFFER_POOL_SIZE) return;
+
+	buffer.clear();
+	pool.buffers.push_back(std::move(buffer));
+}
+
 /**
  * Create a packet that is used to read from a network socket.
  * @param cs                The socket handler associated with the socket we are reading from.
@@ -28,7 +84,7 @@
  *                          loose some the data of the packet, so there you pass the maximum
  *                          size for the packet you expect from the network.
  */
-Packet::Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size) : next(nullptr), pos(0), limit(limit)
+Packet::Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size) : pos(0), buffer(AcquirePacketBuffer()), limit(limit)
 {
 	assert(cs != nullptr);
 
@@ -44,7 +100,7 @@ Packet::Packet(NetworkSocketHandler *cs, size_t limit, size_t initial_read_size)
  *              the limit as it might break things if the other side is not expecting
  *              much larger packets than what they support.
  */
-Packet::Packet(PacketType type, size_t limit) : next(nullptr), pos(0), limit(limit), cs(nullptr)
+Packet::Packet(PacketType type, size_t limit) : pos(0), buffer(AcquirePacketBuffer()), limit(limit), cs(nullptr)
 {
 	/* Allocate space for the the size so we can write that in just before sending the packet. */
 	this->Send_uint16(0);
@@ -52,43 +108,25 @@ Packet::Packet(PacketType type, size_t limit) : next(nullptr), pos(0), limit(lim
 }
 
 /**
- * Add the given Packet to the end of the queue of packets.
- * @param queue  The pointer to the begin of the queue.
- * @param packet The packet to append to the queue.
- */
-/* static */ void Packet::AddToQueue(Packet **queue, Packet *packet)
-{
-	while (*queue != nullptr) queue = &(*queue)->next;
-	*queue = packet;
-}
-
-/**
- * Pop the packet from the begin of the queue and set the
- * begin of the queue to the second element in the queue.
- * @param queue  The pointer to the begin of the queue.
- * @return The Packet that used to be a the begin of the queue.
+ * Return the buffer of the packet to the pool, so a next packet does not
+ * need to allocate its own.
  */
-/* static */ Packet *Packet::PopFromQueue(Packet **queue)
+Packet::~Packet()
 {
-	Packet *p = *queue;
-	*queue = p->next;
-	p->next = nullptr;
-	return p;
+	ReleasePacketBuffer(std::move(this->buffer));
 }
 
-
 /**
  * Writes the packet size from the raw packet from packet->size
  */
 void Packet::PrepareToSend()
 {
-	assert(this->cs == nullptr && this->next == nullptr);
+	assert(this->cs == nullptr);
 
 	this->buffer[0] = GB(this->Size(), 0, 8);
 	this->buffer[1] = GB(this->Size(), 8, 8);
 
 	this->pos  = 0; // We start reading from here
-	this->buffer.shrink_to_fit();
 }
 
 /**
@@ -257,7 +295,7 @@ size_t Packet::Size() const
  */
 bool Packet::ParsePacketSize()
 {
-	assert(this->cs != nullptr && this->next == nullptr);
+	assert(this->cs != nullptr);
 	size_t size = (size_t)this->buffer[0];
 	size       += (size_t)this->buffer[1] << 8;
 
@@ -403,3 +441,23 @@ size_t Packet::RemainingBytesToTransfer() const
 {
 	return this->Size() - this->pos;
 }
+
+/**
+ * Get the data that still has to be transferred, for transfer functions that
+ * cannot be passed to the Transfer functions, such as writev.
+ * @return Pointer to the first of the #RemainingBytesToTransfer bytes to transfer.
+ */
+const byte *Packet::GetBufferToTransfer() const
+{
+	return this->buffer.data() + this->pos;
+}
+
+/**
+ * Mark bytes of the data returned by #GetBufferToTransfer as transferred.
+ * @param amount The number of bytes that have been transferred.
+ */
+void Packet::MarkTransferred(size_t amount)
+{
+	assert(amount <= this->RemainingBytesToTransfer());
+	this->pos += static_cast<PacketSize>(amount);
+}
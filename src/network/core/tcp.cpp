@@ -22,7 +22,7 @@
  */
 NetworkTCPSocketHandler::NetworkTCPSocketHandler(SOCKET s) :
 		NetworkSocketHandler(),
-		packet_queue(nullptr), packet_recv(nullptr),
+		packet_recv(nullptr),
 		sock(s), writable(false)
 {
 }
@@ -38,9 +38,8 @@ NetworkTCPSocketHandler::~NetworkTCPSocketHandler()
  */
 void NetworkTCPSocketHandler::EmptyPacketQueue()
 {
-	while (this->packet_queue != nullptr) {
-		delete Packet::PopFromQueue(&this->packet_queue);
-	}
+	for (Packet *p : this->packet_queue) delete p;
+	this->packet_queue.clear();
 	delete this->packet_recv;
 	this->packet_recv = nullptr;
 }
@@ -83,7 +82,7 @@ void NetworkTCPSocketHandler::SendPacket(Packet *packet)
 	assert(packet != nullptr);
 
 	packet->PrepareToSend();
-	Packet::AddToQueue(&this->packet_queue, packet);
+	this->packet_queue.push_back(packet);
 }
 
 /**
@@ -99,14 +98,25 @@ void NetworkTCPSocketHandler::SendPacket(Packet *packet)
 SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 {
 	ssize_t res;
-	Packet *p;
 
 	/* We can not write to this socket!! */
 	if (!this->writable) return SPS_NONE_SENT;
 	if (!this->IsConnected()) return SPS_CLOSED;
 
-	while ((p = this->packet_queue) != nullptr) {
-		res = p->TransferOut<int>(send, this->sock, 0);
+	while (!this->packet_queue.empty()) {
+#ifdef HAVE_WRITEV
+		/* Hand as many queued packets as possible to the OS in one go. */
+		struct iovec iov[SEND_PACKETS_BATCH_SIZE];
+		int count = 0;
+		for (Packet *p : this->packet_queue) {
+			iov[count].iov_base = const_cast<byte *>(p->GetBufferToTransfer());
+			iov[count].iov_len = p->RemainingBytesToTransfer();
+			if (++count == SEND_PACKETS_BATCH_SIZE) break;
+		}
+		res = writev(this->sock, iov, count);
+#else
+		res = this->packet_queue.front()->TransferOut<int>(send, this->sock, 0);
+#endif
 		if (res == -1) {
 			NetworkError err = NetworkError::GetLast();
 			if (!err.WouldBlock()) {
@@ -125,13 +135,33 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 			return SPS_CLOSED;
 		}
 
+#ifdef HAVE_WRITEV
+		/* Skip past what has been sent of the packets. */
+		size_t sent = res;
+		while (sent != 0) {
+			Packet *p = this->packet_queue.front();
+			size_t amount = std::min(sent, p->RemainingBytesToTransfer());
+			p->MarkTransferred(amount);
+			sent -= amount;
+
+			if (p->RemainingBytesToTransfer() != 0) break;
+			delete p;
+			this->packet_queue.pop_front();
+		}
+		if (!this->packet_queue.empty() && this->packet_queue.front()->RemainingBytesToTransfer() != this->packet_queue.front()->Size()) {
+			/* The OS did not take everything, so it is full for now. */
+			return SPS_PARTLY_SENT;
+		}
+#else
 		/* Is this packet sent? */
-		if (p->RemainingBytesToTransfer() == 0) {
+		if (this->packet_queue.front()->RemainingBytesToTransfer() == 0) {
 			/* Go to the next packet */
-			delete Packet::PopFromQueue(&this->packet_queue);
+			delete this->packet_queue.front();
+			this->packet_queue.pop_front();
 		} else {
 			return SPS_PARTLY_SENT;
 		}
+#endif
 	}
 
 	return SPS_ALL_SENT;
@@ -217,18 +247,10 @@ Packet *NetworkTCPSocketHandler::ReceivePacket()
  */
 bool NetworkTCPSocketHandler::CanSendReceive()
 {
-	fd_set read_fd, write_fd;
-	struct timeval tv;
-
-	FD_ZERO(&read_fd);
-	FD_ZERO(&write_fd);
-
-	FD_SET(this->sock, &read_fd);
-	FD_SET(this->sock, &write_fd);
-
-	tv.tv_sec = tv.tv_usec = 0; // don't block at all.
-	if (select(FD_SETSIZE, &read_fd, &write_fd, nullptr, &tv) < 0) return false;
+	SocketReadiness readiness;
+	size_t index = readiness.Add(this->sock, true);
+	if (!readiness.Check()) return false;
 
-	this->writable = !!FD_ISSET(this->sock, &write_fd);
-	return FD_ISSET(this->sock, &read_fd) != 0;
+	this->writable = readiness.IsWritable(index);
+	return readiness.IsReadable(index);
 }
@@ -17,6 +17,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <deque>
 #include <map>
 #include <thread>
 
@@ -31,7 +32,9 @@ enum SendPacketsState {
 /** Base socket handler for all TCP sockets */
 class NetworkTCPSocketHandler : public NetworkSocketHandler {
 private:
-	Packet *packet_queue;     ///< Packets that are awaiting delivery
+	static const int SEND_PACKETS_BATCH_SIZE = 64; ///< Maximum number of packets to send with one call to the OS.
+
+	std::deque<Packet *> packet_queue; ///< Packets that are awaiting delivery
 	Packet *packet_recv;      ///< Partially received packet
 
 	void EmptyPacketQueue();
@@ -59,7 +62,7 @@ public:
 	 * Whether there is something pending in the send queue.
 	 * @return true when something is pending in the send queue.
 	 */
-	bool HasSendQueue() { return this->packet_queue != nullptr; }
+	bool HasSendQueue() { return !this->packet_queue.empty(); }
 
 	NetworkTCPSocketHandler(SOCKET s = INVALID_SOCKET);
 	~NetworkTCPSocketHandler();
@@ -98,37 +98,39 @@ public:
 	 */
 	static bool Receive()
 	{
-		fd_set read_fd, write_fd;
-		struct timeval tv;
-
-		FD_ZERO(&read_fd);
-		FD_ZERO(&write_fd);
-
+		SocketReadiness readiness;
+		std::vector<size_t> readable;
 
 		for (Tsocket *cs : Tsocket::Iterate()) {
-			FD_SET(cs->sock, &read_fd);
-			FD_SET(cs->sock, &write_fd);
+			readiness.Add(cs->sock, true);
 		}
 
 		/* take care of listener port */
 		for (auto &s : sockets) {
-			FD_SET(s.second, &read_fd);
+			readiness.Add(s.second, false);
 		}
 
-		tv.tv_sec = tv.tv_usec = 0; // don't block at all.
-		if (select(FD_SETSIZE, &read_fd, &write_fd, nullptr, &tv) < 0) return false;
+		if (!readiness.Check()) return false;
+
+		/* Determine the readiness of the clients before accepting new ones,
+		 * as those may take the place of a client in the pool. */
+		size_t index = 0;
+		for (Tsocket *cs : Tsocket::Iterate()) {
+			cs->writable = readiness.IsWritable(index);
+			if (readiness.IsReadable(index)) readable.push_back(cs->index);
+			index++;
+		}
 
 		/* accept clients.. */
 		for (auto &s : sockets) {
-			if (FD_ISSET(s.second, &read_fd)) AcceptClient(s.second);
+			if (readiness.IsReadable(index++)) AcceptClient(s.second);
 		}
 
 		/* read stuff from clients */
-		for (Tsocket *cs : Tsocket::Iterate()) {
-			cs->writable = !!FD_ISSET(cs->sock, &write_fd);
-			if (FD_ISSET(cs->sock, &read_fd)) {
-				cs->ReceivePackets();
-			}
+		for (size_t cs_index : readable) {
+			/* The client might have been removed while handling another client. */
+			Tsocket *cs = Tsocket::GetIfValid(cs_index);
+			if (cs != nullptr) cs->ReceivePackets();
 		}
 		return _networking;
 	}
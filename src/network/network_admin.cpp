@@ -21,6 +21,8 @@
 #include "../map_func.h"
 #include "../rev.h"
 #include "../game/game.hpp"
+#include "../game/game_instance.hpp"
+#include "../ai/ai_instance.hpp"
 
 #include "../safeguards.h"
 
@@ -53,6 +55,7 @@ static const AdminUpdateFrequency _admin_update_type_frequencies[] = {
 	ADMIN_FREQUENCY_POLL,                                                                                                                                  ///< ADMIN_UPDATE_CMD_NAMES
 	                       ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_CMD_LOGGING
 	                       ADMIN_FREQUENCY_AUTOMATIC,                                                                                                      ///< ADMIN_UPDATE_GAMESCRIPT
+	ADMIN_FREQUENCY_POLL | ADMIN_FREQUENCY_DAILY | ADMIN_FREQUENCY_WEEKLY | ADMIN_FREQUENCY_MONTHLY | ADMIN_FREQUENCY_QUARTERLY | ADMIN_FREQUENCY_ANUALLY, ///< ADMIN_UPDATE_SCRIPT_TIME
 };
 /** Sanity check. */
 static_assert(lengthof(_admin_update_type_frequencies) == ADMIN_UPDATE_END);
@@ -442,6 +445,36 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyStats()
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/**
+ * Send the time used by a script.
+ * @param company The company of the AI, or #OWNER_DEITY for the GameScript.
+ * @param instance The instance of the script.
+ */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendScriptTime(CompanyID company, const ScriptInstance *instance)
+{
+	Packet *p = new Packet(ADMIN_PACKET_SERVER_SCRIPT_TIME);
+
+	p->Send_uint8 (company);
+	p->Send_uint64(instance->GetTotalTime().count());
+	p->Send_uint32((uint32)std::min<int64>(instance->GetLastTime().count(), UINT32_MAX));
+	p->Send_uint32(instance->GetTimeSuspends());
+
+	this->SendPacket(p);
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
+/** Send the time used by all running scripts. */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendScriptTimes()
+{
+	for (const Company *company : Company::Iterate()) {
+		if (company->is_ai && company->ai_instance != nullptr) this->SendScriptTime(company->index, company->ai_instance);
+	}
+
+	if (Game::GetInstance() != nullptr) this->SendScriptTime(OWNER_DEITY, Game::GetInstance());
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 /**
  * Send a chat message.
  * @param action The action associated with the message.
@@ -748,6 +781,11 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::Receive_ADMIN_POLL(Packet *p)
 			this->SendCmdNames();
 			break;
 
+		case ADMIN_UPDATE_SCRIPT_TIME:
+			/* The admin is requesting the time used by the scripts. */
+			this->SendScriptTimes();
+			break;
+
 		default:
 			/* An unsupported "poll" update type. */
 			Debug(net, 1, "[admin] Not supported poll {} ({}) from '{}' ({}).", type, d1, this->admin_name, this->admin_version);
@@ -995,6 +1033,10 @@ void NetworkAdminUpdate(AdminUpdateFrequency freq)
 						as->SendCompanyStats();
 						break;
 
+					case ADMIN_UPDATE_SCRIPT_TIME:
+						as->SendScriptTimes();
+						break;
+
 					default: NOT_REACHED();
 				}
 			}
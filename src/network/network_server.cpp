@@ -29,8 +29,8 @@
 #include "../core/pool_func.hpp"
 #include "../core/random_func.hpp"
 #include "../rev.h"
+#include <atomic>
 #include <mutex>
-#include <condition_variable>
 
 #include "../safeguards.h"
 
@@ -53,152 +53,161 @@ INSTANTIATE_POOL_METHODS(NetworkClientSocket)
 /** Instantiate the listen sockets. */
 template SocketList TCPListenHandler<ServerNetworkGameSocketHandler, PACKET_SERVER_FULL, PACKET_SERVER_BANNED>::sockets;
 
-/** Writing a savegame directly to a number of packets. */
-struct PacketWriter : SaveFilter {
-	ServerNetworkGameSocketHandler *cs; ///< Socket we are associated with.
-	Packet *current;                    ///< The packet we're currently writing to.
-	size_t total_size;                  ///< Total size of the compressed savegame.
-	Packet *packets;                    ///< Packet queue of the savegame; send these "slowly" to the client.
-	std::mutex mutex;                   ///< Mutex for making threaded saving safe.
-	std::condition_variable exit_sig;   ///< Signal for threaded destruction of this packet writer.
+/**
+ * A savegame of the game at a single frame. The savegame is made once and then
+ * shared between all clients that start downloading the map during that frame,
+ * so they can receive it in parallel instead of each getting their own copy.
+ * Blocks of the savegame never change once written, so any number of clients
+ * can read them while the rest of the savegame is still being compressed.
+ */
+struct NetworkMapSnapshot {
+	static const size_t BLOCK_SIZE = 64 * 1024;  ///< Size of the blocks the savegame is stored in.
+
+	uint32 frame;                                ///< Frame the savegame has been made at.
+	std::mutex mutex;                            ///< Mutex for making threaded saving safe.
+	std::vector<std::unique_ptr<byte[]>> blocks; ///< Blocks with the compressed savegame.
+	size_t size;                                 ///< Number of bytes of the savegame written so far.
+	bool writing;                                ///< Whether the savegame is still being written.
+	bool finished;                               ///< Whether the whole savegame has been written successfully.
+	std::atomic<bool> cancelled;                 ///< Whether writing the savegame should be aborted.
+	uint clients;                                ///< Number of clients downloading this savegame.
 
 	/**
-	 * Create the packet writer.
-	 * @param cs The socket handler we're making the packets for.
+	 * Create the snapshot.
+	 * @param frame The frame the savegame is made at.
 	 */
-	PacketWriter(ServerNetworkGameSocketHandler *cs) : SaveFilter(nullptr), cs(cs), current(nullptr), total_size(0), packets(nullptr)
+	NetworkMapSnapshot(uint32 frame) : frame(frame), size(0), writing(true), finished(false), cancelled(false), clients(0)
 	{
 	}
 
-	/** Make sure everything is cleaned up. */
-	~PacketWriter()
+	/**
+	 * Add data to the end of the savegame.
+	 * @param buf The data to add.
+	 * @param len The number of bytes to add.
+	 */
+	void Append(const byte *buf, size_t len)
 	{
-		std::unique_lock<std::mutex> lock(this->mutex);
-
-		if (this->cs != nullptr) this->exit_sig.wait(lock);
+		std::lock_guard<std::mutex> lock(this->mutex);
 
-		/* This must all wait until the Destroy function is called. */
+		while (len > 0) {
+			size_t offset = this->size % BLOCK_SIZE;
+			if (offset == 0) this->blocks.emplace_back(new byte[BLOCK_SIZE]);
 
-		while (this->packets != nullptr) {
-			delete Packet::PopFromQueue(&this->packets);
+			size_t to_copy = std::min(len, BLOCK_SIZE - offset);
+			memcpy(this->blocks.back().get() + offset, buf, to_copy);
+			buf += to_copy;
+			len -= to_copy;
+			this->size += to_copy;
 		}
-
-		delete this->current;
 	}
 
 	/**
-	 * Begin the destruction of this packet writer. It can happen in two ways:
-	 * in the first case the client disconnected while saving the map. In this
-	 * case the saving has not finished and killed this PacketWriter. In that
-	 * case we simply set cs to nullptr, triggering the appending to fail due to
-	 * the connection problem and eventually triggering the destructor. In the
-	 * second case the destructor is already called, and it is waiting for our
-	 * signal which we will send. Only then the packets will be removed by the
-	 * destructor.
+	 * Fill a packet with data of the savegame. The mutex must be held.
+	 * @param p The packet to fill.
+	 * @param pos The position in the savegame to start at.
+	 * @param end The position in the savegame to stop at.
+	 * @return The position in the savegame after the data that has been written.
 	 */
-	void Destroy()
+	size_t FillPacket(Packet *p, size_t pos, size_t end) const
 	{
-		std::unique_lock<std::mutex> lock(this->mutex);
+		while (pos < end && p->CanWriteToPacket(1)) {
+			const byte *begin = this->blocks[pos / BLOCK_SIZE].get() + pos % BLOCK_SIZE;
+			size_t len = std::min(end - pos, BLOCK_SIZE - pos % BLOCK_SIZE);
+			pos += p->Send_bytes(begin, begin + len);
+		}
+		return pos;
+	}
+};
 
-		this->cs = nullptr;
+/** The last savegame made for clients to download, if any client is still interested in it. */
+static std::weak_ptr<NetworkMapSnapshot> _network_map_snapshot;
 
-		this->exit_sig.notify_all();
-		lock.unlock();
+/** Maximum number of bytes of the savegame to queue for a client at once. */
+static const size_t MAP_SNAPSHOT_QUEUE_SIZE = 1024 * 1024;
 
-		/* Make sure the saving is completely cancelled. Yes,
-		 * we need to handle the save finish as well as the
-		 * next connection might just be requesting a map. */
-		WaitTillSaved();
-		ProcessAsyncSaveFinish();
-	}
+/** Writing a savegame into a snapshot that is shared between clients. */
+struct NetworkMapSnapshotWriter : SaveFilter {
+	std::shared_ptr<NetworkMapSnapshot> snapshot; ///< The snapshot we are writing to.
 
 	/**
-	 * Transfer all packets from here to the network's queue while holding
-	 * the lock on our mutex.
-	 * @param socket The network socket to write to.
-	 * @return True iff the last packet of the map has been sent.
+	 * Create the snapshot writer.
+	 * @param snapshot The snapshot to write the savegame to.
 	 */
-	bool TransferToNetworkQueue(ServerNetworkGameSocketHandler *socket)
+	NetworkMapSnapshotWriter(std::shared_ptr<NetworkMapSnapshot> snapshot) : SaveFilter(nullptr), snapshot(snapshot)
 	{
-		/* Unsafe check for the queue being empty or not. */
-		if (this->packets == nullptr) return false;
-
-		std::lock_guard<std::mutex> lock(this->mutex);
-
-		while (this->packets != nullptr) {
-			Packet *p = Packet::PopFromQueue(&this->packets);
-			bool last_packet = p->GetPacketType() == PACKET_SERVER_MAP_DONE;
-			socket->SendPacket(p);
-
-			if (last_packet) return true;
-		}
-
-		return false;
 	}
 
-	/** Append the current packet to the queue. */
-	void AppendQueue()
+	/** Tell the clients waiting for the snapshot that it will not receive any more data. */
+	~NetworkMapSnapshotWriter()
 	{
-		if (this->current == nullptr) return;
-
-		Packet::AddToQueue(&this->packets, this->current);
-		this->current = nullptr;
+		std::lock_guard<std::mutex> lock(this->snapshot->mutex);
+		this->snapshot->writing = false;
 	}
 
-	/** Prepend the current packet to the queue. */
-	void PrependQueue()
+	void Write(byte *buf, size_t size) override
 	{
-		if (this->current == nullptr) return;
+		/* We want to abort the saving when no client wants the savegame any more. */
+		if (this->snapshot->cancelled) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
 
-		/* Reversed from AppendQueue so the queue gets added to the current one. */
-		Packet::AddToQueue(&this->current, this->packets);
-		this->packets = this->current;
-		this->current = nullptr;
+		this->snapshot->Append(buf, size);
 	}
 
-	void Write(byte *buf, size_t size) override
+	void Finish() override
 	{
-		/* We want to abort the saving when the socket is closed. */
-		if (this->cs == nullptr) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
+		/* We want to abort the saving when no client wants the savegame any more. */
+		if (this->snapshot->cancelled) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
 
-		if (this->current == nullptr) this->current = new Packet(PACKET_SERVER_MAP_DATA, TCP_MTU);
+		std::lock_guard<std::mutex> lock(this->snapshot->mutex);
+		this->snapshot->finished = true;
+	}
+};
 
-		std::lock_guard<std::mutex> lock(this->mutex);
+/**
+ * Get the snapshot of the current frame, making it when there is none yet.
+ * @return The snapshot of the current frame.
+ */
+static std::shared_ptr<NetworkMapSnapshot> GetNetworkMapSnapshot()
+{
+	std::shared_ptr<NetworkMapSnapshot> snapshot = _network_map_snapshot.lock();
+	if (snapshot != nullptr && snapshot->frame == _frame_counter && !snapshot->cancelled) return snapshot;
 
-		byte *bufe = buf + size;
-		while (buf != bufe) {
-			size_t written = this->current->Send_bytes(buf, bufe);
-			buf += written;
+	/* Make sure a previous savegame is not being written any more. */
+	WaitTillSaved();
 
-			if (!this->current->CanWriteToPacket(1)) {
-				this->AppendQueue();
-				if (buf != bufe) this->current = new Packet(PACKET_SERVER_MAP_DATA, TCP_MTU);
-			}
-		}
+	snapshot = std::make_shared<NetworkMapSnapshot>(_frame_counter);
+	_network_map_snapshot = snapshot;
 
-		this->total_size += size;
-	}
+	/* Make a dump of the current game */
+	if (SaveWithFilter(new NetworkMapSnapshotWriter(snapshot), true) != SL_OK) usererror("network savedump failed");
 
-	void Finish() override
-	{
-		/* We want to abort the saving when the socket is closed. */
-		if (this->cs == nullptr) SlError(STR_NETWORK_ERROR_LOSTCONNECTION);
+	return snapshot;
+}
 
-		std::lock_guard<std::mutex> lock(this->mutex);
+/**
+ * Check whether a snapshot for the clients is being written at the moment.
+ * @return True iff a snapshot is being written.
+ */
+static bool IsNetworkMapSnapshotBeingWritten()
+{
+	std::shared_ptr<NetworkMapSnapshot> snapshot = _network_map_snapshot.lock();
+	if (snapshot == nullptr) return false;
 
-		/* Make sure the last packet is flushed. */
-		this->AppendQueue();
+	std::lock_guard<std::mutex> lock(snapshot->mutex);
+	return snapshot->writing;
+}
 
-		/* Add a packet stating that this is the end to the queue. */
-		this->current = new Packet(PACKET_SERVER_MAP_DONE);
-		this->AppendQueue();
+/**
+ * Stop downloading a snapshot. When nobody else is downloading it, any saving
+ * that is still in progress will be cancelled.
+ * @param snapshot The snapshot that is not needed any more.
+ */
+static void ReleaseNetworkMapSnapshot(std::shared_ptr<NetworkMapSnapshot> &snapshot)
+{
+	if (snapshot == nullptr) return;
 
-		/* Fast-track the size to the client. */
-		this->current = new Packet(PACKET_SERVER_MAP_SIZE);
-		this->current->Send_uint32((uint32)this->total_size);
-		this->PrependQueue();
-	}
-};
+	if (--snapshot->clients == 0) snapshot->cancelled = true;
+	snapshot.reset();
+}
 
 
 /**
@@ -225,10 +234,7 @@ ServerNetworkGameSocketHandler::~ServerNetworkGameSocketHandler()
 	if (_redirect_console_to_client == this->client_id) _redirect_console_to_client = INVALID_CLIENT_ID;
 	OrderBackup::ResetUser(this->client_id);
 
-	if (this->savegame != nullptr) {
-		this->savegame->Destroy();
-		this->savegame = nullptr;
-	}
+	ReleaseNetworkMapSnapshot(this->map_snapshot);
 }
 
 Packet *ServerNetworkGameSocketHandler::ReceivePacket()
@@ -270,16 +276,6 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::CloseConnection(NetworkRecvSta
 		}
 	}
 
-	/* If we were transfering a map to this client, stop the savegame creation
-	 * process and queue the next client to receive the map. */
-	if (this->status == STATUS_MAP) {
-		/* Ensure the saving of the game is stopped too. */
-		this->savegame->Destroy();
-		this->savegame = nullptr;
-
-		this->CheckNextClientToSendMap(this);
-	}
-
 	NetworkAdminClientError(this->client_id, NETWORK_ERROR_CONNECTION_LOST);
 	Debug(net, 3, "Closed client connection {}", this->client_id);
 
@@ -325,6 +321,8 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::CloseConnection(NetworkRecvSta
 			}
 		}
 	}
+
+	ServerNetworkGameSocketHandler::CheckNextClientToSendMap();
 }
 
 static void NetworkHandleCommandQueue(NetworkClientSocket *cs);
@@ -567,29 +565,16 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendWait()
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
-void ServerNetworkGameSocketHandler::CheckNextClientToSendMap(NetworkClientSocket *ignore_cs)
+/** Start sending the map to the clients that are waiting for it, once the previous savegame has been written. */
+/* static */ void ServerNetworkGameSocketHandler::CheckNextClientToSendMap()
 {
-	/* Find the best candidate for joining, i.e. the first joiner. */
-	NetworkClientSocket *best = nullptr;
-	for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
-		if (ignore_cs == new_cs) continue;
+	if (IsNetworkMapSnapshotBeingWritten()) return;
 
+	/* All waiting clients will download the same savegame. */
+	for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
 		if (new_cs->status == STATUS_MAP_WAIT) {
-			if (best == nullptr || best->GetInfo()->join_date > new_cs->GetInfo()->join_date || (best->GetInfo()->join_date == new_cs->GetInfo()->join_date && best->client_id > new_cs->client_id)) {
-				best = new_cs;
-			}
-		}
-	}
-
-	/* Is there someone else to join? */
-	if (best != nullptr) {
-		/* Let the first start joining. */
-		best->status = STATUS_AUTHORIZED;
-		best->SendMap();
-
-		/* And update the rest. */
-		for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
-			if (new_cs->status == STATUS_MAP_WAIT) new_cs->SendWait();
+			new_cs->status = STATUS_AUTHORIZED;
+			new_cs->SendMap();
 		}
 	}
 }
@@ -603,11 +588,14 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendMap()
 	}
 
 	if (this->status == STATUS_AUTHORIZED) {
-		this->savegame = new PacketWriter(this);
+		this->map_snapshot = GetNetworkMapSnapshot();
+		this->map_snapshot->clients++;
+		this->map_snapshot_pos = 0;
+		this->map_size_sent = false;
 
 		/* Now send the _frame_counter and how many packets are coming */
 		Packet *p = new Packet(PACKET_SERVER_MAP_BEGIN);
-		p->Send_uint32(_frame_counter);
+		p->Send_uint32(this->map_snapshot->frame);
 		this->SendPacket(p);
 
 		NetworkSyncCommandQueue(this);
@@ -615,24 +603,49 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendMap()
 		/* Mark the start of download */
 		this->last_frame = _frame_counter;
 		this->last_frame_server = _frame_counter;
-
-		/* Make a dump of the current game */
-		if (SaveWithFilter(this->savegame, true) != SL_OK) usererror("network savedump failed");
 	}
 
 	if (this->status == STATUS_MAP) {
-		bool last_packet = this->savegame->TransferToNetworkQueue(this);
-		if (last_packet) {
-			/* Done reading, make sure saving is done as well */
-			this->savegame->Destroy();
-			this->savegame = nullptr;
+		/* Only queue more of the map once the previous part has been sent. */
+		if (this->HasSendQueue()) return NETWORK_RECV_STATUS_OKAY;
+
+		NetworkMapSnapshot *snapshot = this->map_snapshot.get();
+		bool done;
+		{
+			std::lock_guard<std::mutex> lock(snapshot->mutex);
 
-			/* Set the status to DONE_MAP, no we will wait for the client
-			 *  to send it is ready (maybe that happens like never ;)) */
-			this->status = STATUS_DONE_MAP;
+			if (!snapshot->writing && !snapshot->finished) {
+				/* Saving failed, so the client will never get the whole map. */
+				done = false;
+			} else {
+				/* Fast-track the size to the client. */
+				if (snapshot->finished && !this->map_size_sent) {
+					Packet *p = new Packet(PACKET_SERVER_MAP_SIZE);
+					p->Send_uint32((uint32)snapshot->size);
+					this->SendPacket(p);
+					this->map_size_sent = true;
+				}
 
-			this->CheckNextClientToSendMap();
+				size_t end = std::min(snapshot->size, this->map_snapshot_pos + MAP_SNAPSHOT_QUEUE_SIZE);
+				while (this->map_snapshot_pos < end) {
+					Packet *p = new Packet(PACKET_SERVER_MAP_DATA, TCP_MTU);
+					this->map_snapshot_pos = snapshot->FillPacket(p, this->map_snapshot_pos, end);
+					this->SendPacket(p);
+				}
+
+				if (!snapshot->finished || this->map_snapshot_pos != snapshot->size) return NETWORK_RECV_STATUS_OKAY;
+				done = true;
+			}
 		}
+
+		if (!done) return this->SendError(NETWORK_ERROR_GENERAL);
+
+		this->SendPacket(new Packet(PACKET_SERVER_MAP_DONE));
+		ReleaseNetworkMapSnapshot(this->map_snapshot);
+
+		/* Set the status to DONE_MAP, no we will wait for the client
+		 *  to send it is ready (maybe that happens like never ;)) */
+		this->status = STATUS_DONE_MAP;
 	}
 	return NETWORK_RECV_STATUS_OKAY;
 }
@@ -987,13 +1000,13 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::Receive_CLIENT_GETMAP(Packet *
 		return this->SendError(NETWORK_ERROR_NOT_AUTHORIZED);
 	}
 
-	/* Check if someone else is receiving the map */
-	for (NetworkClientSocket *new_cs : NetworkClientSocket::Iterate()) {
-		if (new_cs->status == STATUS_MAP) {
-			/* Tell the new client to wait */
-			this->status = STATUS_MAP_WAIT;
-			return this->SendWait();
-		}
+	/* Check if a savegame of another frame is still being made; the client
+	 * can join the next savegame together with everyone else waiting. */
+	std::shared_ptr<NetworkMapSnapshot> snapshot = _network_map_snapshot.lock();
+	if (snapshot != nullptr && (snapshot->frame != _frame_counter || snapshot->cancelled) && IsNetworkMapSnapshotBeingWritten()) {
+		/* Tell the new client to wait */
+		this->status = STATUS_MAP_WAIT;
+		return this->SendWait();
 	}
 
 	/* We receive a request to upload the map.. give it to the client! */
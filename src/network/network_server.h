@@ -71,7 +71,9 @@ public:
 	CommandQueue outgoing_queue; ///< The command-queue awaiting delivery
 	size_t receive_limit;        ///< Amount of bytes that we can receive at this moment
 
-	struct PacketWriter *savegame; ///< Writer used to write the savegame.
+	std::shared_ptr<struct NetworkMapSnapshot> map_snapshot; ///< Savegame that is being sent to the client.
+	size_t map_snapshot_pos;       ///< Number of bytes of the savegame that have been queued for the client.
+	bool map_size_sent;            ///< Whether the size of the savegame has been sent to the client.
 	NetworkAddress client_address; ///< IP-address of the client (so they can be banned)
 
 	ServerNetworkGameSocketHandler(SOCKET s);
@@ -81,7 +83,7 @@ public:
 	NetworkRecvStatus CloseConnection(NetworkRecvStatus status) override;
 	std::string GetClientName() const;
 
-	void CheckNextClientToSendMap(NetworkClientSocket *ignore_cs = nullptr);
+	static void CheckNextClientToSendMap();
 
 	NetworkRecvStatus SendWait();
 	NetworkRecvStatus SendMap();
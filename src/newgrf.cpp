@@ -5101,6 +5101,7 @@ static void NewSpriteGroup(ByteReader *buf)
 				}
 			}
 
+			group->Compile();
 			break;
 		}
 
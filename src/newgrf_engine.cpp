@@ -352,7 +352,10 @@ static byte MapAircraftMovementAction(const Aircraft *v)
 						break;
 					}
 				}
-				this->relative_scope.SetVehicle(v->Move(count));
+				v = v->Move(count);
+				/* Values read through the relative scope belong to the vehicle it pointed at before. */
+				if (v != this->relative_scope.v) InvalidateNewGRFVariableCache();
+				this->relative_scope.SetVehicle(v);
 			}
 			return &this->relative_scope;
 		}
@@ -1054,6 +1057,8 @@ VehicleResolverObject::VehicleResolverObject(EngineID engine_type, const Vehicle
 	relative_scope(*this, engine_type, v, info_view),
 	cached_relative_count(0)
 {
+	this->cache_variables = true;
+
 	if (wagon_override == WO_SELF) {
 		this->root_spritegroup = GetWagonOverrideSpriteSet(engine_type, CT_DEFAULT, engine_type);
 	} else {
@@ -52,6 +52,8 @@ void NewGRFProfiler::BeginResolve(const ResolverObject &resolver)
 	this->cur_call.cb = resolver.callback;
 	this->cur_call.feat = resolver.GetFeature();
 	this->cur_call.item = resolver.GetDebugID();
+	this->cur_call.cache_hits = (uint32)_newgrf_variable_cache_stats.hits;
+	this->cur_call.cache_misses = (uint32)_newgrf_variable_cache_stats.misses;
 }
 
 /**
@@ -61,6 +63,8 @@ void NewGRFProfiler::EndResolve(const SpriteGroup *result)
 {
 	using namespace std::chrono;
 	this->cur_call.time = (uint32)time_point_cast<microseconds>(high_resolution_clock::now()).time_since_epoch().count() - this->cur_call.time;
+	this->cur_call.cache_hits = (uint32)_newgrf_variable_cache_stats.hits - this->cur_call.cache_hits;
+	this->cur_call.cache_misses = (uint32)_newgrf_variable_cache_stats.misses - this->cur_call.cache_misses;
 
 	if (result == nullptr) {
 		this->cur_call.result = 0;
@@ -106,13 +110,19 @@ uint32 NewGRFProfiler::Finish()
 	FileCloser fcloser(f);
 
 	uint32 total_microseconds = 0;
+	uint64 total_cache_hits = 0;
+	uint64 total_cache_misses = 0;
 
-	fputs("Tick,Sprite,Feature,Item,CallbackID,Microseconds,Depth,Result\n", f);
+	fputs("Tick,Sprite,Feature,Item,CallbackID,Microseconds,Depth,Result,CacheHits,CacheMisses\n", f);
 	for (const Call &c : this->calls) {
-		fprintf(f, "%u,%u,0x%X,%u,0x%X,%u,%u,%u\n", c.tick, c.root_sprite, c.feat, c.item, (uint)c.cb, c.time, c.subs, c.result);
+		fprintf(f, "%u,%u,0x%X,%u,0x%X,%u,%u,%u,%u,%u\n", c.tick, c.root_sprite, c.feat, c.item, (uint)c.cb, c.time, c.subs, c.result, c.cache_hits, c.cache_misses);
 		total_microseconds += c.time;
+		total_cache_hits += c.cache_hits;
+		total_cache_misses += c.cache_misses;
 	}
 
+	IConsolePrint(CC_DEBUG, "Variable cache of NewGRF [{:08X}]: {} hits, {} misses.", BSWAP32(this->grffile->grfid), total_cache_hits, total_cache_misses);
+
 	this->Abort();
 
 	return total_microseconds;
@@ -45,6 +45,8 @@ struct NewGRFProfiler {
 		uint32 result;       ///< Result of callback
 		uint32 subs;         ///< Sub-calls to other sprite groups
 		uint32 time;         ///< Time taken for resolution (microseconds)
+		uint32 cache_hits;   ///< Scope variables read from the variable cache
+		uint32 cache_misses; ///< Scope variables that had to be evaluated
 		uint16 tick;         ///< Game tick
 		CallbackID cb;       ///< Callback ID
 		GrfSpecFeature feat; ///< GRF feature being resolved for
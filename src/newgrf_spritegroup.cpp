@@ -20,6 +20,78 @@ INSTANTIATE_POOL_METHODS(SpriteGroup)
 
 TemporaryStorageArray<int32, 0x110> _temp_store;
 
+NewGRFVariableCacheStats _newgrf_variable_cache_stats;
+
+/**
+ * Cache of the values of scope variables, valid while resolving a single
+ * top-level sprite group chain. Many chains read the same variables several
+ * times, and their evaluation can be expensive.
+ */
+struct NewGRFVariableCache {
+	static const uint SIZE = 64; ///< Number of entries; must be a power of 2.
+
+	/** A cached value of a variable. */
+	struct Entry {
+		const ScopeResolver *scope; ///< Scope the variable was read from.
+		uint32 generation;          ///< Generation of the cache the value is valid for.
+		uint32 parameter;           ///< Parameter of 60+x variables.
+		uint32 value;               ///< Value of the variable.
+		byte variable;              ///< Number of the variable.
+		bool available;             ///< Whether the variable exists.
+	};
+
+	Entry entries[SIZE] = {};
+	uint32 generation = 1; ///< Only entries of this generation are valid.
+
+	/** Invalidate all cached values. */
+	void Invalidate()
+	{
+		this->generation++;
+		if (this->generation == 0) {
+			/* Wrapped around; make sure no entry matches by accident. */
+			for (Entry &entry : this->entries) entry.generation = 0;
+			this->generation = 1;
+		}
+	}
+
+	/**
+	 * Get the value of a variable, from the cache if possible.
+	 * @param scope Scope to read the variable from.
+	 * @param variable Variable to read.
+	 * @param parameter Parameter for 60+x variables.
+	 * @param[out] available Set to false, in case the variable does not exist.
+	 * @return Value of the variable.
+	 */
+	uint32 GetVariable(ScopeResolver *scope, byte variable, uint32 parameter, bool *available)
+	{
+		uint hash = variable ^ (parameter * 31) ^ (uint)((size_t)scope >> 4);
+		Entry &entry = this->entries[hash & (SIZE - 1)];
+
+		if (entry.generation == this->generation && entry.scope == scope && entry.variable == variable && entry.parameter == parameter) {
+			_newgrf_variable_cache_stats.hits++;
+			*available = entry.available;
+			return entry.value;
+		}
+
+		_newgrf_variable_cache_stats.misses++;
+		uint32 value = scope->GetVariable(variable, parameter, available);
+		entry = { scope, this->generation, parameter, value, variable, *available };
+		return value;
+	}
+};
+
+static NewGRFVariableCache _newgrf_variable_cache;
+
+/**
+ * Forget all cached values of scope variables. Values are cached per scope,
+ * so this must be called whenever a scope is pointed at another object
+ * while resolving.
+ */
+void InvalidateNewGRFVariableCache()
+{
+	_newgrf_variable_cache.Invalidate();
+}
+
 
 /**
  * ResolverObject (re)entry point.
@@ -38,6 +110,8 @@ TemporaryStorageArray<int32, 0x110> _temp_store;
 	const GRFFile *grf = object.grffile;
 	auto profiler = std::find_if(_newgrf_profilers.begin(), _newgrf_profilers.end(), [&](const NewGRFProfiler &pr) { return pr.grffile == grf; });
 
+	if (top_level) _newgrf_variable_cache.Invalidate();
+
 	if (profiler == _newgrf_profilers.end() || !profiler->active) {
 		if (top_level) _temp_store.ClearChanges();
 		return group->Resolve(object);
@@ -74,6 +148,7 @@ static inline uint32 GetVariable(const ResolverObject &object, ScopeResolver *sc
 			/* First handle variables common with Action7/9/D */
 			if (variable < 0x40 && GetGlobalVariable(variable, &value, object.grffile)) return value;
 			/* Not a common variable, so evaluate the feature specific variables */
+			if (object.cache_variables) return _newgrf_variable_cache.GetVariable(scope, variable, parameter, available);
 			return scope->GetVariable(variable, parameter, available);
 	}
 }
@@ -141,10 +216,10 @@ static inline uint32 GetVariable(const ResolverObject &object, ScopeResolver *sc
 	return &this->default_scope;
 }
 
-/* Evaluate an adjustment for a variable of the given size.
- * U is the unsigned type and S is the signed type to use. */
-template <typename U, typename S>
-static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver *scope, U last_value, uint32 value)
+/* Apply the shift, mask, and division or modulo of an adjustment to a value.
+ * S is the signed type to use. */
+template <typename S>
+static uint32 AdjustValueT(const DeterministicSpriteGroupAdjust &adjust, uint32 value)
 {
 	value >>= adjust.shift_num;
 	value  &= adjust.and_mask;
@@ -155,6 +230,14 @@ static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver
 		case DSGA_TYPE_NONE: break;
 	}
 
+	return value;
+}
+
+/* Evaluate the operation of an adjustment for a variable of the given size.
+ * U is the unsigned type and S is the signed type to use. */
+template <typename U, typename S>
+static U EvalOperationT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver *scope, U last_value, uint32 value)
+{
 	switch (adjust.operation) {
 		case DSGA_OP_ADD:  return last_value + value;
 		case DSGA_OP_SUB:  return last_value - value;
@@ -172,7 +255,7 @@ static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver
 		case DSGA_OP_XOR:  return last_value ^ value;
 		case DSGA_OP_STO:  _temp_store.StoreValue((U)value, (S)last_value); return last_value;
 		case DSGA_OP_RST:  return value;
-		case DSGA_OP_STOP: scope->StorePSA((U)value, (S)last_value); return last_value;
+		case DSGA_OP_STOP: scope->StorePSA((U)value, (S)last_value); _newgrf_variable_cache.Invalidate(); return last_value;
 		case DSGA_OP_ROR:  return ROR<uint32>((U)last_value, (U)value & 0x1F); // mask 'value' to 5 bits, which should behave the same on all architectures.
 		case DSGA_OP_SCMP: return ((S)last_value == (S)value) ? 1 : ((S)last_value < (S)value ? 0 : 2);
 		case DSGA_OP_UCMP: return ((U)last_value == (U)value) ? 1 : ((U)last_value < (U)value ? 0 : 2);
@@ -183,13 +266,195 @@ static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver
 	}
 }
 
+/**
+ * Evaluate the operation of an adjustment.
+ * @param size Size of the values of the sprite group.
+ * @param adjust The adjustment.
+ * @param scope Scope to store persistent values into.
+ * @param last_value The last value.
+ * @param value The adjusted value of the variable.
+ * @return The new last value.
+ */
+static uint32 EvalOperation(DeterministicSpriteGroupSize size, const DeterministicSpriteGroupAdjust &adjust, ScopeResolver *scope, uint32 last_value, uint32 value)
+{
+	switch (size) {
+		case DSG_SIZE_BYTE:  return EvalOperationT<uint8,  int8> (adjust, scope, last_value, value);
+		case DSG_SIZE_WORD:  return EvalOperationT<uint16, int16>(adjust, scope, last_value, value);
+		case DSG_SIZE_DWORD: return EvalOperationT<uint32, int32>(adjust, scope, last_value, value);
+		default: NOT_REACHED();
+	}
+}
+
+/**
+ * Apply the shift, mask, and division or modulo of an adjustment.
+ * @param size Size of the values of the sprite group.
+ * @param adjust The adjustment.
+ * @param value The value of the variable.
+ * @return The adjusted value.
+ */
+static uint32 AdjustValue(DeterministicSpriteGroupSize size, const DeterministicSpriteGroupAdjust &adjust, uint32 value)
+{
+	switch (size) {
+		case DSG_SIZE_BYTE:  return AdjustValueT<int8> (adjust, value);
+		case DSG_SIZE_WORD:  return AdjustValueT<int16>(adjust, value);
+		case DSG_SIZE_DWORD: return AdjustValueT<int32>(adjust, value);
+		default: NOT_REACHED();
+	}
+}
+
 
 static bool RangeHighComparator(const DeterministicSpriteGroupRange& range, uint32 value)
 {
 	return range.high < value;
 }
 
-const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) const
+/** Largest number of values the ranges of a deterministic sprite group may span to be looked up in a table. */
+static const uint MAX_DETERMINISTIC_SPRITE_GROUP_TABLE_SIZE = 256;
+/** Debug level of 'grf' from which compiled deterministic sprite groups are verified against their adjusts. */
+static const int VERIFY_DETERMINISTIC_SPRITE_GROUP_DEBUG_LEVEL = 8;
+
+/**
+ * Check whether resolving a sprite group may store into persistent storage,
+ * either by its own adjusts or by those of the groups it resolves further.
+ * @param group The sprite group, which has been compiled already.
+ * @return True iff the group or one of the groups it may resolve stores into persistent storage.
+ */
+static bool MayStorePersistent(const SpriteGroup *group)
+{
+	if (group == nullptr) return false;
+
+	switch (group->type) {
+		case SGT_DETERMINISTIC:
+			return static_cast<const DeterministicSpriteGroup *>(group)->chain_stores_persistent;
+
+		case SGT_RANDOMIZED: {
+			const RandomizedSpriteGroup *random = static_cast<const RandomizedSpriteGroup *>(group);
+			return std::any_of(random->groups.begin(), random->groups.end(), MayStorePersistent);
+		}
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * Compile the adjusts and ranges into a form that is faster to evaluate.
+ * Leading adjusts that do not depend on the game state are evaluated now,
+ * constant values of the other adjusts are computed in advance, and the
+ * ranges are turned into a table when they span only a few values. When all
+ * adjusts could be evaluated, the table only contains the selected group.
+ */
+void DeterministicSpriteGroup::Compile()
+{
+	this->initial_value = 0;
+	this->program.clear();
+	this->table.clear();
+	this->stores_persistent = false;
+	this->chain_stores_persistent = false;
+
+	for (const DeterministicSpriteGroupAdjust &adjust : this->adjusts) {
+		DeterministicSpriteGroupInstruction instruction;
+		static_cast<DeterministicSpriteGroupAdjust &>(instruction) = adjust;
+		instruction.value = 0;
+
+		if (adjust.operation == DSGA_OP_STOP) this->stores_persistent = true;
+		if (adjust.variable == 0x7E && MayStorePersistent(adjust.subroutine)) this->stores_persistent = true;
+
+		if (adjust.variable == 0x7E) {
+			instruction.source = DSGVS_SUBROUTINE;
+		} else if (adjust.variable == 0x7B) {
+			instruction.source = DSGVS_INDIRECT;
+		} else if (adjust.variable == 0x1A && (adjust.type == DSGA_TYPE_NONE || adjust.divmod_val != 0)) {
+			/* Variable 1A is always -1, so its adjusted value is known. */
+			instruction.source = DSGVS_CONSTANT;
+			instruction.value = AdjustValue(this->size, adjust, UINT32_MAX);
+			instruction.type = DSGA_TYPE_NONE;
+			instruction.shift_num = 0;
+			instruction.and_mask = UINT32_MAX;
+		} else {
+			instruction.source = DSGVS_VARIABLE;
+		}
+
+		/* Fold constants into the initial value, unless they have side effects. */
+		if (this->program.empty() && instruction.source == DSGVS_CONSTANT && adjust.operation != DSGA_OP_STO && adjust.operation != DSGA_OP_STOP) {
+			this->initial_value = EvalOperation(this->size, instruction, nullptr, this->initial_value, instruction.value);
+			continue;
+		}
+
+		this->program.push_back(instruction);
+	}
+
+	/* Groups are only referenced after they are defined, so the groups this one selects have been compiled already. */
+	this->chain_stores_persistent = this->stores_persistent || MayStorePersistent(this->default_group) ||
+			std::any_of(this->ranges.begin(), this->ranges.end(), [](const DeterministicSpriteGroupRange &range) { return MayStorePersistent(range.group); });
+
+	if (this->calculated_result) return;
+
+	if (this->program.empty()) {
+		/* The value is always the same, so only one branch can be taken. */
+		this->table_base = this->initial_value;
+		this->table.push_back(this->SelectRange(this->initial_value));
+	} else if (!this->ranges.empty() && this->ranges.back().high - this->ranges.front().low < MAX_DETERMINISTIC_SPRITE_GROUP_TABLE_SIZE) {
+		this->table_base = this->ranges.front().low;
+		uint span = this->ranges.back().high - this->ranges.front().low;
+		for (uint i = 0; i <= span; i++) {
+			this->table.push_back(this->SelectRange(this->table_base + i));
+		}
+	}
+}
+
+/**
+ * Evaluate the compiled adjusts.
+ * @param object The resolver object.
+ * @param[out] available Set to false, in case a variable does not exist.
+ * @return The resulting value.
+ */
+uint32 DeterministicSpriteGroup::Evaluate(ResolverObject &object, bool *available) const
+{
+	uint32 last_value = this->initial_value;
+	if (this->program.empty()) return last_value;
+
+	ScopeResolver *scope = object.GetScope(this->var_scope);
+
+	for (const DeterministicSpriteGroupInstruction &instruction : this->program) {
+		uint32 value;
+		switch (instruction.source) {
+			case DSGVS_CONSTANT:
+				last_value = EvalOperation(this->size, instruction, scope, last_value, instruction.value);
+				continue;
+
+			case DSGVS_SUBROUTINE: {
+				const SpriteGroup *subgroup = SpriteGroup::Resolve(instruction.subroutine, object, false);
+				value = subgroup == nullptr ? CALLBACK_FAILED : subgroup->GetCallbackResult();
+				break;
+			}
+
+			case DSGVS_INDIRECT:
+				value = GetVariable(object, scope, instruction.parameter, last_value, available);
+				break;
+
+			case DSGVS_VARIABLE:
+				value = GetVariable(object, scope, instruction.variable, instruction.parameter, available);
+				break;
+
+			default: NOT_REACHED();
+		}
+
+		if (!*available) return 0;
+
+		last_value = EvalOperation(this->size, instruction, scope, last_value, AdjustValue(this->size, instruction, value));
+	}
+
+	return last_value;
+}
+
+/**
+ * Evaluate the adjusts as they are in the NewGRF, without compiling them.
+ * @param object The resolver object.
+ * @param[out] available Set to false, in case a variable does not exist.
+ * @return The resulting value.
+ */
+uint32 DeterministicSpriteGroup::EvaluateAdjusts(ResolverObject &object, bool *available) const
 {
 	uint32 last_value = 0;
 	uint32 value = 0;
@@ -197,8 +462,6 @@ const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) con
 	ScopeResolver *scope = object.GetScope(this->var_scope);
 
 	for (const auto &adjust : this->adjusts) {
-		/* Try to get the variable. We shall assume it is available, unless told otherwise. */
-		bool available = true;
 		if (adjust.variable == 0x7E) {
 			const SpriteGroup *subgroup = SpriteGroup::Resolve(adjust.subroutine, object, false);
 			if (subgroup == nullptr) {
@@ -209,51 +472,116 @@ const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) con
 
 			/* Note: 'last_value' and 'reseed' are shared between the main chain and the procedure */
 		} else if (adjust.variable == 0x7B) {
-			value = GetVariable(object, scope, adjust.parameter, last_value, &available);
+			value = GetVariable(object, scope, adjust.parameter, last_value, available);
 		} else {
-			value = GetVariable(object, scope, adjust.variable, adjust.parameter, &available);
+			value = GetVariable(object, scope, adjust.variable, adjust.parameter, available);
 		}
 
-		if (!available) {
-			/* Unsupported variable: skip further processing and return either
-			 * the group from the first range or the default group. */
-			return SpriteGroup::Resolve(this->error_group, object, false);
-		}
+		if (!*available) return 0;
 
-		switch (this->size) {
-			case DSG_SIZE_BYTE:  value = EvalAdjustT<uint8,  int8> (adjust, scope, last_value, value); break;
-			case DSG_SIZE_WORD:  value = EvalAdjustT<uint16, int16>(adjust, scope, last_value, value); break;
-			case DSG_SIZE_DWORD: value = EvalAdjustT<uint32, int32>(adjust, scope, last_value, value); break;
-			default: NOT_REACHED();
-		}
+		value = EvalOperation(this->size, adjust, scope, last_value, AdjustValue(this->size, adjust, value));
 		last_value = value;
 	}
 
-	object.last_value = last_value;
-
-	if (this->calculated_result) {
-		/* nvar == 0 is a special case -- we turn our value into a callback result */
-		if (value != CALLBACK_FAILED) value = GB(value, 0, 15);
-		static CallbackResultSpriteGroup nvarzero(0, true);
-		nvarzero.result = value;
-		return &nvarzero;
-	}
+	return value;
+}
 
+/**
+ * Get the group of the range containing a value, or the default group.
+ * @param value The value.
+ * @return The group to resolve next.
+ */
+const SpriteGroup *DeterministicSpriteGroup::SelectRange(uint32 value) const
+{
 	if (this->ranges.size() > 4) {
 		const auto &lower = std::lower_bound(this->ranges.begin(), this->ranges.end(), value, RangeHighComparator);
 		if (lower != this->ranges.end() && lower->low <= value) {
 			assert(lower->low <= value && value <= lower->high);
-			return SpriteGroup::Resolve(lower->group, object, false);
+			return lower->group;
 		}
 	} else {
 		for (const auto &range : this->ranges) {
 			if (range.low <= value && value <= range.high) {
-				return SpriteGroup::Resolve(range.group, object, false);
+				return range.group;
 			}
 		}
 	}
 
-	return SpriteGroup::Resolve(this->default_group, object, false);
+	return this->default_group;
+}
+
+/**
+ * Get the group to resolve next for a value, using the table if there is one.
+ * @param value The value.
+ * @return The group to resolve next.
+ */
+const SpriteGroup *DeterministicSpriteGroup::SelectGroup(uint32 value) const
+{
+	if (this->table.empty()) return this->SelectRange(value);
+
+	uint32 index = value - this->table_base;
+	return index < this->table.size() ? this->table[index] : this->default_group;
+}
+
+/**
+ * Evaluate both the compiled and the original adjusts, and report when
+ * they lead to a different result. The temporary storage and last value
+ * are restored in between, but other side effects happen twice.
+ * @param object The resolver object.
+ * @param[out] available Set to false, in case a variable does not exist.
+ * @return The resulting value of the compiled adjusts.
+ */
+uint32 DeterministicSpriteGroup::Verify(ResolverObject &object, bool *available) const
+{
+	const TemporaryStorageArray<int32, 0x110> temp_store = _temp_store;
+	const uint32 last_value = object.last_value;
+
+	bool expected_available = true;
+	uint32 expected = this->EvaluateAdjusts(object, &expected_available);
+
+	_temp_store = temp_store;
+	object.last_value = last_value;
+
+	uint32 value = this->Evaluate(object, available);
+
+	bool same = *available == expected_available;
+	if (same && *available) same = value == expected && (this->calculated_result || this->SelectGroup(value) == this->SelectRange(expected));
+	if (!same) {
+		Debug(grf, 0, "Compiled deterministic sprite group at line {} of NewGRF [{:08X}] gave a different result: {:X} instead of {:X}",
+				this->nfo_line, object.grffile == nullptr ? 0 : BSWAP32(object.grffile->grfid), value, expected);
+	}
+
+	return value;
+}
+
+const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) const
+{
+	/* Try to get the variables. We shall assume they are available, unless told otherwise. */
+	bool available = true;
+	uint32 value;
+	if (_debug_grf_level >= VERIFY_DETERMINISTIC_SPRITE_GROUP_DEBUG_LEVEL && !this->stores_persistent) {
+		value = this->Verify(object, &available);
+	} else {
+		value = this->Evaluate(object, &available);
+	}
+
+	if (!available) {
+		/* Unsupported variable: skip further processing and return either
+		 * the group from the first range or the default group. */
+		return SpriteGroup::Resolve(this->error_group, object, false);
+	}
+
+	object.last_value = value;
+
+	if (this->calculated_result) {
+		/* nvar == 0 is a special case -- we turn our value into a callback result */
+		if (value != CALLBACK_FAILED) value = GB(value, 0, 15);
+		static CallbackResultSpriteGroup nvarzero(0, true);
+		nvarzero.result = value;
+		return &nvarzero;
+	}
+
+	return SpriteGroup::Resolve(this->SelectGroup(value), object, false);
 }
 
 
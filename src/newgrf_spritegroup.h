@@ -53,6 +53,16 @@ struct ResolverObject;
 typedef Pool<SpriteGroup, SpriteGroupID, 1024, 1 << 30, PT_DATA> SpriteGroupPool;
 extern SpriteGroupPool _spritegroup_pool;
 
+/** Statistics about the cache of scope variables of resolver objects. */
+struct NewGRFVariableCacheStats {
+	uint64 hits;   ///< Number of variables that were read from the cache.
+	uint64 misses; ///< Number of variables that had to be evaluated.
+};
+
+extern NewGRFVariableCacheStats _newgrf_variable_cache_stats;
+
+void InvalidateNewGRFVariableCache();
+
 /* Common wrapper for all the different sprite group types */
 struct SpriteGroup : SpriteGroupPool::PoolItem<&_spritegroup_pool> {
 protected:
@@ -163,6 +173,20 @@ struct DeterministicSpriteGroupRange {
 	uint32 high;
 };
 
+/** Where an instruction of a compiled deterministic sprite group gets its value from. */
+enum DeterministicSpriteGroupValueSource : byte {
+	DSGVS_VARIABLE,   ///< Read the variable.
+	DSGVS_INDIRECT,   ///< Read the variable given by the parameter, with the last value as its parameter (variable 7B).
+	DSGVS_SUBROUTINE, ///< Resolve the subroutine (variable 7E).
+	DSGVS_CONSTANT,   ///< Use the constant value, the shift, mask, and division or modulo are already applied.
+};
+
+/** Instruction of a compiled deterministic sprite group. */
+struct DeterministicSpriteGroupInstruction : DeterministicSpriteGroupAdjust {
+	DeterministicSpriteGroupValueSource source; ///< Where the value comes from.
+	uint32 value;                               ///< The value for #DSGVS_CONSTANT.
+};
+
 
 struct DeterministicSpriteGroup : SpriteGroup {
 	DeterministicSpriteGroup() : SpriteGroup(SGT_DETERMINISTIC) {}
@@ -178,8 +202,25 @@ struct DeterministicSpriteGroup : SpriteGroup {
 
 	const SpriteGroup *error_group; // was first range, before sorting ranges
 
+	/* Compiled form of the adjusts and ranges, see #Compile. */
+	uint32 initial_value;                                     ///< Value of the leading adjusts, that could be evaluated when compiling.
+	std::vector<DeterministicSpriteGroupInstruction> program; ///< The remaining adjusts.
+	uint32 table_base;                                        ///< Value of the first entry in #table.
+	std::vector<const SpriteGroup *> table;                   ///< Group for each value from #table_base, when the ranges span only a few values.
+	bool stores_persistent;                                   ///< Whether the adjusts, including their subroutines, may store into persistent storage.
+	bool chain_stores_persistent;                             ///< Whether resolving this group, including the groups it selects, may store into persistent storage.
+
+	void Compile();
+
 protected:
 	const SpriteGroup *Resolve(ResolverObject &object) const;
+
+private:
+	uint32 Evaluate(ResolverObject &object, bool *available) const;
+	uint32 EvaluateAdjusts(ResolverObject &object, bool *available) const;
+	const SpriteGroup *SelectGroup(uint32 value) const;
+	const SpriteGroup *SelectRange(uint32 value) const;
+	uint32 Verify(ResolverObject &object, bool *available) const;
 };
 
 enum RandomizedSpriteGroupCompareMode {
@@ -313,7 +354,7 @@ struct ResolverObject {
 	 * @param callback_param2 Second parameter (var 18) of the callback (only used when \a callback is also set).
 	 */
 	ResolverObject(const GRFFile *grffile, CallbackID callback = CBID_NO_CALLBACK, uint32 callback_param1 = 0, uint32 callback_param2 = 0)
-		: default_scope(*this), callback(callback), callback_param1(callback_param1), callback_param2(callback_param2), grffile(grffile), root_spritegroup(nullptr)
+		: default_scope(*this), callback(callback), callback_param1(callback_param1), callback_param2(callback_param2), grffile(grffile), root_spritegroup(nullptr), cache_variables(false)
 	{
 		this->ResetState();
 	}
@@ -335,6 +376,13 @@ struct ResolverObject {
 	const GRFFile *grffile;     ///< GRFFile the resolved SpriteGroup belongs to
 	const SpriteGroup *root_spritegroup; ///< Root SpriteGroup to use for resolving
 
+	/**
+	 * Whether the values of scope variables may be cached while resolving a
+	 * sprite group chain. Only to be enabled for resolvers whose scopes keep
+	 * referring to the same objects during the resolving of a chain.
+	 */
+	bool cache_variables;
+
 	/**
 	 * Resolve SpriteGroup.
 	 * @return Result spritegroup.
@@ -563,6 +563,7 @@ StationResolverObject::StationResolverObject(const StationSpec *statspec, BaseSt
 {
 	/* Invalidate all cached vars */
 	_svc.valid = 0;
+	this->cache_variables = true;
 
 	CargoID ctype = CT_DEFAULT_NA;
 
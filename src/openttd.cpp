@@ -63,6 +63,7 @@
 #include "gfx_layout.h"
 #include "viewport_func.h"
 #include "viewport_sprite_sorter.h"
+#include "spritecache.h"
 #include "framerate_type.h"
 #include "industry.h"
 
@@ -1141,6 +1142,10 @@ static void CheckCaches()
 		i++;
 	}
 
+	if (!IsTownGrowthScheduleValid()) {
+		Debug(desync, 2, "town growth schedule mismatch");
+	}
+
 	/* Check company infrastructure cache. */
 	std::vector<CompanyInfrastructure> old_infrastructure;
 	for (const Company *c : Company::Iterate()) old_infrastructure.push_back(c->infrastructure);
@@ -1431,6 +1436,9 @@ void GameLoop()
 
 	ProcessAsyncSaveFinish();
 
+	/* No sprites are being drawn here, so the sprite cache can safely be moved around. */
+	CompactSpriteCacheIfFragmented();
+
 	/* autosave game? */
 	if (_do_autosave) {
 		DoAutosave();
@@ -1444,8 +1452,6 @@ void GameLoop()
 		_switch_mode = SM_NONE;
 	}
 
-	IncreaseSpriteLRU();
-
 	/* Check for UDP stuff */
 	if (_network_available) NetworkBackgroundLoop();
 
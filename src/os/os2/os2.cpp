@@ -169,16 +169,6 @@ void ShowOSErrorBox(const char *buf, bool system)
 	WinTerminate(hab);
 }
 
-int CDECL main(int argc, char *argv[])
-{
-	SetRandomSeed(time(nullptr));
-
-	/* Make sure our arguments contain only valid UTF-8 characters. */
-	for (int i = 0; i < argc; i++) StrMakeValidInPlace(argv[i]);
-
-	return openttd_main(argc, argv);
-}
-
 bool GetClipboardContents(char *buffer, const char *last)
 {
 /* XXX -- Currently no clipboard support implemented with GCC */
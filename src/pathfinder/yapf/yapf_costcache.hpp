@@ -11,6 +11,8 @@
 #define YAPF_COSTCACHE_HPP
 
 #include "../../date_func.h"
+#include "../../tilearea_type.h"
+#include "../../core/smallvec_type.hpp"
 
 /**
  * CYapfSegmentCostCacheNoneT - the formal only yapf cost cache provider that implements
@@ -95,15 +97,39 @@ public:
  *  of track layout changes and static notification function called whenever
  *  the track layout changes. It is implemented as base class because it needs
  *  to be shared between all rail YAPF types (one shared counter, one notification
- *  function.
+ *  function. Changes of a single tile are forwarded to every cache, so only the
+ *  segments around that tile are invalidated; the counter is used to flush
+ *  every cache at once.
  */
 struct CSegmentCostCacheBase
 {
 	static int   s_rail_change_counter;
+	static std::vector<CSegmentCostCacheBase *> s_caches; ///< All existing caches, to forward tile changes to.
+
+	CSegmentCostCacheBase()
+	{
+		s_caches.push_back(this);
+	}
+
+	virtual ~CSegmentCostCacheBase()
+	{
+		s_caches.erase(std::find(s_caches.begin(), s_caches.end(), this));
+	}
+
+	/**
+	 * Invalidate the cached segments that may be affected by a change of the given tile.
+	 * @param tile The tile that changed.
+	 */
+	virtual void InvalidateTile(TileIndex tile) = 0;
 
 	static void NotifyTrackLayoutChange(TileIndex tile, Track track)
 	{
-		s_rail_change_counter++;
+		if (tile == INVALID_TILE) {
+			s_rail_change_counter++;
+			return;
+		}
+
+		for (CSegmentCostCacheBase *cache : s_caches) cache->InvalidateTile(tile);
 	}
 };
 
@@ -117,25 +143,44 @@ struct CSegmentCostCacheBase
  *  of the segment (origin tile and exit-dir from this tile).
  *  Different CYapfCachedCostT types can share the same type of CSegmentCostCacheT.
  *  Look at CYapfRailSegment (yapf_node_rail.hpp) for the segment example
+ *
+ *  The calculated segments are indexed by the regions of the map their tiles
+ *  are in. A change of a tile then only resets the segments that pass it, or
+ *  end right next to it, so they are calculated again the next time they are
+ *  needed. All other segments keep their cached costs.
  */
 template <class Tsegment>
 struct CSegmentCostCacheT : public CSegmentCostCacheBase {
 	static const int C_HASH_BITS = 14;
+	static const uint C_REGION_BITS = 4; ///< Segments are indexed by regions of 2^C_REGION_BITS by 2^C_REGION_BITS tiles.
 
 	typedef CHashTableT<Tsegment, C_HASH_BITS> HashTable;
 	typedef SmallArray<Tsegment> Heap;
 	typedef typename Tsegment::Key Key;    ///< key to hash table
+	typedef std::vector<Tsegment *> SegmentList;
 
 	HashTable    m_map;
 	Heap         m_heap;
+	std::vector<SegmentList> m_regions; ///< Calculated segments per region of the map, allocated on first use.
+	SegmentList  m_unindexed;           ///< Segments that may have been calculated since they were last indexed.
+	int          m_last_change_counter; ///< Value of the global change counter when the cache was last flushed.
 
-	inline CSegmentCostCacheT() {}
+	inline CSegmentCostCacheT() : m_last_change_counter(s_rail_change_counter) {}
 
 	/** flush (clear) the cache */
 	inline void Flush()
 	{
 		m_map.Clear();
 		m_heap.Clear();
+		m_regions.clear();
+		m_unindexed.clear();
+		m_last_change_counter = s_rail_change_counter;
+	}
+
+	/** Flush the cache if the whole track layout has been invalidated since the last flush. */
+	inline void FlushIfLayoutChanged()
+	{
+		if (m_last_change_counter != s_rail_change_counter) Flush();
 	}
 
 	inline Tsegment& Get(Key &key, bool *found)
@@ -148,8 +193,78 @@ struct CSegmentCostCacheT : public CSegmentCostCacheBase {
 		} else {
 			*found = true;
 		}
+		/* Segments without cost are about to be calculated, so they need to be indexed afterwards. */
+		if (item->m_cost < 0) m_unindexed.push_back(item);
 		return *item;
 	}
+
+	/** Add the segments calculated since the last call to the regions covered by their tiles. */
+	void IndexSegments()
+	{
+		if (m_unindexed.empty()) return;
+
+		uint regions_x = MapSizeX() >> C_REGION_BITS;
+		if (m_regions.empty()) m_regions.resize(regions_x * (MapSizeY() >> C_REGION_BITS));
+
+		/* Segments can be queued more than once and may still be listed in a region
+		 * from an earlier calculation, so append them and deduplicate the touched
+		 * regions once afterwards instead of searching the list for every segment. */
+		std::vector<uint> touched;
+		for (Tsegment *segment : m_unindexed) {
+			if (segment->m_cost < 0) continue;
+
+			/* A segment also depends on the tiles right next to it, e.g. for its end. */
+			const TileArea &area = segment->m_area;
+			uint x0 = std::max<int>(TileX(area.tile) - 1, 0) >> C_REGION_BITS;
+			uint y0 = std::max<int>(TileY(area.tile) - 1, 0) >> C_REGION_BITS;
+			uint x1 = std::min<uint>(TileX(area.tile) + area.w, MapMaxX()) >> C_REGION_BITS;
+			uint y1 = std::min<uint>(TileY(area.tile) + area.h, MapMaxY()) >> C_REGION_BITS;
+			for (uint y = y0; y <= y1; y++) {
+				for (uint x = x0; x <= x1; x++) {
+					SegmentList &list = m_regions[y * regions_x + x];
+					if (list.empty() || list.back() != segment) list.push_back(segment);
+					touched.push_back(y * regions_x + x);
+				}
+			}
+		}
+		m_unindexed.clear();
+
+		std::sort(touched.begin(), touched.end());
+		touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+		for (uint region : touched) {
+			SegmentList &list = m_regions[region];
+			std::sort(list.begin(), list.end());
+			list.erase(std::unique(list.begin(), list.end()), list.end());
+		}
+	}
+
+	void InvalidateTile(TileIndex tile) override
+	{
+		if (m_last_change_counter != s_rail_change_counter) {
+			/* Everything will be flushed anyway. */
+			Flush();
+			return;
+		}
+
+		IndexSegments();
+		if (m_regions.empty()) return;
+
+		uint x = TileX(tile);
+		uint y = TileY(tile);
+		SegmentList &list = m_regions[(y >> C_REGION_BITS) * (MapSizeX() >> C_REGION_BITS) + (x >> C_REGION_BITS)];
+		auto last = std::remove_if(list.begin(), list.end(), [x, y](Tsegment *segment) {
+			/* The segment has been reset since it was added, it will be added again once calculated. */
+			if (segment->m_cost < 0) return true;
+
+			const TileArea &area = segment->m_area;
+			if (x + 1 < TileX(area.tile) || x > TileX(area.tile) + area.w) return false;
+			if (y + 1 < TileY(area.tile) || y > TileY(area.tile) + area.h) return false;
+
+			segment->Reset();
+			return true;
+		});
+		list.erase(last, list.end());
+	}
 };
 
 /**
@@ -181,14 +296,12 @@ protected:
 
 	inline static Cache& stGetGlobalCache()
 	{
-		static int last_rail_change_counter = 0;
 		static Cache C;
 
-		/* delete the cache sometimes... */
-		if (last_rail_change_counter != Cache::s_rail_change_counter) {
-			last_rail_change_counter = Cache::s_rail_change_counter;
-			C.Flush();
-		}
+		/* delete the cache when the whole layout has changed... */
+		C.FlushIfLayoutChanged();
+		/* ... otherwise make sure the segments calculated last time are invalidated by changes to their tiles. */
+		C.IndexSegments();
 		return C;
 	}
 
@@ -69,6 +69,7 @@ struct CYapfRailSegment
 	TileIndex              m_last_signal_tile;
 	Trackdir               m_last_signal_td;
 	EndSegmentReasonBits   m_end_segment_reason;
+	TileArea               m_area;       ///< Area covering all tiles of the segment.
 	CYapfRailSegment      *m_hash_next;
 
 	inline CYapfRailSegment(const CYapfRailSegmentKey &key)
@@ -82,6 +83,18 @@ struct CYapfRailSegment
 		, m_hash_next(nullptr)
 	{}
 
+	/** Forget the calculated segment data, so it gets calculated again the next time it is used. */
+	inline void Reset()
+	{
+		m_last_tile = INVALID_TILE;
+		m_last_td = INVALID_TRACKDIR;
+		m_cost = -1;
+		m_last_signal_tile = INVALID_TILE;
+		m_last_signal_td = INVALID_TRACKDIR;
+		m_end_segment_reason = ESRB_NONE;
+		m_area.Clear();
+	}
+
 	inline const Key& GetKey() const
 	{
 		return m_key;
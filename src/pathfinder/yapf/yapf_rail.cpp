@@ -56,6 +56,7 @@ private:
 	TileIndex m_res_fail_tile;    ///< The tile where the reservation failed
 	Trackdir  m_res_fail_td;      ///< The trackdir where the reservation failed
 	TileIndex m_origin_tile;      ///< Tile our reservation will originate from
+	std::vector<TileIndex> m_res_tiles; ///< Tiles of the reserved path, to invalidate the cached segments of
 
 	bool FindSafePositionProc(TileIndex tile, Trackdir td)
 	{
@@ -122,6 +123,13 @@ private:
 		return (tile != m_res_dest || td != m_res_dest_td) && (tile != m_res_fail_tile || td != m_res_fail_td);
 	}
 
+	/** Collect a single reserved track, to invalidate the cached segments passing it. */
+	bool CollectSingleTrack(TileIndex tile, Trackdir td)
+	{
+		m_res_tiles.push_back(tile);
+		return true;
+	}
+
 public:
 	/** Set the target to where the reservation should be extended. */
 	inline void SetReservationTarget(Node *node, TileIndex tile, Trackdir td)
@@ -178,7 +186,13 @@ public:
 		if (target != nullptr) target->okay = true;
 
 		if (Yapf().CanUseGlobalCache(*m_res_node)) {
-			YapfNotifyTrackLayoutChange(INVALID_TILE, INVALID_TRACK);
+			/* The cached segments along the reserved path are no longer valid. Collect the tiles
+			 * first, as invalidating the segments also invalidates the nodes that refer to them. */
+			m_res_tiles.clear();
+			for (Node *node = m_res_node; node->m_parent != nullptr; node = node->m_parent) {
+				node->IterateTiles(Yapf().GetVehicle(), Yapf(), *this, &CYapfReserveTrack<Types>::CollectSingleTrack);
+			}
+			for (TileIndex tile : m_res_tiles) YapfNotifyTrackLayoutChange(tile, INVALID_TRACK);
 		}
 
 		return true;
@@ -634,8 +648,10 @@ bool YapfTrainFindNearestSafeTile(const Train *v, TileIndex tile, Trackdir td, b
 	return pfnFindNearestSafeTile(v, tile, td, override_railtype);
 }
 
-/** if any track changes, this counter is incremented - that will invalidate segment cost cache */
+/** if the whole track layout changes, this counter is incremented - that will flush the segment cost caches */
 int CSegmentCostCacheBase::s_rail_change_counter = 0;
+/** all segment cost caches, they are notified about changes to single tiles */
+std::vector<CSegmentCostCacheBase *> CSegmentCostCacheBase::s_caches;
 
 void YapfNotifyTrackLayoutChange(TileIndex tile, Track track)
 {
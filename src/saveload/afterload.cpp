@@ -558,10 +558,13 @@ bool AfterLoadGame()
 	GamelogTestMode();
 
 	RebuildTownKdtree();
+	RebuildTownGrowthSchedule();
 	RebuildStationKdtree();
 	/* This needs to be done even before conversion, because some conversions will destroy objects
 	 * that otherwise won't exist in the tree. */
 	RebuildViewportKdtree();
+	/* The vehicle tile hash is sized by the map, which may differ from the one it was last reset for. */
+	ResetVehicleHash();
 
 	if (IsSavegameVersionBefore(SLV_98)) GamelogGRFAddList(_grfconfig);
 
@@ -2194,21 +2197,11 @@ bool AfterLoadGame()
 
 		extern std::vector<TileIndex> _animated_tiles;
 
-		for (auto tile = _animated_tiles.begin(); tile < _animated_tiles.end(); /* Nothing */) {
-			/* Remove if tile is not animated */
-			bool remove = _tile_type_procs[GetTileType(*tile)]->animate_tile_proc == nullptr;
-
-			/* and remove if duplicate */
-			for (auto j = _animated_tiles.begin(); !remove && j < tile; j++) {
-				remove = *tile == *j;
-			}
-
-			if (remove) {
-				tile = _animated_tiles.erase(tile);
-			} else {
-				tile++;
-			}
-		}
+		/* Remove if tile is not animated; duplicates are removed by RebuildAnimatedTiles. */
+		_animated_tiles.erase(std::remove_if(_animated_tiles.begin(), _animated_tiles.end(), [](TileIndex tile) {
+			return _tile_type_procs[GetTileType(tile)]->animate_tile_proc == nullptr;
+		}), _animated_tiles.end());
+		RebuildAnimatedTiles();
 	}
 
 	if (IsSavegameVersionBefore(SLV_124) && !IsSavegameVersionBefore(SLV_1)) {
@@ -3168,6 +3161,10 @@ bool AfterLoadGame()
 	ResetSignalHandlers();
 
 	AfterLoadLinkGraphs();
+
+	/* Grow counters might have been converted above. */
+	RebuildTownGrowthSchedule();
+	RebuildIndustryTickSchedule();
 	return true;
 }
 
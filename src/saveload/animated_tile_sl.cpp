@@ -13,6 +13,7 @@
 #include "compat/animated_tile_sl_compat.h"
 
 #include "../tile_type.h"
+#include "../animated_tile_func.h"
 #include "../core/alloc_func.hpp"
 #include "../core/smallvec_type.hpp"
 
@@ -30,12 +31,19 @@ struct ANITChunkHandler : ChunkHandler {
 	void Save() const override
 	{
 		SlTableHeader(_animated_tile_desc);
+		RebuildAnimatedTiles();
 
 		SlSetArrayIndex(0);
 		SlGlobList(_animated_tile_desc);
 	}
 
 	void Load() const override
+	{
+		this->LoadTiles();
+		RebuildAnimatedTiles();
+	}
+
+	void LoadTiles() const
 	{
 		/* Before version 80 we did NOT have a variable length animated tile table */
 		if (IsSavegameVersionBefore(SLV_80)) {
@@ -80,6 +80,7 @@ struct INDYChunkHandler : ChunkHandler {
 	void Save() const override
 	{
 		SlTableHeader(_industry_desc);
+		UpdateIndustryCounters();
 
 		/* Write the industries */
 		for (Industry *ind : Industry::Iterate()) {
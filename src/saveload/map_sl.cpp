@@ -67,207 +67,187 @@ struct MAPSChunkHandler : ChunkHandler {
 
 static const uint MAP_SL_BUF_SIZE = 4096;
 
+/**
+ * Load a plane of the map, i.e. a single member of all tiles.
+ * @tparam T Type of the member.
+ * @param conv VarType of the member in the savegame.
+ * @param member Function returning a reference to the member of the given tile.
+ */
+template <typename T, typename Tmember>
+static void LoadMapPlane(VarType conv, Tmember member)
+{
+	TileIndex size = MapSize();
+
+#ifdef WITH_MAP_PLANES
+	/* The plane is contiguous in memory, so load it in one go. */
+	SlCopy(&member(0), size, conv);
+#else
+	/* The member is spread over the tiles; scatter it from the buffer in a
+	 * loop the compiler can turn into a strided copy. */
+	std::array<T, MAP_SL_BUF_SIZE> buf;
+
+	for (TileIndex i = 0; i != size; i += MAP_SL_BUF_SIZE) {
+		SlCopy(buf.data(), MAP_SL_BUF_SIZE, conv);
+		for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) member(i + j) = buf[j];
+	}
+#endif /* WITH_MAP_PLANES */
+}
+
+/**
+ * Save a plane of the map, i.e. a single member of all tiles.
+ * @tparam T Type of the member.
+ * @param conv VarType of the member in the savegame.
+ * @param member Function returning a reference to the member of the given tile.
+ */
+template <typename T, typename Tmember>
+static void SaveMapPlane(VarType conv, Tmember member)
+{
+	TileIndex size = MapSize();
+
+	SlSetLength(size * sizeof(T));
+
+#ifdef WITH_MAP_PLANES
+	/* The plane is contiguous in memory, so save it in one go. */
+	SlCopy(&member(0), size, conv);
+#else
+	/* The member is spread over the tiles; gather it into the buffer in a
+	 * loop the compiler can turn into a strided copy. */
+	std::array<T, MAP_SL_BUF_SIZE> buf;
+
+	for (TileIndex i = 0; i != size; i += MAP_SL_BUF_SIZE) {
+		for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = member(i + j);
+		SlCopy(buf.data(), MAP_SL_BUF_SIZE, conv);
+	}
+#endif /* WITH_MAP_PLANES */
+}
+
 struct MAPTChunkHandler : ChunkHandler {
 	MAPTChunkHandler() : ChunkHandler('MAPT', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _m[i++].type = buf[j];
-		}
+		LoadMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _m[t].type; });
 	}
 
 	void Save() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		SlSetLength(size);
-		for (TileIndex i = 0; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = _m[i++].type;
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _m[t].type; });
 	}
 };
 
 struct MAPHChunkHandler : ChunkHandler {
 	MAPHChunkHandler() : ChunkHandler('MAPH', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _m[i++].height = buf[j];
-		}
+		LoadMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _m[t].height; });
 	}
 
 	void Save() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		SlSetLength(size);
-		for (TileIndex i = 0; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = _m[i++].height;
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _m[t].height; });
 	}
 };
 
 struct MAPOChunkHandler : ChunkHandler {
 	MAPOChunkHandler() : ChunkHandler('MAPO', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _m[i++].m1 = buf[j];
-		}
+		LoadMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _m[t].m1; });
 	}
 
 	void Save() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		SlSetLength(size);
-		for (TileIndex i = 0; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = _m[i++].m1;
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _m[t].m1; });
 	}
 };
 
 struct MAP2ChunkHandler : ChunkHandler {
 	MAP2ChunkHandler() : ChunkHandler('MAP2', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<uint16, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE,
-				/* In those versions the m2 was 8 bits */
-				IsSavegameVersionBefore(SLV_5) ? SLE_FILE_U8 | SLE_VAR_U16 : SLE_UINT16
-			);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _m[i++].m2 = buf[j];
-		}
+		LoadMapPlane<uint16>(
+			/* In those versions the m2 was 8 bits */
+			IsSavegameVersionBefore(SLV_5) ? SLE_FILE_U8 | SLE_VAR_U16 : SLE_UINT16,
+			[](TileIndex t) -> uint16 & { return _m[t].m2; }
+		);
 	}
 
 	void Save() const override
 	{
-		std::array<uint16, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		SlSetLength(size * sizeof(uint16));
-		for (TileIndex i = 0; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = _m[i++].m2;
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT16);
-		}
+		SaveMapPlane<uint16>(SLE_UINT16, [](TileIndex t) -> uint16 & { return _m[t].m2; });
 	}
 };
 
 struct M3LOChunkHandler : ChunkHandler {
 	M3LOChunkHandler() : ChunkHandler('M3LO', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _m[i++].m3 = buf[j];
-		}
+		LoadMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _m[t].m3; });
 	}
 
 	void Save() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		SlSetLength(size);
-		for (TileIndex i = 0; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = _m[i++].m3;
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _m[t].m3; });
 	}
 };
 
 struct M3HIChunkHandler : ChunkHandler {
 	M3HIChunkHandler() : ChunkHandler('M3HI', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _m[i++].m4 = buf[j];
-		}
+		LoadMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _m[t].m4; });
 	}
 
 	void Save() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		SlSetLength(size);
-		for (TileIndex i = 0; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = _m[i++].m4;
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _m[t].m4; });
 	}
 };
 
 struct MAP5ChunkHandler : ChunkHandler {
 	MAP5ChunkHandler() : ChunkHandler('MAP5', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _m[i++].m5 = buf[j];
-		}
+		LoadMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _m[t].m5; });
 	}
 
 	void Save() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		SlSetLength(size);
-		for (TileIndex i = 0; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = _m[i++].m5;
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _m[t].m5; });
 	}
 };
 
 struct MAPEChunkHandler : ChunkHandler {
 	MAPEChunkHandler() : ChunkHandler('MAPE', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
 		if (IsSavegameVersionBefore(SLV_42)) {
+			std::array<byte, MAP_SL_BUF_SIZE> buf;
+			TileIndex size = MapSize();
+
 			for (TileIndex i = 0; i != size;) {
 				/* 1024, otherwise we overflow on 64x64 maps! */
 				SlCopy(buf.data(), 1024, SLE_UINT8);
@@ -279,77 +259,45 @@ struct MAPEChunkHandler : ChunkHandler {
 				}
 			}
 		} else {
-			for (TileIndex i = 0; i != size;) {
-				SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-				for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _me[i++].m6 = buf[j];
-			}
+			LoadMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _me[t].m6; });
 		}
 	}
 
 	void Save() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		SlSetLength(size);
-		for (TileIndex i = 0; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = _me[i++].m6;
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _me[t].m6; });
 	}
 };
 
 struct MAP7ChunkHandler : ChunkHandler {
 	MAP7ChunkHandler() : ChunkHandler('MAP7', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _me[i++].m7 = buf[j];
-		}
+		LoadMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _me[t].m7; });
 	}
 
 	void Save() const override
 	{
-		std::array<byte, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		SlSetLength(size);
-		for (TileIndex i = 0; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = _me[i++].m7;
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT8);
-		}
+		SaveMapPlane<byte>(SLE_UINT8, [](TileIndex t) -> byte & { return _me[t].m7; });
 	}
 };
 
 struct MAP8ChunkHandler : ChunkHandler {
 	MAP8ChunkHandler() : ChunkHandler('MAP8', CH_RIFF) {}
 
+	bool CanSaveConcurrently() const override { return true; }
+
 	void Load() const override
 	{
-		std::array<uint16, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		for (TileIndex i = 0; i != size;) {
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT16);
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) _me[i++].m8 = buf[j];
-		}
+		LoadMapPlane<uint16>(SLE_UINT16, [](TileIndex t) -> uint16 & { return _me[t].m8; });
 	}
 
 	void Save() const override
 	{
-		std::array<uint16, MAP_SL_BUF_SIZE> buf;
-		TileIndex size = MapSize();
-
-		SlSetLength(size * sizeof(uint16));
-		for (TileIndex i = 0; i != size;) {
-			for (uint j = 0; j != MAP_SL_BUF_SIZE; j++) buf[j] = _me[i++].m8;
-			SlCopy(buf.data(), MAP_SL_BUF_SIZE, SLE_UINT16);
-		}
+		SaveMapPlane<uint16>(SLE_UINT16, [](TileIndex t) -> uint16 & { return _me[t].m8; });
 	}
 };
 
@@ -15,7 +15,7 @@
  * <li>use their description array (#SaveLoad) to know what elements to save and in what version
  *    of the game it was active (used when loading)
  * <li>write all data byte-by-byte to the temporary buffer so it is endian-safe
- * <li>when the buffer is full; flush it to the output (eg save to file) (_sl.buf, _sl.bufp, _sl.bufe)
+ * <li>when the buffer is full; flush it to the output (eg save to file) (_sl->buf, _sl->bufp, _sl->bufe)
  * <li>repeat this until everything is done, and flush any remaining output to file
  * </ol>
  */
@@ -42,18 +42,33 @@
 #include "../string_func.h"
 #include "../fios.h"
 #include "../error.h"
+#include <array>
 #include <atomic>
+#include <condition_variable>
 #include <deque>
+#include <functional>
 #include <vector>
 #include <string>
 #ifdef __EMSCRIPTEN__
 #	include <emscripten.h>
 #endif
+#if defined(UNIX) && !defined(__APPLE__) && !defined(__EMSCRIPTEN__)
+/* Savegames can be made by a forked process, that works on a copy-on-write snapshot of the game. */
+#	define WITH_SAVE_PROCESS
+#	include <sys/wait.h>
+#	include <unistd.h>
+#endif
+#if defined(UNIX) && !defined(__EMSCRIPTEN__)
+/* Savegames can be read from a file that is mapped into memory. */
+#	define WITH_MAPPED_LOAD
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#endif
 
 #include "table/strings.h"
 
 #include "saveload_internal.h"
-#include "saveload_filter.h"
+#include "saveload_buffer.h"
 
 #include "../safeguards.h"
 
@@ -83,49 +98,8 @@ enum NeedLength {
 	NL_CALCLENGTH = 2, ///< need to calculate the length
 };
 
-/** Save in chunks of 128 KiB. */
-static const size_t MEMORY_CHUNK_SIZE = 128 * 1024;
-
-/** A buffer for reading (and buffering) savegame data. */
-struct ReadBuffer {
-	byte buf[MEMORY_CHUNK_SIZE]; ///< Buffer we're going to read from.
-	byte *bufp;                  ///< Location we're at reading the buffer.
-	byte *bufe;                  ///< End of the buffer we can read from.
-	LoadFilter *reader;          ///< The filter used to actually read.
-	size_t read;                 ///< The amount of read bytes so far from the filter.
-
-	/**
-	 * Initialise our variables.
-	 * @param reader The filter to actually read data.
-	 */
-	ReadBuffer(LoadFilter *reader) : bufp(nullptr), bufe(nullptr), reader(reader), read(0)
-	{
-	}
-
-	inline byte ReadByte()
-	{
-		if (this->bufp == this->bufe) {
-			size_t len = this->reader->Read(this->buf, lengthof(this->buf));
-			if (len == 0) SlErrorCorrupt("Unexpected end of chunk");
-
-			this->read += len;
-			this->bufp = this->buf;
-			this->bufe = this->buf + len;
-		}
-
-		return *this->bufp++;
-	}
-
-	/**
-	 * Get the size of the memory dump made so far.
-	 * @return The size.
-	 */
-	size_t GetSize() const
-	{
-		return this->read - (this->bufe - this->bufp);
-	}
-};
-
+/** Identifier at the start of the data of a delta savegame, instead of the first chunk. */
+static const uint32 DELTA_SAVEGAME_ID = 'DLTA';
 
 /** Container for dumping the savegame (quickly) to memory. */
 struct MemoryDumper {
@@ -161,6 +135,45 @@ struct MemoryDumper {
 		*this->buf++ = b;
 	}
 
+	/**
+	 * Write bytes into the dumper.
+	 * @param p   The bytes to write.
+	 * @param len Amount of bytes to write.
+	 */
+	void Write(const byte *p, size_t len)
+	{
+		while (len > 0) {
+			if (this->buf == this->bufe) {
+				this->buf = CallocT<byte>(MEMORY_CHUNK_SIZE);
+				this->blocks.push_back(this->buf);
+				this->bufe = this->buf + MEMORY_CHUNK_SIZE;
+			}
+
+			size_t to_write = std::min<size_t>(this->bufe - this->buf, len);
+			memcpy(this->buf, p, to_write);
+			this->buf += to_write;
+			p += to_write;
+			len -= to_write;
+		}
+	}
+
+	/**
+	 * Append everything written to another dumper to this dumper.
+	 * @param other The dumper to append.
+	 */
+	void Append(const MemoryDumper &other)
+	{
+		uint i = 0;
+		size_t t = other.GetSize();
+
+		while (t > 0) {
+			size_t to_write = std::min(MEMORY_CHUNK_SIZE, t);
+
+			this->Write(other.blocks[i++], to_write);
+			t -= to_write;
+		}
+	}
+
 	/**
 	 * Flush this dumper into a writer.
 	 * @param writer The filter we want to use.
@@ -206,6 +219,8 @@ struct SaveLoadParams {
 
 	ReadBuffer *reader;                  ///< Savegame reading buffer.
 	LoadFilter *lf;                      ///< Filter to read the savegame from.
+	bool delta_allowed;                  ///< Whether the savegame may be a delta savegame, i.e. it is loaded from a file.
+	std::string delta_dir;               ///< Directory of the savegame file, in which the base of a delta savegame is.
 
 	StringID error_str;                  ///< the translatable error message to show
 	char *extra_msg;                     ///< the error message
@@ -214,7 +229,9 @@ struct SaveLoadParams {
 	bool saveinprogress;                 ///< Whether there is currently a save in progress.
 };
 
-static SaveLoadParams _sl; ///< Parameters used for/at saveload.
+static SaveLoadParams _sl_main; ///< Parameters used for/at saveload.
+/** Parameters used by the current thread; chunks saved concurrently get their own, see #SlSaveChunks. */
+static thread_local SaveLoadParams *_sl = &_sl_main;
 
 static const std::vector<ChunkHandlerRef> &ChunkHandlers()
 {
@@ -306,7 +323,7 @@ static const std::vector<ChunkHandlerRef> &ChunkHandlers()
 /** Null all pointers (convert index -> nullptr) */
 static void SlNullPointers()
 {
-	_sl.action = SLA_NULL;
+	_sl->action = SLA_NULL;
 
 	/* We don't want any savegame conversion code to run
 	 * during NULLing; especially those that try to get
@@ -318,7 +335,7 @@ static void SlNullPointers()
 		ch.FixPointers();
 	}
 
-	assert(_sl.action == SLA_NULL);
+	assert(_sl->action == SLA_NULL);
 }
 
 /**
@@ -332,21 +349,21 @@ static void SlNullPointers()
 void NORETURN SlError(StringID string, const char *extra_msg)
 {
 	/* Distinguish between loading into _load_check_data vs. normal save/load. */
-	if (_sl.action == SLA_LOAD_CHECK) {
+	if (_sl->action == SLA_LOAD_CHECK) {
 		_load_check_data.error = string;
 		free(_load_check_data.error_data);
 		_load_check_data.error_data = (extra_msg == nullptr) ? nullptr : stredup(extra_msg);
 	} else {
-		_sl.error_str = string;
-		free(_sl.extra_msg);
-		_sl.extra_msg = (extra_msg == nullptr) ? nullptr : stredup(extra_msg);
+		_sl->error_str = string;
+		free(_sl->extra_msg);
+		_sl->extra_msg = (extra_msg == nullptr) ? nullptr : stredup(extra_msg);
 	}
 
 	/* We have to nullptr all pointers here; we might be in a state where
 	 * the pointers are actually filled with indices, which means that
 	 * when we access them during cleaning the pool dereferences of
 	 * those indices will be made with segmentation faults as result. */
-	if (_sl.action == SLA_LOAD || _sl.action == SLA_PTRS) SlNullPointers();
+	if (_sl->action == SLA_LOAD || _sl->action == SLA_PTRS) SlNullPointers();
 
 	/* Logging could be active. */
 	GamelogStopAnyAction();
@@ -389,6 +406,7 @@ void NORETURN SlErrorCorruptFmt(const char *format, ...)
 typedef void (*AsyncSaveFinishProc)();                      ///< Callback for when the savegame loading is finished.
 static std::atomic<AsyncSaveFinishProc> _async_save_finish; ///< Callback to call when the savegame loading is finished.
 static std::thread _save_thread;                            ///< The thread we're using to compress and write a savegame
+static bool _sl_single_threaded = false;                    ///< Whether saving may not start any threads, e.g. in a forked savegame process.
 
 /**
  * Called by save thread to tell we finished saving.
@@ -423,7 +441,17 @@ void ProcessAsyncSaveFinish()
  */
 byte SlReadByte()
 {
-	return _sl.reader->ReadByte();
+	return _sl->reader->ReadByte();
+}
+
+/**
+ * Read in bytes from the file/data structure but don't do
+ * anything with them, discarding them in effect
+ * @param length The amount of bytes that is being treated this way
+ */
+void SlSkipBytes(size_t length)
+{
+	_sl->reader->Skip(length);
 }
 
 /**
@@ -432,7 +460,7 @@ byte SlReadByte()
  */
 void SlWriteByte(byte b)
 {
-	_sl.dumper->WriteByte(b);
+	_sl->dumper->WriteByte(b);
 }
 
 static inline int SlReadUint16()
@@ -598,6 +626,7 @@ static uint8 GetSavegameFileType(const SaveLoad &sld)
 			return IsSavegameVersionBefore(SLV_69) ? SLE_FILE_U16 : SLE_FILE_U32;
 
 		case SL_REFLIST:
+		case SL_REFDEQUE:
 			return (IsSavegameVersionBefore(SLV_69) ? SLE_FILE_U16 : SLE_FILE_U32) | SLE_FILE_HAS_LENGTH_FIELD;
 
 		case SL_SAVEBYTE:
@@ -657,8 +686,8 @@ static inline size_t SlCalcRefLen()
 
 void SlSetArrayIndex(uint index)
 {
-	_sl.need_length = NL_WANTLENGTH;
-	_sl.array_index = index;
+	_sl->need_length = NL_WANTLENGTH;
+	_sl->array_index = index;
 }
 
 static size_t _next_offs;
@@ -673,29 +702,29 @@ int SlIterateArray()
 
 	/* After reading in the whole array inside the loop
 	 * we must have read in all the data, so we must be at end of current block. */
-	if (_next_offs != 0 && _sl.reader->GetSize() != _next_offs) SlErrorCorrupt("Invalid chunk size");
+	if (_next_offs != 0 && _sl->reader->GetSize() != _next_offs) SlErrorCorrupt("Invalid chunk size");
 
 	for (;;) {
 		uint length = SlReadArrayLength();
 		if (length == 0) {
-			assert(!_sl.expect_table_header);
+			assert(!_sl->expect_table_header);
 			_next_offs = 0;
 			return -1;
 		}
 
-		_sl.obj_len = --length;
-		_next_offs = _sl.reader->GetSize() + length;
+		_sl->obj_len = --length;
+		_next_offs = _sl->reader->GetSize() + length;
 
-		if (_sl.expect_table_header) {
-			_sl.expect_table_header = false;
+		if (_sl->expect_table_header) {
+			_sl->expect_table_header = false;
 			return INT32_MAX;
 		}
 
-		switch (_sl.block_mode) {
+		switch (_sl->block_mode) {
 			case CH_SPARSE_TABLE:
 			case CH_SPARSE_ARRAY: index = (int)SlReadSparseIndex(); break;
 			case CH_TABLE:
-			case CH_ARRAY:        index = _sl.array_index++; break;
+			case CH_ARRAY:        index = _sl->array_index++; break;
 			default:
 				Debug(sl, 0, "SlIterateArray error");
 				return -1; // error
@@ -711,7 +740,7 @@ int SlIterateArray()
 void SlSkipArray()
 {
 	while (SlIterateArray() != -1) {
-		SlSkipBytes(_next_offs - _sl.reader->GetSize());
+		SlSkipBytes(_next_offs - _sl->reader->GetSize());
 	}
 }
 
@@ -722,18 +751,18 @@ void SlSkipArray()
  */
 void SlSetLength(size_t length)
 {
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
-	switch (_sl.need_length) {
+	switch (_sl->need_length) {
 		case NL_WANTLENGTH:
-			_sl.need_length = NL_NONE;
-			if ((_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE) && _sl.expect_table_header) {
-				_sl.expect_table_header = false;
+			_sl->need_length = NL_NONE;
+			if ((_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE) && _sl->expect_table_header) {
+				_sl->expect_table_header = false;
 				SlWriteArrayLength(length + 1);
 				break;
 			}
 
-			switch (_sl.block_mode) {
+			switch (_sl->block_mode) {
 				case CH_RIFF:
 					/* Ugly encoding of >16M RIFF chunks
 					 * The lower 24 bits are normal
@@ -743,23 +772,23 @@ void SlSetLength(size_t length)
 					break;
 				case CH_TABLE:
 				case CH_ARRAY:
-					assert(_sl.last_array_index <= _sl.array_index);
-					while (++_sl.last_array_index <= _sl.array_index) {
+					assert(_sl->last_array_index <= _sl->array_index);
+					while (++_sl->last_array_index <= _sl->array_index) {
 						SlWriteArrayLength(1);
 					}
 					SlWriteArrayLength(length + 1);
 					break;
 				case CH_SPARSE_TABLE:
 				case CH_SPARSE_ARRAY:
-					SlWriteArrayLength(length + 1 + SlGetArrayLength(_sl.array_index)); // Also include length of sparse index.
-					SlWriteSparseIndex(_sl.array_index);
+					SlWriteArrayLength(length + 1 + SlGetArrayLength(_sl->array_index)); // Also include length of sparse index.
+					SlWriteSparseIndex(_sl->array_index);
 					break;
 				default: NOT_REACHED();
 			}
 			break;
 
 		case NL_CALCLENGTH:
-			_sl.obj_len += (int)length;
+			_sl->obj_len += (int)length;
 			break;
 
 		default: NOT_REACHED();
@@ -774,15 +803,59 @@ void SlSetLength(size_t length)
  */
 static void SlCopyBytes(void *ptr, size_t length)
 {
-	byte *p = (byte *)ptr;
+	switch (_sl->action) {
+		case SLA_LOAD_CHECK:
+		case SLA_LOAD:
+			_sl->reader->Read((byte *)ptr, length);
+			break;
+		case SLA_SAVE:
+			_sl->dumper->Write((const byte *)ptr, length);
+			break;
+		default: NOT_REACHED();
+	}
+}
 
-	switch (_sl.action) {
+/**
+ * Save/Load integers that are stored with the same size in the savegame as
+ * in memory. They are staged in a small buffer, so their byte order is
+ * converted in a tight loop instead of writing/reading byte by byte.
+ * @param ptr The source or destination of the integers.
+ * @param length The number of integers.
+ */
+template <typename T>
+static void SlCopySwappedInts(T *ptr, size_t length)
+{
+	static_assert(sizeof(T) == 2 || sizeof(T) == 4);
+
+	std::array<T, 2048> buf;
+
+	switch (_sl->action) {
 		case SLA_LOAD_CHECK:
 		case SLA_LOAD:
-			for (; length != 0; length--) *p++ = SlReadByte();
+			while (length > 0) {
+				size_t n = std::min(buf.size(), length);
+				_sl->reader->Read((byte *)buf.data(), n * sizeof(T));
+				if constexpr (sizeof(T) == 2) {
+					for (size_t i = 0; i != n; i++) ptr[i] = FROM_BE16(buf[i]);
+				} else {
+					for (size_t i = 0; i != n; i++) ptr[i] = FROM_BE32(buf[i]);
+				}
+				ptr += n;
+				length -= n;
+			}
 			break;
 		case SLA_SAVE:
-			for (; length != 0; length--) SlWriteByte(*p++);
+			while (length > 0) {
+				size_t n = std::min(buf.size(), length);
+				if constexpr (sizeof(T) == 2) {
+					for (size_t i = 0; i != n; i++) buf[i] = TO_BE16(ptr[i]);
+				} else {
+					for (size_t i = 0; i != n; i++) buf[i] = TO_BE32(ptr[i]);
+				}
+				_sl->dumper->Write((const byte *)buf.data(), n * sizeof(T));
+				ptr += n;
+				length -= n;
+			}
 			break;
 		default: NOT_REACHED();
 	}
@@ -791,7 +864,7 @@ static void SlCopyBytes(void *ptr, size_t length)
 /** Get the length of the current object */
 size_t SlGetFieldLength()
 {
-	return _sl.obj_len;
+	return _sl->obj_len;
 }
 
 /**
@@ -853,7 +926,7 @@ void WriteValue(void *ptr, VarType conv, int64 val)
  */
 static void SlSaveLoadConv(void *ptr, VarType conv)
 {
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE: {
 			int64 x = ReadValue(ptr, conv);
 
@@ -968,7 +1041,7 @@ static inline size_t SlCalcStdStringLen(const void *ptr)
  */
 static void SlString(void *ptr, size_t length, VarType conv)
 {
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE: {
 			size_t len;
 			switch (GetVarMemType(conv)) {
@@ -1049,7 +1122,7 @@ static void SlStdString(void *ptr, VarType conv)
 {
 	std::string *str = reinterpret_cast<std::string *>(ptr);
 
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE: {
 			size_t len = str->length();
 			SlWriteArrayLength(len);
@@ -1102,14 +1175,14 @@ static void SlStdString(void *ptr, VarType conv)
 static void SlCopyInternal(void *object, size_t length, VarType conv)
 {
 	if (GetVarMemType(conv) == SLE_VAR_NULL) {
-		assert(_sl.action != SLA_SAVE); // Use SL_NULL if you want to write null-bytes
+		assert(_sl->action != SLA_SAVE); // Use SL_NULL if you want to write null-bytes
 		SlSkipBytes(length * SlCalcConvFileLen(conv));
 		return;
 	}
 
 	/* NOTICE - handle some buggy stuff, in really old versions everything was saved
 	 * as a byte-type. So detect this, and adjust object size accordingly */
-	if (_sl.action != SLA_SAVE && _sl_version == 0) {
+	if (_sl->action != SLA_SAVE && _sl_version == 0) {
 		/* all objects except difficulty settings */
 		if (conv == SLE_INT16 || conv == SLE_UINT16 || conv == SLE_STRINGID ||
 				conv == SLE_INT32 || conv == SLE_UINT32) {
@@ -1125,10 +1198,14 @@ static void SlCopyInternal(void *object, size_t length, VarType conv)
 		}
 	}
 
-	/* If the size of elements is 1 byte both in file and memory, no special
-	 * conversion is needed, use specialized copy-copy function to speed up things */
+	/* If the size of elements is the same both in file and memory, no special
+	 * conversion is needed, use specialized copy functions to speed up things */
 	if (conv == SLE_INT8 || conv == SLE_UINT8) {
 		SlCopyBytes(object, length);
+	} else if (conv == SLE_INT16 || conv == SLE_UINT16) {
+		SlCopySwappedInts((uint16 *)object, length);
+	} else if (conv == SLE_INT32 || conv == SLE_UINT32) {
+		SlCopySwappedInts((uint32 *)object, length);
 	} else {
 		byte *a = (byte*)object;
 		byte mem_size = SlCalcConvMemLen(conv);
@@ -1144,19 +1221,22 @@ static void SlCopyInternal(void *object, size_t length, VarType conv)
  * Copy a list of SL_VARs to/from a savegame.
  * These entries are copied as-is, and you as caller have to make sure things
  * like length-fields are calculated correctly.
+ * Integers that have the same size in memory and in the savegame are copied
+ * in bulk, without converting them one by one, so this is also the way to
+ * save/load large arrays.
  * @param object The object being manipulated.
  * @param length The length of the object in elements
  * @param conv VarType type of the items.
  */
 void SlCopy(void *object, size_t length, VarType conv)
 {
-	if (_sl.action == SLA_PTRS || _sl.action == SLA_NULL) return;
+	if (_sl->action == SLA_PTRS || _sl->action == SLA_NULL) return;
 
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(length * SlCalcConvFileLen(conv));
 		/* Determine length only? */
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	SlCopyInternal(object, length, conv);
@@ -1180,7 +1260,7 @@ static inline size_t SlCalcArrayLen(size_t length, VarType conv)
  */
 static void SlArray(void *array, size_t length, VarType conv)
 {
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE:
 			SlWriteArrayLength(length);
 			SlCopyInternal(array, length, conv);
@@ -1226,7 +1306,7 @@ static void SlArray(void *array, size_t length, VarType conv)
  */
 static size_t ReferenceToInt(const void *obj, SLRefType rt)
 {
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
 	if (obj == nullptr) return 0;
 
@@ -1261,7 +1341,7 @@ static void *IntToReference(size_t index, SLRefType rt)
 {
 	static_assert(sizeof(size_t) <= sizeof(void *));
 
-	assert(_sl.action == SLA_PTRS);
+	assert(_sl->action == SLA_PTRS);
 
 	/* After version 4.3 REF_VEHICLE_OLD is saved as REF_VEHICLE,
 	 * and should be loaded like that */
@@ -1335,7 +1415,7 @@ static void *IntToReference(size_t index, SLRefType rt)
  */
 void SlSaveLoadRef(void *ptr, VarType conv)
 {
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_SAVE:
 			SlWriteUint32((uint32)ReferenceToInt(*(void **)ptr, (SLRefType)conv));
 			break;
@@ -1399,7 +1479,7 @@ public:
 
 		SlStorageT *list = static_cast<SlStorageT *>(storage);
 
-		switch (_sl.action) {
+		switch (_sl->action) {
 			case SLA_SAVE:
 				SlWriteArrayLength(list->size());
 
@@ -1458,15 +1538,42 @@ static inline size_t SlCalcRefListLen(const void *list, VarType conv)
 static void SlRefList(void *list, VarType conv)
 {
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(SlCalcRefListLen(list, conv));
 		/* Determine length only? */
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	SlStorageHelper<std::list, void *>::SlSaveLoad(list, conv, SL_REF);
 }
 
+/**
+ * Return the size in bytes of a deque of references.
+ * @param deque The std::deque to find the size of.
+ * @param conv VarType type of variable that is used for calculating the size.
+ */
+static inline size_t SlCalcRefDequeLen(const void *deque, VarType conv)
+{
+	return SlStorageHelper<std::deque, void *>::SlCalcLen(deque, conv, SL_REF);
+}
+
+/**
+ * Save/Load a deque of references.
+ * @param deque The deque being manipulated.
+ * @param conv VarType type of variable that is used for calculating the size.
+ */
+static void SlRefDeque(void *deque, VarType conv)
+{
+	/* Automatically calculate the length? */
+	if (_sl->need_length != NL_NONE) {
+		SlSetLength(SlCalcRefDequeLen(deque, conv));
+		/* Determine length only? */
+		if (_sl->need_length == NL_CALCLENGTH) return;
+	}
+
+	SlStorageHelper<std::deque, void *>::SlSaveLoad(deque, conv, SL_REF);
+}
+
 /**
  * Return the size in bytes of a std::deque.
  * @param deque The std::deque to find the size of
@@ -1604,7 +1711,7 @@ size_t SlCalcObjLength(const void *object, const SaveLoadTable &slt)
 
 size_t SlCalcObjMemberLength(const void *object, const SaveLoad &sld)
 {
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
 	if (!SlIsObjectValidInSavegame(sld)) return 0;
 
@@ -1614,6 +1721,7 @@ size_t SlCalcObjMemberLength(const void *object, const SaveLoad &sld)
 		case SL_ARR: return SlCalcArrayLen(sld.length, sld.conv);
 		case SL_STR: return SlCalcStringLen(GetVariableAddress(object, sld), sld.length, sld.conv);
 		case SL_REFLIST: return SlCalcRefListLen(GetVariableAddress(object, sld), sld.conv);
+		case SL_REFDEQUE: return SlCalcRefDequeLen(GetVariableAddress(object, sld), sld.conv);
 		case SL_DEQUE: return SlCalcDequeLen(GetVariableAddress(object, sld), sld.conv);
 		case SL_VECTOR: return SlCalcVectorLen(GetVariableAddress(object, sld), sld.conv);
 		case SL_STDSTR: return SlCalcStdStringLen(GetVariableAddress(object, sld));
@@ -1622,20 +1730,20 @@ size_t SlCalcObjMemberLength(const void *object, const SaveLoad &sld)
 
 		case SL_STRUCT:
 		case SL_STRUCTLIST: {
-			NeedLength old_need_length = _sl.need_length;
-			size_t old_obj_len = _sl.obj_len;
+			NeedLength old_need_length = _sl->need_length;
+			size_t old_obj_len = _sl->obj_len;
 
-			_sl.need_length = NL_CALCLENGTH;
-			_sl.obj_len = 0;
+			_sl->need_length = NL_CALCLENGTH;
+			_sl->obj_len = 0;
 
 			/* Pretend that we are saving to collect the object size. Other
 			 * means are difficult, as we don't know the length of the list we
 			 * are about to store. */
 			sld.handler->Save(const_cast<void *>(object));
-			size_t length = _sl.obj_len;
+			size_t length = _sl->obj_len;
 
-			_sl.obj_len = old_obj_len;
-			_sl.need_length = old_need_length;
+			_sl->obj_len = old_obj_len;
+			_sl->need_length = old_need_length;
 
 			if (sld.cmd == SL_STRUCT) {
 				length += SlGetArrayLength(1);
@@ -1710,6 +1818,7 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 		case SL_ARR:
 		case SL_STR:
 		case SL_REFLIST:
+		case SL_REFDEQUE:
 		case SL_DEQUE:
 		case SL_VECTOR:
 		case SL_STDSTR: {
@@ -1721,6 +1830,7 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 				case SL_ARR: SlArray(ptr, sld.length, conv); break;
 				case SL_STR: SlString(ptr, sld.length, sld.conv); break;
 				case SL_REFLIST: SlRefList(ptr, conv); break;
+				case SL_REFDEQUE: SlRefDeque(ptr, conv); break;
 				case SL_DEQUE: SlDeque(ptr, conv); break;
 				case SL_VECTOR: SlVector(ptr, conv); break;
 				case SL_STDSTR: SlStdString(ptr, sld.conv); break;
@@ -1735,7 +1845,7 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 		case SL_SAVEBYTE: {
 			void *ptr = GetVariableAddress(object, sld);
 
-			switch (_sl.action) {
+			switch (_sl->action) {
 				case SLA_SAVE: SlWriteByte(*(uint8 *)ptr); break;
 				case SLA_LOAD_CHECK:
 				case SLA_LOAD:
@@ -1749,7 +1859,7 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 		case SL_NULL: {
 			assert(GetVarMemType(sld.conv) == SLE_VAR_NULL);
 
-			switch (_sl.action) {
+			switch (_sl->action) {
 				case SLA_LOAD_CHECK:
 				case SLA_LOAD: SlSkipBytes(SlCalcConvFileLen(sld.conv) * sld.length); break;
 				case SLA_SAVE: for (int i = 0; i < SlCalcConvFileLen(sld.conv) * sld.length; i++) SlWriteByte(0); break;
@@ -1762,7 +1872,7 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 
 		case SL_STRUCT:
 		case SL_STRUCTLIST:
-			switch (_sl.action) {
+			switch (_sl->action) {
 				case SLA_SAVE: {
 					if (sld.cmd == SL_STRUCT) {
 						/* Store in the savegame if this struct was written or not. */
@@ -1809,9 +1919,9 @@ static bool SlObjectMember(void *object, const SaveLoad &sld)
 void SlSetStructListLength(size_t length)
 {
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(SlGetArrayLength(length));
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	SlWriteArrayLength(length);
@@ -1838,9 +1948,9 @@ size_t SlGetStructListLength(size_t limit)
 void SlObject(void *object, const SaveLoadTable &slt)
 {
 	/* Automatically calculate the length? */
-	if (_sl.need_length != NL_NONE) {
+	if (_sl->need_length != NL_NONE) {
 		SlSetLength(SlCalcObjLength(object, slt));
-		if (_sl.need_length == NL_CALCLENGTH) return;
+		if (_sl->need_length == NL_CALCLENGTH) return;
 	}
 
 	for (auto &sld : slt) {
@@ -1891,9 +2001,9 @@ class SlSkipHandler : public SaveLoadHandler {
 std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 {
 	/* You can only use SlTableHeader if you are a CH_TABLE. */
-	assert(_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	assert(_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
-	switch (_sl.action) {
+	switch (_sl->action) {
 		case SLA_LOAD_CHECK:
 		case SLA_LOAD: {
 			std::vector<SaveLoad> saveloads;
@@ -1919,7 +2029,7 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 				auto sld_it = key_lookup.find(key);
 				if (sld_it == key_lookup.end()) {
 					/* SLA_LOADCHECK triggers this debug statement a lot and is perfectly normal. */
-					Debug(sl, _sl.action == SLA_LOAD ? 2 : 6, "Field '{}' of type 0x{:02x} not found, skipping", key, type);
+					Debug(sl, _sl->action == SLA_LOAD ? 2 : 6, "Field '{}' of type 0x{:02x} not found, skipping", key, type);
 
 					std::shared_ptr<SaveLoadHandler> handler = nullptr;
 					SaveLoadType slt;
@@ -1969,9 +2079,9 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 
 		case SLA_SAVE: {
 			/* Automatically calculate the length? */
-			if (_sl.need_length != NL_NONE) {
+			if (_sl->need_length != NL_NONE) {
 				SlSetLength(SlCalcTableHeader(slt));
-				if (_sl.need_length == NL_CALCLENGTH) break;
+				if (_sl->need_length == NL_CALCLENGTH) break;
 			}
 
 			for (auto &sld : slt) {
@@ -1995,12 +2105,12 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
 				if (!SlIsObjectValidInSavegame(sld)) continue;
 				if (sld.cmd == SL_STRUCTLIST || sld.cmd == SL_STRUCT) {
 					/* SlCalcTableHeader already looks in sub-lists, so avoid the length being added twice. */
-					NeedLength old_need_length = _sl.need_length;
-					_sl.need_length = NL_NONE;
+					NeedLength old_need_length = _sl->need_length;
+					_sl->need_length = NL_NONE;
 
 					SlTableHeader(sld.handler->GetDescription());
 
-					_sl.need_length = old_need_length;
+					_sl->need_length = old_need_length;
 				}
 			}
 
@@ -2028,9 +2138,9 @@ std::vector<SaveLoad> SlTableHeader(const SaveLoadTable &slt)
  */
 std::vector<SaveLoad> SlCompatTableHeader(const SaveLoadTable &slt, const SaveLoadCompatTable &slct)
 {
-	assert(_sl.action == SLA_LOAD || _sl.action == SLA_LOAD_CHECK);
+	assert(_sl->action == SLA_LOAD || _sl->action == SLA_LOAD_CHECK);
 	/* CH_TABLE / CH_SPARSE_TABLE always have a header. */
-	if (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE) return SlTableHeader(slt);
+	if (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE) return SlTableHeader(slt);
 
 	std::vector<SaveLoad> saveloads;
 
@@ -2094,28 +2204,28 @@ void SlAutolength(AutolengthProc *proc, void *arg)
 {
 	size_t offs;
 
-	assert(_sl.action == SLA_SAVE);
+	assert(_sl->action == SLA_SAVE);
 
 	/* Tell it to calculate the length */
-	_sl.need_length = NL_CALCLENGTH;
-	_sl.obj_len = 0;
+	_sl->need_length = NL_CALCLENGTH;
+	_sl->obj_len = 0;
 	proc(arg);
 
 	/* Setup length */
-	_sl.need_length = NL_WANTLENGTH;
-	SlSetLength(_sl.obj_len);
+	_sl->need_length = NL_WANTLENGTH;
+	SlSetLength(_sl->obj_len);
 
-	offs = _sl.dumper->GetSize() + _sl.obj_len;
+	offs = _sl->dumper->GetSize() + _sl->obj_len;
 
 	/* And write the stuff */
 	proc(arg);
 
-	if (offs != _sl.dumper->GetSize()) SlErrorCorrupt("Invalid chunk size");
+	if (offs != _sl->dumper->GetSize()) SlErrorCorrupt("Invalid chunk size");
 }
 
 void ChunkHandler::LoadCheck(size_t len) const
 {
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_TABLE:
 		case CH_SPARSE_TABLE:
 			SlTableHeader({});
@@ -2142,20 +2252,20 @@ static void SlLoadChunk(const ChunkHandler &ch)
 	size_t len;
 	size_t endoffs;
 
-	_sl.block_mode = m & CH_TYPE_MASK;
-	_sl.obj_len = 0;
-	_sl.expect_table_header = (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	_sl->block_mode = m & CH_TYPE_MASK;
+	_sl->obj_len = 0;
+	_sl->expect_table_header = (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
 	/* The header should always be at the start. Read the length; the
 	 * Load() should as first action process the header. */
-	if (_sl.expect_table_header) {
+	if (_sl->expect_table_header) {
 		SlIterateArray();
 	}
 
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_TABLE:
 		case CH_ARRAY:
-			_sl.array_index = 0;
+			_sl->array_index = 0;
 			ch.Load();
 			if (_next_offs != 0) SlErrorCorrupt("Invalid array length");
 			break;
@@ -2168,17 +2278,17 @@ static void SlLoadChunk(const ChunkHandler &ch)
 			/* Read length */
 			len = (SlReadByte() << 16) | ((m >> 4) << 24);
 			len += SlReadUint16();
-			_sl.obj_len = len;
-			endoffs = _sl.reader->GetSize() + len;
+			_sl->obj_len = len;
+			endoffs = _sl->reader->GetSize() + len;
 			ch.Load();
-			if (_sl.reader->GetSize() != endoffs) SlErrorCorrupt("Invalid chunk size");
+			if (_sl->reader->GetSize() != endoffs) SlErrorCorrupt("Invalid chunk size");
 			break;
 		default:
 			SlErrorCorrupt("Invalid chunk type");
 			break;
 	}
 
-	if (_sl.expect_table_header) SlErrorCorrupt("Table chunk without header");
+	if (_sl->expect_table_header) SlErrorCorrupt("Table chunk without header");
 }
 
 /**
@@ -2192,20 +2302,20 @@ static void SlLoadCheckChunk(const ChunkHandler &ch)
 	size_t len;
 	size_t endoffs;
 
-	_sl.block_mode = m & CH_TYPE_MASK;
-	_sl.obj_len = 0;
-	_sl.expect_table_header = (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	_sl->block_mode = m & CH_TYPE_MASK;
+	_sl->obj_len = 0;
+	_sl->expect_table_header = (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
 	/* The header should always be at the start. Read the length; the
 	 * LoadCheck() should as first action process the header. */
-	if (_sl.expect_table_header) {
+	if (_sl->expect_table_header) {
 		SlIterateArray();
 	}
 
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_TABLE:
 		case CH_ARRAY:
-			_sl.array_index = 0;
+			_sl->array_index = 0;
 			ch.LoadCheck();
 			break;
 		case CH_SPARSE_TABLE:
@@ -2216,17 +2326,17 @@ static void SlLoadCheckChunk(const ChunkHandler &ch)
 			/* Read length */
 			len = (SlReadByte() << 16) | ((m >> 4) << 24);
 			len += SlReadUint16();
-			_sl.obj_len = len;
-			endoffs = _sl.reader->GetSize() + len;
+			_sl->obj_len = len;
+			endoffs = _sl->reader->GetSize() + len;
 			ch.LoadCheck(len);
-			if (_sl.reader->GetSize() != endoffs) SlErrorCorrupt("Invalid chunk size");
+			if (_sl->reader->GetSize() != endoffs) SlErrorCorrupt("Invalid chunk size");
 			break;
 		default:
 			SlErrorCorrupt("Invalid chunk type");
 			break;
 	}
 
-	if (_sl.expect_table_header) SlErrorCorrupt("Table chunk without header");
+	if (_sl->expect_table_header) SlErrorCorrupt("Table chunk without header");
 }
 
 /**
@@ -2239,41 +2349,161 @@ static void SlSaveChunk(const ChunkHandler &ch)
 	if (ch.type == CH_READONLY) return;
 
 	SlWriteUint32(ch.id);
-	Debug(sl, 2, "Saving chunk {:c}{:c}{:c}{:c}", ch.id >> 24, ch.id >> 16, ch.id >> 8, ch.id);
 
-	_sl.block_mode = ch.type;
-	_sl.expect_table_header = (_sl.block_mode == CH_TABLE || _sl.block_mode == CH_SPARSE_TABLE);
+	_sl->block_mode = ch.type;
+	_sl->expect_table_header = (_sl->block_mode == CH_TABLE || _sl->block_mode == CH_SPARSE_TABLE);
 
-	_sl.need_length = (_sl.expect_table_header || _sl.block_mode == CH_RIFF) ? NL_WANTLENGTH : NL_NONE;
+	_sl->need_length = (_sl->expect_table_header || _sl->block_mode == CH_RIFF) ? NL_WANTLENGTH : NL_NONE;
 
-	switch (_sl.block_mode) {
+	switch (_sl->block_mode) {
 		case CH_RIFF:
 			ch.Save();
 			break;
 		case CH_TABLE:
 		case CH_ARRAY:
-			_sl.last_array_index = 0;
-			SlWriteByte(_sl.block_mode);
+			_sl->last_array_index = 0;
+			SlWriteByte(_sl->block_mode);
 			ch.Save();
 			SlWriteArrayLength(0); // Terminate arrays
 			break;
 		case CH_SPARSE_TABLE:
 		case CH_SPARSE_ARRAY:
-			SlWriteByte(_sl.block_mode);
+			SlWriteByte(_sl->block_mode);
 			ch.Save();
 			SlWriteArrayLength(0); // Terminate arrays
 			break;
 		default: NOT_REACHED();
 	}
 
-	if (_sl.expect_table_header) SlErrorCorrupt("Table chunk without header");
+	if (_sl->expect_table_header) SlErrorCorrupt("Table chunk without header");
+}
+
+/** A chunk that is saved concurrently with the other chunks. */
+struct ConcurrentChunk {
+	const ChunkHandler *ch;    ///< The handler of the chunk.
+	std::unique_ptr<MemoryDumper> dumper; ///< The memory the chunk is saved into.
+	bool error;                ///< Whether saving the chunk failed.
+	StringID error_str;        ///< The translatable error message, when saving failed.
+	std::string extra_msg;     ///< The error message, when saving failed.
+
+	ConcurrentChunk(const ChunkHandler *ch) : ch(ch), dumper(new MemoryDumper()), error(false), error_str(INVALID_STRING_ID) {}
+};
+
+/**
+ * Save the chunks that can be saved concurrently, until no chunk is left.
+ * @param chunks The chunks to save.
+ * @param next   Index of the next chunk to save.
+ */
+static void SlSaveConcurrentChunks(std::vector<ConcurrentChunk> *chunks, std::atomic<size_t> *next)
+{
+	for (size_t i = (*next)++; i < chunks->size(); i = (*next)++) {
+		ConcurrentChunk &chunk = (*chunks)[i];
+
+		SaveLoadParams params = {};
+		params.action = SLA_SAVE;
+		params.dumper = chunk.dumper.get();
+		_sl = &params;
+
+		try {
+			SlSaveChunk(*chunk.ch);
+		} catch (...) {
+			chunk.error = true;
+			chunk.error_str = params.error_str;
+			if (params.extra_msg != nullptr) chunk.extra_msg = params.extra_msg;
+		}
+
+		free(params.extra_msg);
+		_sl = &_sl_main;
+	}
+}
+
+/** A chunk that has been saved into its own memory. */
+struct SavedChunk {
+	const ChunkHandler *ch;               ///< The handler of the chunk.
+	std::unique_ptr<MemoryDumper> dumper; ///< The memory the chunk is saved into.
+
+	SavedChunk(const ChunkHandler *ch, std::unique_ptr<MemoryDumper> &&dumper) : ch(ch), dumper(std::move(dumper)) {}
+};
+
+/**
+ * Save all chunks, each into their own memory.
+ * Chunks that only read the state of the game are saved by worker threads,
+ * while the game thread saves the other chunks.
+ * @return The saved chunks, in the order of the chunk handlers.
+ */
+static std::vector<SavedChunk> SlSaveChunksToMemory()
+{
+	std::vector<ConcurrentChunk> concurrent_chunks;
+	for (const ChunkHandler &ch : ChunkHandlers()) {
+		if (ch.type != CH_READONLY && ch.CanSaveConcurrently()) concurrent_chunks.emplace_back(&ch);
+	}
+
+	std::atomic<size_t> next(0);
+	std::vector<std::thread> threads;
+	uint count = _sl_single_threaded ? 0 : std::min<uint>(std::thread::hardware_concurrency(), (uint)concurrent_chunks.size());
+	for (uint i = 0; i < count; i++) {
+		std::thread thread;
+		if (!StartNewThread(&thread, "ottd:savechunk", &SlSaveConcurrentChunks, &concurrent_chunks, &next)) break;
+		threads.push_back(std::move(thread));
+	}
+
+	/* Make sure the threads are finished, also when saving a chunk here fails. */
+	auto join_threads = [&threads]() {
+		for (std::thread &thread : threads) thread.join();
+		threads.clear();
+	};
+
+	std::vector<std::unique_ptr<MemoryDumper>> dumpers(ChunkHandlers().size());
+	MemoryDumper *dumper = _sl->dumper;
+	try {
+		for (size_t i = 0; i < ChunkHandlers().size(); i++) {
+			const ChunkHandler &ch = ChunkHandlers()[i];
+			if (ch.type == CH_READONLY || ch.CanSaveConcurrently()) continue;
+
+			dumpers[i] = std::make_unique<MemoryDumper>();
+			_sl->dumper = dumpers[i].get();
+			SlSaveChunk(ch);
+		}
+		_sl->dumper = dumper;
+	} catch (...) {
+		_sl->dumper = dumper;
+		join_threads();
+		throw;
+	}
+
+	/* Save the chunks that no thread picked up, e.g. when no thread could be started. */
+	SlSaveConcurrentChunks(&concurrent_chunks, &next);
+	join_threads();
+
+	std::vector<SavedChunk> chunks;
+	auto concurrent_chunk = concurrent_chunks.begin();
+	for (size_t i = 0; i < ChunkHandlers().size(); i++) {
+		const ChunkHandler &ch = ChunkHandlers()[i];
+		if (ch.type == CH_READONLY) continue;
+
+		if (ch.CanSaveConcurrently()) {
+			if (concurrent_chunk->error) SlError(concurrent_chunk->error_str, concurrent_chunk->extra_msg.empty() ? nullptr : concurrent_chunk->extra_msg.c_str());
+			chunks.emplace_back(&ch, std::move(concurrent_chunk->dumper));
+			++concurrent_chunk;
+		} else {
+			chunks.emplace_back(&ch, std::move(dumpers[i]));
+		}
+	}
+	return chunks;
 }
 
-/** Save all chunks */
+/**
+ * Save all chunks.
+ * The chunks are saved into their own memory first, see #SlSaveChunksToMemory,
+ * and then written in the order of the chunk handlers, so the result is the
+ * same as when saving all chunks one after another.
+ */
 static void SlSaveChunks()
 {
-	for (auto &ch : ChunkHandlers()) {
-		SlSaveChunk(ch);
+	for (SavedChunk &chunk : SlSaveChunksToMemory()) {
+		Debug(sl, 2, "Saving chunk {:c}{:c}{:c}{:c}", chunk.ch->id >> 24, chunk.ch->id >> 16, chunk.ch->id >> 8, chunk.ch->id);
+		_sl->dumper->Append(*chunk.dumper);
+		chunk.dumper.reset();
 	}
 
 	/* Terminator */
@@ -2292,13 +2522,32 @@ static const ChunkHandler *SlFindChunkHandler(uint32 id)
 	return nullptr;
 }
 
+static void SlLoadDelta();
+
+/**
+ * Read the identifier of the first chunk. When the savegame is a delta
+ * savegame, the savegame it was made of is put together first.
+ * @return The identifier of the first chunk.
+ */
+static uint32 SlReadFirstChunkId()
+{
+	uint32 id = SlReadUint32();
+	if (id != DELTA_SAVEGAME_ID) return id;
+
+	/* Other savegames, like the map received when joining a server, must not make us read local files. */
+	if (!_sl->delta_allowed) SlErrorCorrupt("Delta savegame is only allowed when loading a file");
+
+	SlLoadDelta();
+	return SlReadUint32();
+}
+
 /** Load all chunks */
 static void SlLoadChunks()
 {
 	uint32 id;
 	const ChunkHandler *ch;
 
-	for (id = SlReadUint32(); id != 0; id = SlReadUint32()) {
+	for (id = SlReadFirstChunkId(); id != 0; id = SlReadUint32()) {
 		Debug(sl, 2, "Loading chunk {:c}{:c}{:c}{:c}", id >> 24, id >> 16, id >> 8, id);
 
 		ch = SlFindChunkHandler(id);
@@ -2313,7 +2562,7 @@ static void SlLoadCheckChunks()
 	uint32 id;
 	const ChunkHandler *ch;
 
-	for (id = SlReadUint32(); id != 0; id = SlReadUint32()) {
+	for (id = SlReadFirstChunkId(); id != 0; id = SlReadUint32()) {
 		Debug(sl, 2, "Loading chunk {:c}{:c}{:c}{:c}", id >> 24, id >> 16, id >> 8, id);
 
 		ch = SlFindChunkHandler(id);
@@ -2325,14 +2574,14 @@ static void SlLoadCheckChunks()
 /** Fix all pointers (convert index -> pointer) */
 static void SlFixPointers()
 {
-	_sl.action = SLA_PTRS;
+	_sl->action = SLA_PTRS;
 
 	for (const ChunkHandler &ch : ChunkHandlers()) {
 		Debug(sl, 3, "Fixing pointers for {:c}{:c}{:c}{:c}", ch.id >> 24, ch.id >> 16, ch.id >> 8, ch.id);
 		ch.FixPointers();
 	}
 
-	assert(_sl.action == SLA_PTRS);
+	assert(_sl->action == SLA_PTRS);
 }
 
 
@@ -2356,7 +2605,7 @@ struct FileReader : LoadFilter {
 		this->file = nullptr;
 
 		/* Make sure we don't double free. */
-		_sl.sf = nullptr;
+		_sl->sf = nullptr;
 	}
 
 	size_t Read(byte *buf, size_t size) override
@@ -2367,6 +2616,22 @@ struct FileReader : LoadFilter {
 		return fread(buf, 1, size, this->file);
 	}
 
+	size_t Skip(size_t size) override
+	{
+		/* We're in the process of shutting down, i.e. in "failure" mode. */
+		if (this->file == nullptr) return 0;
+
+		/* Skipping past the end is noticed by the next read. The offset of
+		 * fseek is a long, which is only 32 bits on some 64 bit platforms. */
+		size_t skipped = 0;
+		while (skipped < size) {
+			long step = (long)std::min<size_t>(size - skipped, std::numeric_limits<long>::max());
+			if (fseek(this->file, step, SEEK_CUR) != 0) break;
+			skipped += step;
+		}
+		return skipped;
+	}
+
 	void Reset() override
 	{
 		clearerr(this->file);
@@ -2376,6 +2641,78 @@ struct FileReader : LoadFilter {
 	}
 };
 
+#ifdef WITH_MAPPED_LOAD
+/**
+ * Reading from a file that is mapped into memory. Only the parts of the file
+ * that are actually read are paged in, so skipping chunks, e.g. when only
+ * checking a savegame, costs nearly nothing for uncompressed savegames.
+ */
+struct MappedFileReader : LoadFilter {
+	FILE *file;       ///< The file that is mapped.
+	const byte *map;  ///< The mapping of the whole file.
+	size_t size;      ///< The size of the file.
+	size_t begin;     ///< The begin of the savegame in the file.
+	size_t pos;       ///< The position we're at reading the file.
+
+	/**
+	 * Create the reader of a mapped file.
+	 * @param file  The file that is mapped.
+	 * @param map   The mapping of the whole file.
+	 * @param size  The size of the file.
+	 * @param begin The begin of the savegame in the file.
+	 */
+	MappedFileReader(FILE *file, const byte *map, size_t size, size_t begin) : LoadFilter(nullptr), file(file), map(map), size(size), begin(begin), pos(begin)
+	{
+	}
+
+	/** Make sure everything is cleaned up. */
+	~MappedFileReader()
+	{
+		munmap(const_cast<byte *>(this->map), this->size);
+		fclose(this->file);
+	}
+
+	size_t Read(byte *buf, size_t size) override
+	{
+		size = std::min(size, this->size - this->pos);
+		memcpy(buf, this->map + this->pos, size);
+		this->pos += size;
+		return size;
+	}
+
+	size_t Skip(size_t size) override
+	{
+		size = std::min(size, this->size - this->pos);
+		this->pos += size;
+		return size;
+	}
+
+	void Reset() override
+	{
+		this->pos = this->begin;
+	}
+};
+#endif /* WITH_MAPPED_LOAD */
+
+/**
+ * Create the filter to read a savegame from a file. When possible the file
+ * is mapped into memory, otherwise it is read as usual.
+ * @param file The file to read from.
+ * @return The filter.
+ */
+static LoadFilter *CreateFileReader(FILE *file)
+{
+#ifdef WITH_MAPPED_LOAD
+	struct stat st;
+	long begin = ftell(file);
+	if (begin >= 0 && fstat(fileno(file), &st) == 0 && S_ISREG(st.st_mode) && st.st_size > begin) {
+		void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+		if (map != MAP_FAILED) return new MappedFileReader(file, (const byte *)map, st.st_size, begin);
+	}
+#endif /* WITH_MAPPED_LOAD */
+	return new FileReader(file);
+}
+
 /** Yes, simply writing to a file. */
 struct FileWriter : SaveFilter {
 	FILE *file; ///< The file to write to.
@@ -2394,7 +2731,7 @@ struct FileWriter : SaveFilter {
 		this->Finish();
 
 		/* Make sure we don't double free. */
-		_sl.sf = nullptr;
+		_sl->sf = nullptr;
 	}
 
 	void Write(byte *buf, size_t size) override
@@ -2524,6 +2861,11 @@ struct NoCompLoadFilter : LoadFilter {
 	{
 		return this->chain->Read(buf, size);
 	}
+
+	size_t Skip(size_t size) override
+	{
+		return this->chain->Skip(size);
+	}
 };
 
 /** Filter without any compression. */
@@ -2783,6 +3125,389 @@ struct LZMASaveFilter : SaveFilter {
 
 #endif /* WITH_LIBLZMA */
 
+/*******************************************
+ ******** START OF LZMA (MT) CODE **********
+ *******************************************/
+
+/**
+ * The multi-threaded LZMA format cuts the savegame into blocks that are
+ * compressed independently, so they can be (de)compressed in parallel.
+ * Every block is stored as its uncompressed size, its compressed size (both
+ * big endian 32 bits) and the compressed data as a complete xz stream. A block
+ * with an uncompressed size of zero ends the savegame.
+ */
+static const size_t LZMA_MT_BLOCK_SIZE = 1024 * 1024;
+/** Upper limit of the uncompressed size of a block, to not trust corrupt sizes blindly. */
+static const size_t LZMA_MT_MAX_BLOCK_SIZE = 16 * LZMA_MT_BLOCK_SIZE;
+
+/** A block of the savegame that is (de)compressed independently of the others. */
+struct SaveLoadBlock {
+	std::vector<byte> input;  ///< Data to (de)compress.
+	std::vector<byte> output; ///< Result of the (de)compression.
+	bool started = false;     ///< Whether a worker picked up this block.
+	bool done = false;        ///< Whether the (de)compression has finished.
+	bool ok = false;          ///< Whether the (de)compression succeeded.
+};
+
+/**
+ * Pool of threads (de)compressing blocks. Blocks are handed out in the order
+ * they were added and have to be taken back in that same order.
+ */
+class SaveLoadBlockPool {
+public:
+	/**
+	 * Function (de)compressing a block; returns whether it succeeded. The
+	 * worker is the index of the thread running it, see #Workers.
+	 */
+	typedef std::function<bool(SaveLoadBlock &block, uint worker)> BlockProc;
+
+	/**
+	 * Create the pool and start the worker threads.
+	 * @param proc Function to process the blocks with.
+	 * @param name Name of the worker threads.
+	 */
+	SaveLoadBlockPool(BlockProc proc, const char *name) : proc(proc)
+	{
+		uint count = _sl_single_threaded ? 0 : Clamp(std::thread::hardware_concurrency(), 1U, 16U);
+		for (uint i = 0; i < count; i++) {
+			std::thread thread;
+			if (!StartNewThread(&thread, name, &SaveLoadBlockPool::WorkerThread, this, (uint)this->threads.size())) break;
+			this->threads.push_back(std::move(thread));
+		}
+	}
+
+	/** Stop the worker threads, after they finished their current block. */
+	~SaveLoadBlockPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->exit = true;
+		}
+		this->work_available.notify_all();
+		for (std::thread &thread : this->threads) thread.join();
+	}
+
+	/**
+	 * Get the number of threads that may process blocks: the worker threads,
+	 * and the thread taking the blocks back, which has the highest index.
+	 * @return The number of threads.
+	 */
+	uint Workers() const
+	{
+		return (uint)this->threads.size() + 1;
+	}
+
+	/**
+	 * Get the number of blocks that may be in flight before the oldest one should be taken back.
+	 * @return The maximum number of queued blocks.
+	 */
+	size_t MaxQueued() const
+	{
+		return 2 * std::max<size_t>(1, this->threads.size());
+	}
+
+	/**
+	 * Get the number of blocks that have not been taken back yet.
+	 * @return The number of queued blocks.
+	 */
+	size_t Queued()
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		return this->blocks.size();
+	}
+
+	/**
+	 * Queue a block for processing.
+	 * @param block The block to process.
+	 */
+	void Add(std::unique_ptr<SaveLoadBlock> block)
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->blocks.push_back(std::move(block));
+		}
+		this->work_available.notify_one();
+	}
+
+	/**
+	 * Take back the oldest block, waiting for it to be processed if needed.
+	 * Without worker threads the block is processed on the calling thread.
+	 * @return The processed block.
+	 * @pre Queued() > 0
+	 */
+	std::unique_ptr<SaveLoadBlock> Pop()
+	{
+		std::unique_lock<std::mutex> lock(this->mutex);
+		assert(!this->blocks.empty());
+		SaveLoadBlock *block = this->blocks.front().get();
+		if (!block->started) {
+			block->started = true;
+			lock.unlock();
+			block->ok = this->proc(*block, (uint)this->threads.size());
+			lock.lock();
+			block->done = true;
+		}
+		this->block_done.wait(lock, [block]() { return block->done; });
+
+		std::unique_ptr<SaveLoadBlock> result = std::move(this->blocks.front());
+		this->blocks.pop_front();
+		return result;
+	}
+
+private:
+	BlockProc proc;                                    ///< Function processing the blocks.
+	std::vector<std::thread> threads;                  ///< The worker threads.
+	std::mutex mutex;                                  ///< Lock for the blocks and the exit flag.
+	std::condition_variable work_available;            ///< Signalled when a block was added or the pool is stopping.
+	std::condition_variable block_done;                ///< Signalled when a block has been processed.
+	std::deque<std::unique_ptr<SaveLoadBlock>> blocks; ///< Blocks that have not been taken back yet, oldest first.
+	bool exit = false;                                 ///< Whether the worker threads should stop.
+
+	/**
+	 * Main loop of the worker threads.
+	 * @param pool The pool the thread belongs to.
+	 * @param worker The index of the thread.
+	 */
+	static void WorkerThread(SaveLoadBlockPool *pool, uint worker)
+	{
+		std::unique_lock<std::mutex> lock(pool->mutex);
+		for (;;) {
+			SaveLoadBlock *block = nullptr;
+			pool->work_available.wait(lock, [pool, &block]() {
+				for (auto &b : pool->blocks) {
+					if (!b->started) {
+						block = b.get();
+						return true;
+					}
+				}
+				return pool->exit;
+			});
+			if (block == nullptr) return;
+
+			block->started = true;
+			lock.unlock();
+			bool ok = pool->proc(*block, worker);
+			lock.lock();
+			block->ok = ok;
+			block->done = true;
+			pool->block_done.notify_all();
+		}
+	}
+};
+
+#if defined(WITH_LIBLZMA)
+
+/** Filter using multi-threaded LZMA decompression. */
+struct LZMAMTLoadFilter : LoadFilter {
+	SaveLoadBlockPool pool;                ///< The workers decompressing the blocks.
+	std::unique_ptr<SaveLoadBlock> block;  ///< Block we are currently reading from.
+	size_t block_pos = 0;                  ///< Position within the output of the current block.
+	bool end_reached = false;              ///< Whether the block ending the savegame has been read.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain The next filter in this chain.
+	 */
+	LZMAMTLoadFilter(LoadFilter *chain) : LoadFilter(chain), pool(&LZMAMTLoadFilter::DecompressBlock, "ottd:sl-decomp")
+	{
+	}
+
+	/**
+	 * Decompress a block.
+	 * @param block The block to decompress.
+	 * @param worker Unused.
+	 * @return Whether the data could be decompressed.
+	 */
+	static bool DecompressBlock(SaveLoadBlock &block, uint worker)
+	{
+		uint64_t memlimit = 1 << 28;
+		size_t in_pos = 0;
+		size_t out_pos = 0;
+		lzma_ret r = lzma_stream_buffer_decode(&memlimit, 0, nullptr, block.input.data(), &in_pos, block.input.size(), block.output.data(), &out_pos, block.output.size());
+		return r == LZMA_OK && out_pos == block.output.size();
+	}
+
+	/**
+	 * Read exactly the requested number of bytes from the chain.
+	 * @param buf The buffer to read into.
+	 * @param size The number of bytes to read.
+	 */
+	void ReadFromChain(byte *buf, size_t size)
+	{
+		while (size > 0) {
+			size_t len = this->chain->Read(buf, size);
+			if (len == 0) SlErrorCorrupt("Unexpected end of compressed block");
+			buf += len;
+			size -= len;
+		}
+	}
+
+	/** Read blocks from the chain and queue them for decompression, until enough work is queued. */
+	void QueueBlocks()
+	{
+		while (!this->end_reached && this->pool.Queued() < this->pool.MaxQueued()) {
+			uint32 sizes[2];
+			this->ReadFromChain((byte *)sizes, sizeof(sizes));
+			size_t size = FROM_BE32(sizes[0]);
+			size_t compressed_size = FROM_BE32(sizes[1]);
+			if (size == 0) {
+				this->end_reached = true;
+				break;
+			}
+			if (size > LZMA_MT_MAX_BLOCK_SIZE || compressed_size > lzma_stream_buffer_bound(LZMA_MT_MAX_BLOCK_SIZE)) SlErrorCorrupt("Invalid compressed block size");
+
+			std::unique_ptr<SaveLoadBlock> block(new SaveLoadBlock());
+			block->input.resize(compressed_size);
+			block->output.resize(size);
+			this->ReadFromChain(block->input.data(), compressed_size);
+			this->pool.Add(std::move(block));
+		}
+	}
+
+	size_t Read(byte *buf, size_t size) override
+	{
+		size_t read = 0;
+		while (read < size) {
+			if (this->block == nullptr || this->block_pos == this->block->output.size()) {
+				this->QueueBlocks();
+				if (this->pool.Queued() == 0) break;
+
+				this->block = this->pool.Pop();
+				this->block_pos = 0;
+				if (!this->block->ok) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "liblzma returned error code");
+			}
+
+			size_t len = std::min(size - read, this->block->output.size() - this->block_pos);
+			memcpy(buf + read, this->block->output.data() + this->block_pos, len);
+			this->block_pos += len;
+			read += len;
+		}
+		return read;
+	}
+};
+
+/** An LZMA encoder of a thread compressing blocks, which keeps its memory between blocks. */
+struct LZMABlockEncoder {
+	lzma_stream lzma = _lzma_init; ///< Stream state of the encoder.
+
+	~LZMABlockEncoder()
+	{
+		lzma_end(&this->lzma);
+	}
+};
+
+/** Filter using multi-threaded LZMA compression. */
+struct LZMAMTSaveFilter : SaveFilter {
+	lzma_options_lzma options;                    ///< Options of the LZMA2 compression of the blocks.
+	std::unique_ptr<LZMABlockEncoder[]> encoders; ///< Encoder of each thread of the pool; declared before the pool, so the workers are stopped before it is freed.
+	SaveLoadBlockPool pool;                       ///< The workers compressing the blocks.
+	std::unique_ptr<SaveLoadBlock> block;         ///< Block that is being filled.
+
+	/**
+	 * Initialise this filter.
+	 * @param chain             The next filter in this chain.
+	 * @param compression_level The requested level of compression.
+	 */
+	LZMAMTSaveFilter(SaveFilter *chain, byte compression_level) : SaveFilter(chain),
+			pool([this](SaveLoadBlock &block, uint worker) { return this->CompressBlock(block, worker); }, "ottd:sl-comp")
+	{
+		if (lzma_lzma_preset(&this->options, compression_level)) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "cannot initialize compressor");
+		/* Blocks are compressed independently, so a dictionary larger than a block only costs memory. */
+		this->options.dict_size = std::min<uint32>(this->options.dict_size, LZMA_MT_BLOCK_SIZE);
+		this->encoders.reset(new LZMABlockEncoder[this->pool.Workers()]);
+	}
+
+	/**
+	 * Compress a block into a complete xz stream.
+	 * @param block  The block to compress.
+	 * @param worker The thread compressing the block.
+	 * @return Whether the data could be compressed.
+	 */
+	bool CompressBlock(SaveLoadBlock &block, uint worker)
+	{
+		const lzma_filter filters[] = {
+			{ LZMA_FILTER_LZMA2, &this->options },
+			{ LZMA_VLI_UNKNOWN, nullptr },
+		};
+
+		/* Initialising the encoder again reuses its memory, as the options are the same. */
+		lzma_stream &lzma = this->encoders[worker].lzma;
+		if (lzma_stream_encoder(&lzma, filters, LZMA_CHECK_CRC32) != LZMA_OK) return false;
+
+		block.output.resize(lzma_stream_buffer_bound(block.input.size()));
+		lzma.next_in = block.input.data();
+		lzma.avail_in = block.input.size();
+		lzma.next_out = block.output.data();
+		lzma.avail_out = block.output.size();
+
+		lzma_ret r;
+		do {
+			r = lzma_code(&lzma, LZMA_FINISH);
+		} while (r == LZMA_OK && lzma.avail_out > 0);
+
+		block.output.resize(block.output.size() - lzma.avail_out);
+		return r == LZMA_STREAM_END;
+	}
+
+	/**
+	 * Write a block with the given sizes to the chain.
+	 * @param size The uncompressed size of the block.
+	 * @param data The compressed data.
+	 */
+	void WriteBlock(size_t size, std::vector<byte> &data)
+	{
+		uint32 sizes[2] = { TO_BE32((uint32)size), TO_BE32((uint32)data.size()) };
+		this->chain->Write((byte *)sizes, sizeof(sizes));
+		if (!data.empty()) this->chain->Write(data.data(), data.size());
+	}
+
+	/** Write the oldest queued block to the chain. */
+	void WriteOldestBlock()
+	{
+		std::unique_ptr<SaveLoadBlock> done = this->pool.Pop();
+		if (!done->ok) SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "liblzma returned error code");
+		this->WriteBlock(done->input.size(), done->output);
+	}
+
+	/** Hand the block that is being filled to the workers. */
+	void QueueBlock()
+	{
+		if (this->block == nullptr || this->block->input.empty()) return;
+
+		if (this->pool.Queued() >= this->pool.MaxQueued()) this->WriteOldestBlock();
+		this->pool.Add(std::move(this->block));
+	}
+
+	void Write(byte *buf, size_t size) override
+	{
+		while (size > 0) {
+			if (this->block == nullptr) {
+				this->block.reset(new SaveLoadBlock());
+				this->block->input.reserve(LZMA_MT_BLOCK_SIZE);
+			}
+
+			size_t len = std::min(size, LZMA_MT_BLOCK_SIZE - this->block->input.size());
+			this->block->input.insert(this->block->input.end(), buf, buf + len);
+			buf += len;
+			size -= len;
+
+			if (this->block->input.size() == LZMA_MT_BLOCK_SIZE) this->QueueBlock();
+		}
+	}
+
+	void Finish() override
+	{
+		this->QueueBlock();
+		while (this->pool.Queued() > 0) this->WriteOldestBlock();
+
+		std::vector<byte> end_of_savegame;
+		this->WriteBlock(0, end_of_savegame);
+		this->chain->Finish();
+	}
+};
+
+#endif /* WITH_LIBLZMA */
+
 /*******************************************
  ************* END OF CODE *****************
  *******************************************/
@@ -2818,6 +3543,14 @@ static const SaveLoadFormat _saveload_formats[] = {
 #else
 	{"zlib",   TO_BE32X('OTTZ'), nullptr,                            nullptr,                            0, 0, 0},
 #endif
+#if defined(WITH_LIBLZMA)
+	/* The same compression as lzma, but in independent blocks of 1 MiB that are (de)compressed on all cores.
+	 * Savegames get slightly bigger as every block starts from scratch. It comes before lzma, so it does not
+	 * become the default format; older versions cannot read it. */
+	{"lzmamt", TO_BE32X('OTTM'), CreateLoadFilter<LZMAMTLoadFilter>, CreateSaveFilter<LZMAMTSaveFilter>, 0, 2, 9},
+#else
+	{"lzmamt", TO_BE32X('OTTM'), nullptr,                            nullptr,                            0, 0, 0},
+#endif
 #if defined(WITH_LIBLZMA)
 	/* Level 2 compression is speed wise as fast as zlib level 6 compression (old default), but results in ~10% smaller saves.
 	 * Higher compression levels are possible, and might improve savegame size by up to 25%, but are also up to 10 times slower.
@@ -2878,6 +3611,309 @@ static const SaveLoadFormat *GetSavegameFormat(const std::string &full_name, byt
 	return def;
 }
 
+/*********************************************
+ ********** DELTA SAVEGAMES ******************
+ *********************************************/
+
+/** Size of the blocks of the chunks that are compared between a delta savegame and its base. */
+static const size_t DELTA_BLOCK_SIZE = 4 * 1024;
+static_assert(MEMORY_CHUNK_SIZE % DELTA_BLOCK_SIZE == 0);
+
+/** A chunk of the base savegame of delta savegames. */
+struct DeltaBaseChunk {
+	uint32 id;                   ///< The identifier of the chunk.
+	size_t offset;               ///< Offset of the chunk in the (uncompressed) data of the savegame.
+	size_t length;               ///< Length of the chunk, including its identifier.
+	std::vector<uint64> hashes;  ///< Hashes of the blocks of the chunk.
+	uint64 hash;                 ///< Hash of all blocks of the chunk.
+};
+
+/** The last full checkpoint, which is the base of the following delta checkpoints. */
+static struct {
+	std::string filename;                ///< The name of the savegame.
+	Subdirectory subdir;                 ///< The sub directory of the savegame.
+	size_t size;                         ///< Size of the (uncompressed) data of the savegame.
+	std::vector<DeltaBaseChunk> chunks;  ///< The chunks of the savegame.
+} _delta_base;
+
+/** Filter that reads a savegame that was put together from a delta savegame and its base. */
+struct DeltaLoadFilter : LoadFilter {
+	std::vector<byte> data; ///< The (uncompressed) data of the savegame.
+	size_t pos;             ///< Position we're at reading the data.
+
+	/**
+	 * Create the filter, so it reads from the given data.
+	 * @param data The data to read.
+	 */
+	DeltaLoadFilter(std::vector<byte> &&data) : LoadFilter(nullptr), data(std::move(data)), pos(0)
+	{
+	}
+
+	size_t Read(byte *buf, size_t size) override
+	{
+		size = std::min(size, this->data.size() - this->pos);
+		memcpy(buf, this->data.data() + this->pos, size);
+		this->pos += size;
+		return size;
+	}
+
+	void Reset() override
+	{
+		this->pos = 0;
+	}
+};
+
+/**
+ * Hash a block of a chunk. This only has to notice that a block changed,
+ * so a cheap FNV-1a over 32 bit words is good enough.
+ * @param p   The data of the block.
+ * @param len The length of the block.
+ * @return The hash of the block.
+ */
+static uint64 SlHashBlock(const byte *p, size_t len)
+{
+	uint64 hash = 0xCBF29CE484222325ULL;
+	for (; len >= 4; p += 4, len -= 4) {
+		uint32 word;
+		memcpy(&word, p, sizeof(word));
+		hash = (hash ^ FROM_LE32(word)) * 0x100000001B3ULL;
+	}
+	for (; len > 0; p++, len--) hash = (hash ^ *p) * 0x100000001B3ULL;
+	return hash;
+}
+
+/**
+ * Combine the hashes of the blocks of a chunk into a single hash.
+ * @param hashes The hashes of the blocks.
+ * @return The hash of the chunk.
+ */
+static uint64 SlCombineBlockHashes(const std::vector<uint64> &hashes)
+{
+	uint64 hash = 0xCBF29CE484222325ULL;
+	for (uint64 h : hashes) hash = (hash ^ h) * 0x100000001B3ULL;
+	return hash;
+}
+
+/**
+ * Hash the blocks of a chunk that was saved into memory.
+ * @param dumper The memory with the chunk.
+ * @return The hashes of the blocks.
+ */
+static std::vector<uint64> SlHashChunkBlocks(const MemoryDumper &dumper)
+{
+	std::vector<uint64> hashes;
+	size_t size = dumper.GetSize();
+	for (size_t pos = 0; pos < size; pos += DELTA_BLOCK_SIZE) {
+		const byte *p = dumper.blocks[pos / MEMORY_CHUNK_SIZE] + pos % MEMORY_CHUNK_SIZE;
+		hashes.push_back(SlHashBlock(p, std::min(DELTA_BLOCK_SIZE, size - pos)));
+	}
+	return hashes;
+}
+
+/** A savegame to make as checkpoint, see #SaveCheckpoint. */
+struct Checkpoint {
+	std::string filename; ///< The name of the savegame.
+	Subdirectory subdir;  ///< The sub directory of the savegame.
+	bool full;            ///< Whether to make a full savegame instead of a delta savegame.
+};
+
+/**
+ * Get the directory part of the name of a savegame.
+ * @param filename The name of the savegame.
+ * @return The directory including the trailing separator, or an empty string when the name has no directory.
+ */
+static std::string GetSavegameDirectory(const std::string &filename)
+{
+	size_t pos = filename.find_last_of("/" PATHSEP);
+	return pos == std::string::npos ? std::string() : filename.substr(0, pos + 1);
+}
+
+/**
+ * Save all chunks for a checkpoint.
+ * For a full checkpoint the chunks are saved as usual and the hashes of
+ * their blocks are kept for the following delta checkpoints. For a delta
+ * checkpoint only the blocks that differ from the full checkpoint are
+ * saved, together with where to find the other blocks in the full one.
+ * @param checkpoint The checkpoint to make.
+ */
+static void SlSaveCheckpointChunks(const Checkpoint &checkpoint)
+{
+	std::vector<SavedChunk> chunks = SlSaveChunksToMemory();
+
+	if (checkpoint.full) {
+		_delta_base.filename = checkpoint.filename;
+		_delta_base.subdir = checkpoint.subdir;
+		_delta_base.chunks.clear();
+
+		size_t offset = 0;
+		for (SavedChunk &chunk : chunks) {
+			DeltaBaseChunk &base = _delta_base.chunks.emplace_back();
+			base.id = chunk.ch->id;
+			base.offset = offset;
+			base.length = chunk.dumper->GetSize();
+			base.hashes = SlHashChunkBlocks(*chunk.dumper);
+			base.hash = SlCombineBlockHashes(base.hashes);
+			offset += base.length;
+
+			_sl->dumper->Append(*chunk.dumper);
+			chunk.dumper.reset();
+		}
+
+		/* Terminator */
+		SlWriteUint32(0);
+		_delta_base.size = offset + sizeof(uint32);
+		return;
+	}
+
+	/* The base is in the same directory, so only its name is stored; see #SaveCheckpoint. */
+	std::string base_name = _delta_base.filename.substr(GetSavegameDirectory(_delta_base.filename).size());
+	SlWriteUint32(DELTA_SAVEGAME_ID);
+	SlWriteSimpleGamma(base_name.size());
+	_sl->dumper->Write((const byte *)base_name.data(), base_name.size());
+	SlWriteSimpleGamma(_delta_base.size);
+
+	size_t changed_size = 0;
+	for (SavedChunk &chunk : chunks) {
+		/* A chunk that is not in the base is stored against an empty one, which the loader verifies like any other. */
+		static const DeltaBaseChunk empty = { 0, 0, 0, {}, SlCombineBlockHashes({}) };
+		const DeltaBaseChunk *base = &empty;
+		for (const DeltaBaseChunk &c : _delta_base.chunks) {
+			if (c.id == chunk.ch->id) base = &c;
+		}
+
+		size_t length = chunk.dumper->GetSize();
+		std::vector<uint64> hashes = SlHashChunkBlocks(*chunk.dumper);
+		std::vector<uint> changed;
+		for (uint i = 0; i < hashes.size(); i++) {
+			/* The last block can be the same, but shorter or longer. */
+			size_t block_length = std::min(DELTA_BLOCK_SIZE, length - i * DELTA_BLOCK_SIZE);
+			bool same = i < base->hashes.size() && hashes[i] == base->hashes[i] &&
+					block_length == std::min(DELTA_BLOCK_SIZE, base->length - i * DELTA_BLOCK_SIZE);
+			if (!same) changed.push_back(i);
+		}
+
+		SlWriteUint32(chunk.ch->id);
+		SlWriteSimpleGamma(base->offset);
+		SlWriteSimpleGamma(base->length);
+		SlWriteUint64(base->hash);
+		SlWriteSimpleGamma(length);
+		SlWriteSimpleGamma(changed.size());
+		for (uint i : changed) {
+			size_t pos = i * DELTA_BLOCK_SIZE;
+			size_t block_length = std::min(DELTA_BLOCK_SIZE, length - pos);
+			SlWriteSimpleGamma(i);
+			_sl->dumper->Write(chunk.dumper->blocks[pos / MEMORY_CHUNK_SIZE] + pos % MEMORY_CHUNK_SIZE, block_length);
+			changed_size += block_length;
+		}
+		chunk.dumper.reset();
+	}
+
+	/* Terminator */
+	SlWriteUint32(0);
+	Debug(sl, 1, "Delta savegame contains {} bytes of changed blocks", changed_size);
+}
+
+/**
+ * Read the (uncompressed) data of the base savegame of a delta savegame.
+ * @param filename The name of the base savegame, including its directory.
+ * @param size     The size of the data of the base savegame.
+ * @return The data.
+ */
+static std::vector<byte> SlReadDeltaBase(const std::string &filename, size_t size)
+{
+	FILE *fh = FioFOpenFile(filename, "rb", NO_DIRECTORY);
+	if (fh == nullptr) {
+		Debug(sl, 0, "Cannot open base savegame '{}' of delta savegame", filename);
+		SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
+	}
+	std::unique_ptr<LoadFilter> lf(CreateFileReader(fh));
+
+	uint32 hdr[2];
+	if (lf->Read((byte*)hdr, sizeof(hdr)) != sizeof(hdr)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
+
+	const SaveLoadFormat *fmt = _saveload_formats;
+	while (fmt != endof(_saveload_formats) && fmt->tag != hdr[0]) fmt++;
+	if (fmt == endof(_saveload_formats) || fmt->init_load == nullptr) SlErrorCorrupt("Unknown format of base savegame");
+	/* The blocks are only the same when the chunks are saved by the same version. */
+	if ((SaveLoadVersion)(TO_BE32(hdr[1]) >> 16) != _sl_version) SlErrorCorrupt("Base savegame has a different version");
+
+	lf.reset(fmt->init_load(lf.release()));
+
+	/* Grow the data while reading, so a corrupt size cannot make us allocate more than the base contains. */
+	std::vector<byte> data;
+	while (data.size() < size) {
+		size_t pos = data.size();
+		data.resize(std::min(size, pos + MEMORY_CHUNK_SIZE));
+		size_t read = lf->Read(data.data() + pos, data.size() - pos);
+		if (read == 0) SlErrorCorrupt("Base savegame is too short");
+		data.resize(pos + read);
+	}
+	return data;
+}
+
+/**
+ * Put together the savegame a delta savegame was made of, and continue
+ * loading from that savegame instead.
+ */
+static void SlLoadDelta()
+{
+	/* The base is stored by its name only, as it is in the same directory as the delta savegame. */
+	std::string filename(SlReadSimpleGamma(), '\0');
+	SlCopyBytes(filename.data(), filename.size());
+	if (filename.empty() || filename == "." || filename == ".." ||
+			filename.find_first_of("/\\") != std::string::npos || filename.find('\0') != std::string::npos) {
+		SlErrorCorrupt("Invalid name of base savegame");
+	}
+	size_t base_size = SlReadSimpleGamma();
+
+	Debug(sl, 1, "Loading base savegame '{}' of delta savegame", filename);
+	std::vector<byte> base = SlReadDeltaBase(_sl->delta_dir + filename, base_size);
+
+	std::vector<byte> data;
+	data.reserve(base.size());
+	for (uint32 id = SlReadUint32(); id != 0; id = SlReadUint32()) {
+		size_t base_offset = SlReadSimpleGamma();
+		size_t base_length = SlReadSimpleGamma();
+		uint64 base_hash = SlReadUint64();
+		size_t length = SlReadSimpleGamma();
+		if (base_offset + base_length > base.size()) SlErrorCorrupt("Invalid chunk of base savegame");
+
+		std::vector<uint64> hashes;
+		for (size_t pos = 0; pos < base_length; pos += DELTA_BLOCK_SIZE) {
+			hashes.push_back(SlHashBlock(base.data() + base_offset + pos, std::min(DELTA_BLOCK_SIZE, base_length - pos)));
+		}
+		if (SlCombineBlockHashes(hashes) != base_hash) SlErrorCorrupt("Delta savegame does not belong to its base savegame");
+
+		/* Start with the chunk of the base, and replace the blocks that changed. */
+		size_t start = data.size();
+		data.resize(start + length);
+		size_t filled = std::min(length, base_length);
+		memcpy(data.data() + start, base.data() + base_offset, filled);
+
+		for (uint count = SlReadSimpleGamma(); count != 0; count--) {
+			size_t pos = SlReadSimpleGamma() * DELTA_BLOCK_SIZE;
+			/* Blocks are saved in order, and everything past the base must be in them. */
+			if (pos > filled || pos >= length) SlErrorCorrupt("Invalid block in delta savegame");
+
+			size_t block_length = std::min(DELTA_BLOCK_SIZE, length - pos);
+			SlCopyBytes(data.data() + start + pos, block_length);
+			filled = std::max(filled, pos + block_length);
+		}
+		if (filled != length || length < sizeof(uint32) || data[start] != GB(id, 24, 8) || data[start + 1] != GB(id, 16, 8) ||
+				data[start + 2] != GB(id, 8, 8) || data[start + 3] != GB(id, 0, 8)) {
+			SlErrorCorrupt("Invalid chunk in delta savegame");
+		}
+	}
+
+	/* Terminator */
+	data.resize(data.size() + sizeof(uint32), 0);
+
+	delete _sl->reader;
+	delete _sl->lf;
+	_sl->lf = new DeltaLoadFilter(std::move(data));
+	_sl->reader = new ReadBuffer(_sl->lf);
+}
+
 /* actual loader/saver function */
 void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settings);
 extern bool AfterLoadGame();
@@ -2898,17 +3934,20 @@ static void ResetSaveloadData()
  */
 static inline void ClearSaveLoadState()
 {
-	delete _sl.dumper;
-	_sl.dumper = nullptr;
+	delete _sl->dumper;
+	_sl->dumper = nullptr;
+
+	delete _sl->sf;
+	_sl->sf = nullptr;
 
-	delete _sl.sf;
-	_sl.sf = nullptr;
+	delete _sl->reader;
+	_sl->reader = nullptr;
 
-	delete _sl.reader;
-	_sl.reader = nullptr;
+	delete _sl->lf;
+	_sl->lf = nullptr;
 
-	delete _sl.lf;
-	_sl.lf = nullptr;
+	_sl->delta_allowed = false;
+	_sl->delta_dir.clear();
 }
 
 /**
@@ -2918,22 +3957,22 @@ static inline void ClearSaveLoadState()
  */
 static void SaveFileStart()
 {
-	_sl.game_speed = _game_speed;
+	_sl->game_speed = _game_speed;
 	_game_speed = 100;
 	SetMouseCursorBusy(true);
 
 	InvalidateWindowData(WC_STATUS_BAR, 0, SBI_SAVELOAD_START);
-	_sl.saveinprogress = true;
+	_sl->saveinprogress = true;
 }
 
 /** Update the gui accordingly when saving is done and release locks on saveload. */
 static void SaveFileDone()
 {
-	if (_game_mode != GM_MENU) _game_speed = _sl.game_speed;
+	if (_game_mode != GM_MENU) _game_speed = _sl->game_speed;
 	SetMouseCursorBusy(false);
 
 	InvalidateWindowData(WC_STATUS_BAR, 0, SBI_SAVELOAD_FINISH);
-	_sl.saveinprogress = false;
+	_sl->saveinprogress = false;
 
 #ifdef __EMSCRIPTEN__
 	EM_ASM(if (window["openttd_syncfs"]) openttd_syncfs());
@@ -2943,17 +3982,17 @@ static void SaveFileDone()
 /** Set the error message from outside of the actual loading/saving of the game (AfterLoadGame and friends) */
 void SetSaveLoadError(StringID str)
 {
-	_sl.error_str = str;
+	_sl->error_str = str;
 }
 
 /** Get the string representation of the error message */
 const char *GetSaveLoadErrorString()
 {
-	SetDParam(0, _sl.error_str);
-	SetDParamStr(1, _sl.extra_msg);
+	SetDParam(0, _sl->error_str);
+	SetDParamStr(1, _sl->extra_msg);
 
 	static char err_str[512];
-	GetString(err_str, _sl.action == SLA_SAVE ? STR_ERROR_GAME_SAVE_FAILED : STR_ERROR_GAME_LOAD_FAILED, lastof(err_str));
+	GetString(err_str, _sl->action == SLA_SAVE ? STR_ERROR_GAME_SAVE_FAILED : STR_ERROR_GAME_LOAD_FAILED, lastof(err_str));
 	return err_str;
 }
 
@@ -2965,6 +4004,23 @@ static void SaveFileError()
 	SaveFileDone();
 }
 
+/**
+ * Write the savegame in memory to the save filter, compressing it with the
+ * format chosen by the user.
+ */
+static void SlWriteSavegame()
+{
+	byte compression;
+	const SaveLoadFormat *fmt = GetSavegameFormat(_savegame_format, &compression);
+
+	/* We have written our stuff to memory, now write it to file! */
+	uint32 hdr[2] = { fmt->tag, TO_BE32(SAVEGAME_VERSION << 16) };
+	_sl->sf->Write((byte*)hdr, sizeof(hdr));
+
+	_sl->sf = fmt->init_write(_sl->sf, compression);
+	_sl->dumper->Flush(_sl->sf);
+}
+
 /**
  * We have written the whole game into memory, _memory_savegame, now find
  * and appropriate compressor and start writing to file.
@@ -2972,15 +4028,7 @@ static void SaveFileError()
 static SaveOrLoadResult SaveFileToDisk(bool threaded)
 {
 	try {
-		byte compression;
-		const SaveLoadFormat *fmt = GetSavegameFormat(_savegame_format, &compression);
-
-		/* We have written our stuff to memory, now write it to file! */
-		uint32 hdr[2] = { fmt->tag, TO_BE32(SAVEGAME_VERSION << 16) };
-		_sl.sf->Write((byte*)hdr, sizeof(hdr));
-
-		_sl.sf = fmt->init_write(_sl.sf, compression);
-		_sl.dumper->Flush(_sl.sf);
+		SlWriteSavegame();
 
 		ClearSaveLoadState();
 
@@ -2990,11 +4038,14 @@ static SaveOrLoadResult SaveFileToDisk(bool threaded)
 	} catch (...) {
 		ClearSaveLoadState();
 
+		/* A failed savegame could have been a full checkpoint; never make deltas against it. */
+		_delta_base.chunks.clear();
+
 		AsyncSaveFinishProc asfp = SaveFileDone;
 
 		/* We don't want to shout when saving is just
 		 * cancelled due to a client disconnecting. */
-		if (_sl.error_str != STR_NETWORK_ERROR_LOSTCONNECTION) {
+		if (_sl->error_str != STR_NETWORK_ERROR_LOSTCONNECTION) {
 			/* Skip the "colour" character */
 			Debug(sl, 0, "{}", GetSaveLoadErrorString() + 3);
 			asfp = SaveFileError;
@@ -3019,25 +4070,164 @@ void WaitTillSaved()
 	ProcessAsyncSaveFinish();
 }
 
+#ifdef WITH_SAVE_PROCESS
+/**
+ * Write all of a buffer to a file descriptor.
+ * @param fd   The file descriptor to write to.
+ * @param buf  The data to write.
+ * @param size The number of bytes to write.
+ */
+static void WriteAll(int fd, const void *buf, size_t size)
+{
+	const char *p = (const char *)buf;
+	while (size > 0) {
+		ssize_t written = write(fd, p, size);
+		if (written < 0 && errno == EINTR) continue;
+		if (written <= 0) return;
+		p += written;
+		size -= written;
+	}
+}
+
+/**
+ * Wait for the process that is making the savegame to finish.
+ * @param pid      The process making the savegame.
+ * @param error_fd The pipe through which the process reports why it failed.
+ * @param threaded Whether we are waiting in the savegame thread.
+ * @return Return the result of the action. #SL_OK or #SL_ERROR
+ */
+static SaveOrLoadResult WaitForSaveProcess(pid_t pid, int error_fd, bool threaded)
+{
+	/* The process writes the error string and extra message when it fails;
+	 * the pipe is closed when the process ends in any case. */
+	std::string error;
+	char buf[256];
+	for (;;) {
+		ssize_t len = read(error_fd, buf, sizeof(buf));
+		if (len < 0 && errno == EINTR) continue;
+		if (len <= 0) break;
+		error.append(buf, len);
+	}
+	close(error_fd);
+
+	int status = 0;
+	while (waitpid(pid, &status, 0) == -1 && errno == EINTR) {}
+
+	bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+	AsyncSaveFinishProc asfp = SaveFileDone;
+	if (!ok) {
+		uint32 error_str;
+		if (error.size() >= sizeof(error_str)) {
+			memcpy(&error_str, error.data(), sizeof(error_str));
+			_sl->error_str = error_str;
+			free(_sl->extra_msg);
+			_sl->extra_msg = error.size() > sizeof(error_str) ? stredup(error.c_str() + sizeof(error_str)) : nullptr;
+		} else {
+			/* The process did not get to tell why, e.g. because it crashed. */
+			_sl->error_str = STR_GAME_SAVELOAD_ERROR_FILE_NOT_WRITEABLE;
+		}
+
+		if (_sl->error_str != STR_NETWORK_ERROR_LOSTCONNECTION) {
+			/* Skip the "colour" character */
+			Debug(sl, 0, "{}", GetSaveLoadErrorString() + 3);
+			asfp = SaveFileError;
+		}
+	}
+
+	if (threaded) {
+		SetAsyncSaveFinish(asfp);
+	} else {
+		asfp();
+	}
+	return ok ? SL_OK : SL_ERROR;
+}
+
+/**
+ * Save the game from a forked process. The process has a copy-on-write
+ * snapshot of the game, so the game can continue while the chunks are
+ * saved and written to file; the game only pays for creating the process.
+ * @return Whether the process could be created. If not, the caller has to save the game itself.
+ */
+static bool SaveInProcess()
+{
+	int error_pipe[2];
+	if (pipe(error_pipe) == -1) {
+		Debug(sl, 1, "Cannot create savegame process, saving in the game process...");
+		return false;
+	}
+
+	pid_t pid = fork();
+	if (pid == -1) {
+		close(error_pipe[0]);
+		close(error_pipe[1]);
+		Debug(sl, 1, "Cannot create savegame process, saving in the game process...");
+		return false;
+	}
+
+	if (pid == 0) {
+		/* The process making the savegame; it must not return to the game.
+		 * Only the forking thread exists here, so anything another thread of
+		 * the game held a lock on stays locked: no threads are started and
+		 * nothing is logged, the game reports what went wrong instead. */
+		close(error_pipe[0]);
+		SetDebugString("0");
+		_sl_single_threaded = true;
+		try {
+			SlSaveChunks();
+			SlWriteSavegame();
+			ClearSaveLoadState();
+		} catch (...) {
+			uint32 error_str = _sl->error_str;
+			WriteAll(error_pipe[1], &error_str, sizeof(error_str));
+			if (_sl->extra_msg != nullptr) WriteAll(error_pipe[1], _sl->extra_msg, strlen(_sl->extra_msg));
+			_exit(1);
+		}
+		_exit(0);
+	}
+	close(error_pipe[1]);
+
+	/* The process has its own copy of the dumper and the writer, and we did
+	 * not write anything to ours yet, so they can be cleaned up right away. */
+	ClearSaveLoadState();
+	SaveFileStart();
+
+	if (!StartNewThread(&_save_thread, "ottd:savegame", &WaitForSaveProcess, std::move(pid), std::move(error_pipe[0]), true)) {
+		WaitForSaveProcess(pid, error_pipe[0], false);
+	}
+	return true;
+}
+#endif /* WITH_SAVE_PROCESS */
+
 /**
  * Actually perform the saving of the savegame.
  * General tactics is to first save the game to memory, then write it to file
  * using the writer, either in threaded mode if possible, or single-threaded.
  * @param writer   The filter to write the savegame to.
  * @param threaded Whether to try to perform the saving asynchronously.
+ * @param process  Whether to try to perform the saving in a separate process, which is always waited for asynchronously.
+ * @param checkpoint The checkpoint to make, or \c nullptr for a normal savegame.
  * @return Return the result of the action. #SL_OK or #SL_ERROR
  */
-static SaveOrLoadResult DoSave(SaveFilter *writer, bool threaded)
+static SaveOrLoadResult DoSave(SaveFilter *writer, bool threaded, bool process = false, const Checkpoint *checkpoint = nullptr)
 {
-	assert(!_sl.saveinprogress);
+	assert(!_sl->saveinprogress);
 
-	_sl.dumper = new MemoryDumper();
-	_sl.sf = writer;
+	_sl->dumper = new MemoryDumper();
+	_sl->sf = writer;
 
 	_sl_version = SAVEGAME_VERSION;
 
 	SaveViewportBeforeSaveGame();
-	SlSaveChunks();
+
+#ifdef WITH_SAVE_PROCESS
+	if (process && SaveInProcess()) return SL_OK;
+#endif /* WITH_SAVE_PROCESS */
+
+	if (checkpoint != nullptr) {
+		SlSaveCheckpointChunks(*checkpoint);
+	} else {
+		SlSaveChunks();
+	}
 
 	SaveFileStart();
 
@@ -3062,7 +4252,7 @@ static SaveOrLoadResult DoSave(SaveFilter *writer, bool threaded)
 SaveOrLoadResult SaveWithFilter(SaveFilter *writer, bool threaded)
 {
 	try {
-		_sl.action = SLA_SAVE;
+		_sl->action = SLA_SAVE;
 		return DoSave(writer, threaded);
 	} catch (...) {
 		ClearSaveLoadState();
@@ -3078,7 +4268,7 @@ SaveOrLoadResult SaveWithFilter(SaveFilter *writer, bool threaded)
  */
 static SaveOrLoadResult DoLoad(LoadFilter *reader, bool load_check)
 {
-	_sl.lf = reader;
+	_sl->lf = reader;
 
 	if (load_check) {
 		/* Clear previous check data */
@@ -3088,7 +4278,7 @@ static SaveOrLoadResult DoLoad(LoadFilter *reader, bool load_check)
 	}
 
 	uint32 hdr[2];
-	if (_sl.lf->Read((byte*)hdr, sizeof(hdr)) != sizeof(hdr)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
+	if (_sl->lf->Read((byte*)hdr, sizeof(hdr)) != sizeof(hdr)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
 
 	/* see if we have any loader for this type. */
 	const SaveLoadFormat *fmt = _saveload_formats;
@@ -3096,7 +4286,7 @@ static SaveOrLoadResult DoLoad(LoadFilter *reader, bool load_check)
 		/* No loader found, treat as version 0 and use LZO format */
 		if (fmt == endof(_saveload_formats)) {
 			Debug(sl, 0, "Unknown savegame type, trying to load it as the buggy format");
-			_sl.lf->Reset();
+			_sl->lf->Reset();
 			_sl_version = SL_MIN_VERSION;
 			_sl_minor_version = 0;
 
@@ -3139,8 +4329,8 @@ static SaveOrLoadResult DoLoad(LoadFilter *reader, bool load_check)
 		SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, err_str);
 	}
 
-	_sl.lf = fmt->init_load(_sl.lf);
-	_sl.reader = new ReadBuffer(_sl.lf);
+	_sl->lf = fmt->init_load(_sl->lf);
+	_sl->reader = new ReadBuffer(_sl->lf);
 	_next_offs = 0;
 
 	if (!load_check) {
@@ -3220,7 +4410,7 @@ static SaveOrLoadResult DoLoad(LoadFilter *reader, bool load_check)
 SaveOrLoadResult LoadWithFilter(LoadFilter *reader)
 {
 	try {
-		_sl.action = SLA_LOAD;
+		_sl->action = SLA_LOAD;
 		return DoLoad(reader, false);
 	} catch (...) {
 		ClearSaveLoadState();
@@ -3240,7 +4430,7 @@ SaveOrLoadResult LoadWithFilter(LoadFilter *reader)
 SaveOrLoadResult SaveOrLoad(const std::string &filename, SaveLoadOperation fop, DetailedFileType dft, Subdirectory sb, bool threaded)
 {
 	/* An instance of saving is already active, so don't go saving again */
-	if (_sl.saveinprogress && fop == SLO_SAVE && dft == DFT_GAME_FILE && threaded) {
+	if (_sl->saveinprogress && fop == SLO_SAVE && dft == DFT_GAME_FILE && threaded) {
 		/* if not an autosave, but a user action, show error message */
 		if (!_do_autosave) ShowErrorMessage(STR_ERROR_SAVE_STILL_IN_PROGRESS, INVALID_STRING_ID, WL_ERROR);
 		return SL_OK;
@@ -3275,15 +4465,15 @@ SaveOrLoadResult SaveOrLoad(const std::string &filename, SaveLoadOperation fop,
 		assert(dft == DFT_GAME_FILE);
 		switch (fop) {
 			case SLO_CHECK:
-				_sl.action = SLA_LOAD_CHECK;
+				_sl->action = SLA_LOAD_CHECK;
 				break;
 
 			case SLO_LOAD:
-				_sl.action = SLA_LOAD;
+				_sl->action = SLA_LOAD;
 				break;
 
 			case SLO_SAVE:
-				_sl.action = SLA_SAVE;
+				_sl->action = SLA_SAVE;
 				break;
 
 			default: NOT_REACHED();
@@ -3292,9 +4482,15 @@ SaveOrLoadResult SaveOrLoad(const std::string &filename, SaveLoadOperation fop,
 		FILE *fh = (fop == SLO_SAVE) ? FioFOpenFile(filename, "wb", sb) : FioFOpenFile(filename, "rb", sb);
 
 		/* Make it a little easier to load savegames from the console */
-		if (fh == nullptr && fop != SLO_SAVE) fh = FioFOpenFile(filename, "rb", SAVE_DIR);
-		if (fh == nullptr && fop != SLO_SAVE) fh = FioFOpenFile(filename, "rb", BASE_DIR);
-		if (fh == nullptr && fop != SLO_SAVE) fh = FioFOpenFile(filename, "rb", SCENARIO_DIR);
+		if (fh == nullptr && fop != SLO_SAVE) {
+			for (Subdirectory fallback : { SAVE_DIR, BASE_DIR, SCENARIO_DIR }) {
+				fh = FioFOpenFile(filename, "rb", fallback);
+				if (fh != nullptr) {
+					sb = fallback;
+					break;
+				}
+			}
+		}
 
 		if (fh == nullptr) {
 			SlError(fop == SLO_SAVE ? STR_GAME_SAVELOAD_ERROR_FILE_NOT_WRITEABLE : STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
@@ -3302,15 +4498,29 @@ SaveOrLoadResult SaveOrLoad(const std::string &filename, SaveLoadOperation fop,
 
 		if (fop == SLO_SAVE) { // SAVE game
 			Debug(desync, 1, "save: {:08x}; {:02x}; {}", _date, _date_fract, filename);
-			if (_network_server || !_settings_client.gui.threaded_saves) threaded = false;
+			if (!_settings_client.gui.threaded_saves) threaded = false;
+
+			/* Deltas cannot be made against a full checkpoint that has been overwritten. */
+			if (filename == _delta_base.filename && sb == _delta_base.subdir) _delta_base.chunks.clear();
+
+			/* Servers report the result of saving right away, e.g. on the console,
+			 * so they save synchronously; also when using a separate process. */
+			if (_network_server) threaded = false;
 
-			return DoSave(new FileWriter(fh), threaded);
+			return DoSave(new FileWriter(fh), threaded, threaded);
 		}
 
 		/* LOAD game */
 		assert(fop == SLO_LOAD || fop == SLO_CHECK);
 		Debug(desync, 1, "load: {}", filename);
-		return DoLoad(new FileReader(fh), fop == SLO_CHECK);
+
+		/* Only a file on disk can be a delta savegame; its base is in the same directory. */
+		std::string path = (sb == NO_DIRECTORY) ? filename : FioFindFullPath(sb, filename.c_str());
+		if (path.empty() && FileExists(filename)) path = filename; // A full path was given, see FioFOpenFile.
+		_sl->delta_allowed = !path.empty();
+		_sl->delta_dir = GetSavegameDirectory(path);
+
+		return DoLoad(CreateFileReader(fh), fop == SLO_CHECK);
 	} catch (...) {
 		/* This code may be executed both for old and new save games. */
 		ClearSaveLoadState();
@@ -3357,6 +4567,53 @@ void DoAutoOrNetsave(int &counter, bool netsave)
 }
 
 
+/**
+ * Save a checkpoint of the game, e.g. for recovering a server after a crash.
+ * A full checkpoint is a normal savegame, that becomes the base of the
+ * following delta checkpoints. A delta checkpoint only contains the blocks
+ * of the chunks that changed since that full checkpoint, so its size scales
+ * with the activity in the game instead of with the size of the map. It is
+ * loaded like a normal savegame, which loads its base savegame as well.
+ * @param filename The name of the savegame being created.
+ * @param sb The sub directory to save the savegame in.
+ * @param full Whether to make a full checkpoint; when there is no full checkpoint yet, one is made anyway.
+ * @return Return the result of the action. #SL_OK or #SL_ERROR
+ */
+SaveOrLoadResult SaveCheckpoint(const std::string &filename, Subdirectory sb, bool full)
+{
+	WaitTillSaved();
+
+	try {
+		_sl->action = SLA_SAVE;
+
+		/* A delta cannot replace its own base; it would need the data it overwrites. */
+		bool replaces_base = filename == _delta_base.filename && sb == _delta_base.subdir;
+		if (replaces_base && !full && !_delta_base.chunks.empty()) Debug(sl, 1, "Checkpoint replaces the last full checkpoint, saving a full checkpoint");
+
+		/* A delta only refers to its base by name, so they have to be in the same directory. */
+		bool other_dir = sb != _delta_base.subdir || GetSavegameDirectory(filename) != GetSavegameDirectory(_delta_base.filename);
+		if (other_dir && !full && !_delta_base.chunks.empty()) Debug(sl, 1, "Checkpoint is not in the directory of the last full checkpoint, saving a full checkpoint");
+
+		FILE *fh = FioFOpenFile(filename, "wb", sb);
+		if (fh == nullptr) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_WRITEABLE);
+
+		Checkpoint checkpoint = { filename, sb, full || replaces_base || other_dir || _delta_base.chunks.empty() };
+		Debug(sl, 1, "Saving {} checkpoint to '{}'", checkpoint.full ? "full" : "delta", filename);
+
+		bool threaded = _settings_client.gui.threaded_saves && !_network_server;
+		return DoSave(new FileWriter(fh), threaded, false, &checkpoint);
+	} catch (...) {
+		ClearSaveLoadState();
+
+		/* This could have been a full checkpoint that is only partially known. */
+		_delta_base.chunks.clear();
+
+		/* Skip the "colour" character */
+		Debug(sl, 0, "{}", GetSaveLoadErrorString() + 3);
+		return SL_ERROR;
+	}
+}
+
 /** Do a save when exiting the game (_settings_client.gui.autosave_on_exit) */
 void DoExitSave()
 {
@@ -382,6 +382,7 @@ void ProcessAsyncSaveFinish();
 void DoExitSave();
 
 void DoAutoOrNetsave(int &counter, bool netsave = false);
+SaveOrLoadResult SaveCheckpoint(const std::string &filename, Subdirectory sb, bool full);
 
 SaveOrLoadResult SaveWithFilter(struct SaveFilter *writer, bool threaded);
 SaveOrLoadResult LoadWithFilter(struct LoadFilter *reader);
@@ -435,6 +436,14 @@ struct ChunkHandler {
 	 * @param len Number of bytes to skip.
 	 */
 	virtual void LoadCheck(size_t len = 0) const;
+
+	/**
+	 * Whether the chunk can be saved concurrently with other chunks.
+	 * Only chunks whose Save() reads the state of the game without changing
+	 * anything, and without using global variables, may do so.
+	 * @return True if the chunk can be saved on another thread.
+	 */
+	virtual bool CanSaveConcurrently() const { return false; }
 };
 
 /** A reference to ChunkHandler. */
@@ -639,10 +648,11 @@ enum SaveLoadType : byte {
 	SL_DEQUE       =  6, ///< Save/load a deque of #SL_VAR elements.
 	SL_VECTOR      =  7, ///< Save/load a vector of #SL_VAR elements.
 	SL_REFLIST     =  8, ///< Save/load a list of #SL_REF elements.
-	SL_STRUCTLIST  =  9, ///< Save/load a list of structs.
+	SL_REFDEQUE    =  9, ///< Save/load a deque of #SL_REF elements.
+	SL_STRUCTLIST  = 10, ///< Save/load a list of structs.
 
-	SL_SAVEBYTE    = 10, ///< Save (but not load) a byte.
-	SL_NULL        = 11, ///< Save null-bytes and load to nowhere.
+	SL_SAVEBYTE    = 11, ///< Save (but not load) a byte.
+	SL_NULL        = 12, ///< Save null-bytes and load to nowhere.
 };
 
 typedef void *SaveLoadAddrProc(void *base, size_t extra);
@@ -751,6 +761,16 @@ struct SaveLoadCompat {
  */
 #define SLE_CONDREFLIST(base, variable, type, from, to) SLE_GENERAL(SL_REFLIST, base, variable, type, 0, from, to, 0)
 
+/**
+ * Storage of a deque of #SL_REF elements in some savegame versions.
+ * @param base     Name of the class or struct containing the deque.
+ * @param variable Name of the variable in the class or struct referenced by \a base.
+ * @param type     Storage of the data in memory and in the savegame.
+ * @param from     First savegame version that has the deque.
+ * @param to       Last savegame version that has the deque.
+ */
+#define SLE_CONDREFDEQUE(base, variable, type, from, to) SLE_GENERAL(SL_REFDEQUE, base, variable, type, 0, from, to, 0)
+
 /**
  * Storage of a deque of #SL_VAR elements in some savegame versions.
  * @param base     Name of the class or struct containing the list.
@@ -811,6 +831,14 @@ struct SaveLoadCompat {
  */
 #define SLE_REFLIST(base, variable, type) SLE_CONDREFLIST(base, variable, type, SL_MIN_VERSION, SL_MAX_VERSION)
 
+/**
+ * Storage of a deque of #SL_REF elements in every savegame version.
+ * @param base     Name of the class or struct containing the deque.
+ * @param variable Name of the variable in the class or struct referenced by \a base.
+ * @param type     Storage of the data in memory and in the savegame.
+ */
+#define SLE_REFDEQUE(base, variable, type) SLE_CONDREFDEQUE(base, variable, type, SL_MIN_VERSION, SL_MAX_VERSION)
+
 /**
  * Only write byte during saving; never read it during loading.
  * When using SLE_SAVEBYTE you will have to read this byte before the table
@@ -907,6 +935,16 @@ struct SaveLoadCompat {
  */
 #define SLEG_CONDREFLIST(name, variable, type, from, to) SLEG_GENERAL(name, SL_REFLIST, variable, type, 0, from, to, 0)
 
+/**
+ * Storage of a global reference deque in some savegame versions.
+ * @param name     The name of the field.
+ * @param variable Name of the global variable.
+ * @param type     Storage of the data in memory and in the savegame.
+ * @param from     First savegame version that has the deque.
+ * @param to       Last savegame version that has the deque.
+ */
+#define SLEG_CONDREFDEQUE(name, variable, type, from, to) SLEG_GENERAL(name, SL_REFDEQUE, variable, type, 0, from, to, 0)
+
 /**
  * Storage of a global vector of #SL_VAR elements in some savegame versions.
  * @param name     The name of the field.
@@ -1131,15 +1169,7 @@ void NORETURN SlErrorCorruptFmt(const char *format, ...) WARN_FORMAT(1, 2);
 
 bool SaveloadCrashWithMissingNewGRFs();
 
-/**
- * Read in bytes from the file/data structure but don't do
- * anything with them, discarding them in effect
- * @param length The amount of bytes that is being treated this way
- */
-static inline void SlSkipBytes(size_t length)
-{
-	for (; length != 0; length--) SlReadByte();
-}
+void SlSkipBytes(size_t length);
 
 extern std::string _savegame_format;
 extern bool _do_autosave;
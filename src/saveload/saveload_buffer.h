@@ -0,0 +1,117 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file saveload_buffer.h Buffer for reading savegame data through the filters. */
+
+#ifndef SAVELOAD_BUFFER_H
+#define SAVELOAD_BUFFER_H
+
+#include "saveload.h"
+#include "saveload_filter.h"
+
+/** Save in chunks of 128 KiB. */
+static const size_t MEMORY_CHUNK_SIZE = 128 * 1024;
+
+/** A buffer for reading (and buffering) savegame data. */
+struct ReadBuffer {
+	byte buf[MEMORY_CHUNK_SIZE]; ///< Buffer we're going to read from.
+	byte *bufp;                  ///< Location we're at reading the buffer.
+	byte *bufe;                  ///< End of the buffer we can read from.
+	LoadFilter *reader;          ///< The filter used to actually read.
+	size_t read;                 ///< The amount of read bytes so far from the filter.
+
+	/**
+	 * Initialise our variables.
+	 * @param reader The filter to actually read data.
+	 */
+	ReadBuffer(LoadFilter *reader) : bufp(nullptr), bufe(nullptr), reader(reader), read(0)
+	{
+	}
+
+	inline byte ReadByte()
+	{
+		if (this->bufp == this->bufe) {
+			size_t len = this->reader->Read(this->buf, lengthof(this->buf));
+			if (len == 0) SlErrorCorrupt("Unexpected end of chunk");
+
+			this->read += len;
+			this->bufp = this->buf;
+			this->bufe = this->buf + len;
+		}
+
+		return *this->bufp++;
+	}
+
+	/**
+	 * Read bytes from the buffer.
+	 * @param p   Where to store the read bytes.
+	 * @param len Amount of bytes to read.
+	 */
+	void Read(byte *p, size_t len)
+	{
+		while (len > 0) {
+			if (this->bufp == this->bufe) {
+				size_t read = this->reader->Read(this->buf, lengthof(this->buf));
+				if (read == 0) SlErrorCorrupt("Unexpected end of chunk");
+
+				this->read += read;
+				this->bufp = this->buf;
+				this->bufe = this->buf + read;
+			}
+
+			size_t to_read = std::min<size_t>(this->bufe - this->bufp, len);
+			memcpy(p, this->bufp, to_read);
+			this->bufp += to_read;
+			p += to_read;
+			len -= to_read;
+		}
+	}
+
+	/**
+	 * Skip bytes in the buffer. Larger parts are skipped by the filter,
+	 * which might not even have to read them.
+	 * @param len Amount of bytes to skip.
+	 */
+	void Skip(size_t len)
+	{
+		size_t in_buffer = std::min<size_t>(this->bufe - this->bufp, len);
+		this->bufp += in_buffer;
+		len -= in_buffer;
+
+		if (len >= lengthof(this->buf)) {
+			if (this->reader->Skip(len) != len) SlErrorCorrupt("Unexpected end of chunk");
+			this->read += len;
+			return;
+		}
+
+		while (len > 0) {
+			if (this->bufp == this->bufe) {
+				size_t read = this->reader->Read(this->buf, lengthof(this->buf));
+				if (read == 0) SlErrorCorrupt("Unexpected end of chunk");
+
+				this->read += read;
+				this->bufp = this->buf;
+				this->bufe = this->buf + read;
+			}
+
+			size_t to_skip = std::min<size_t>(this->bufe - this->bufp, len);
+			this->bufp += to_skip;
+			len -= to_skip;
+		}
+	}
+
+	/**
+	 * Get the size of the memory dump made so far.
+	 * @return The size.
+	 */
+	size_t GetSize() const
+	{
+		return this->read - (this->bufe - this->bufp);
+	}
+};
+
+#endif /* SAVELOAD_BUFFER_H */
@@ -37,6 +37,23 @@ struct LoadFilter {
 	 */
 	virtual size_t Read(byte *buf, size_t len) = 0;
 
+	/**
+	 * Skip a given number of bytes of the savegame.
+	 * @param len The number of bytes to skip.
+	 * @return The number of actually skipped bytes.
+	 */
+	virtual size_t Skip(size_t len)
+	{
+		byte buf[4096];
+		size_t skipped = 0;
+		while (skipped < len) {
+			size_t read = this->Read(buf, std::min(sizeof(buf), len - skipped));
+			if (read == 0) break;
+			skipped += read;
+		}
+		return skipped;
+	}
+
 	/**
 	 * Reset this filter to read from the beginning of the file.
 	 */
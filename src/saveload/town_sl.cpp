@@ -282,6 +282,7 @@ struct CITYChunkHandler : ChunkHandler {
 	void Save() const override
 	{
 		SlTableHeader(_town_desc);
+		UpdateTownGrowCounters();
 
 		for (Town *t : Town::Iterate()) {
 			SlSetArrayIndex(t->index);
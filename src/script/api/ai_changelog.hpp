@@ -17,6 +17,20 @@
  *
  * This version is not yet released. The following changes are not set in stone yet.
  *
+ * API additions:
+ * \li AIStationList::ValuateCargoRating
+ * \li AIStationList::ValuateCargoWaiting
+ * \li AIStationList::ValuateDistanceManhattanToTile
+ * \li AITileList::ValuateBuildable
+ * \li AITileList::ValuateCargoAcceptance
+ * \li AITileList::ValuateDistanceManhattanToTile
+ * \li AITileList::ValuateSlope
+ *
+ * Other changes:
+ * \li AIList iterates over a snapshot of its items in the sorted order taken
+ *     at Begin(); items added or revalued during the iteration are not visited
+ *     or moved, items removed during the iteration are skipped
+ *
  * \b 1.11.0
  *
  * API additions:
@@ -17,6 +17,20 @@
  *
  * This version is not yet released. The following changes are not set in stone yet.
  *
+ * API additions:
+ * \li GSStationList::ValuateCargoRating
+ * \li GSStationList::ValuateCargoWaiting
+ * \li GSStationList::ValuateDistanceManhattanToTile
+ * \li GSTileList::ValuateBuildable
+ * \li GSTileList::ValuateCargoAcceptance
+ * \li GSTileList::ValuateDistanceManhattanToTile
+ * \li GSTileList::ValuateSlope
+ *
+ * Other changes:
+ * \li GSList iterates over a snapshot of its items in the sorted order taken
+ *     at Begin(); items added or revalued during the iteration are not visited
+ *     or moved, items removed during the iteration are skipped
+ *
  * \b 1.11.0
  *
  * API additions:
@@ -15,413 +15,101 @@
 
 #include "../../safeguards.h"
 
-/**
- * Base class for any ScriptList sorter.
- */
-class ScriptListSorter {
-protected:
-	ScriptList *list;       ///< The list that's being sorted.
-	bool has_no_more_items; ///< Whether we have more items to iterate over.
-	int64 item_next;        ///< The next item we will show.
-
-public:
-	/**
-	 * Virtual dtor, needed to mute warnings.
-	 */
-	virtual ~ScriptListSorter() { }
-
-	/**
-	 * Get the first item of the sorter.
-	 */
-	virtual int64 Begin() = 0;
-
-	/**
-	 * Stop iterating a sorter.
-	 */
-	virtual void End() = 0;
-
-	/**
-	 * Get the next item of the sorter.
-	 */
-	virtual int64 Next() = 0;
-
-	/**
-	 * See if the sorter has reached the end.
-	 */
-	bool IsEnd()
-	{
-		return this->list->buckets.empty() || this->has_no_more_items;
-	}
+ScriptList::ScriptList()
+{
+	/* Default sorter */
+	this->removed        = 0;
+	this->iteration_pos  = 0;
+	this->iteration_end  = true;
+	this->sorter_type    = SORT_BY_VALUE;
+	this->sort_ascending = false;
+	this->initialized    = false;
+	this->modifications  = 0;
+}
 
-	/**
-	 * Callback from the list if an item gets removed.
-	 */
-	virtual void Remove(int item) = 0;
-
-	/**
-	 * Attach the sorter to a new list. This assumes the content of the old list has been moved to
-	 * the new list, too, so that we don't have to invalidate any iterators. Note that std::swap
-	 * doesn't invalidate iterators on lists and maps, so that should be safe.
-	 * @param target New list to attach to.
-	 */
-	virtual void Retarget(ScriptList *new_list)
-	{
-		this->list = new_list;
-	}
-};
+ScriptList::~ScriptList()
+{
+}
 
 /**
- * Sort by value, ascending.
+ * Find an item in the list.
+ * @param item The item to find.
+ * @return Iterator to the item, or the end of the list when it is not in the list.
  */
-class ScriptListSorterValueAscending : public ScriptListSorter {
-private:
-	ScriptList::ScriptListBucket::iterator bucket_iter;    ///< The iterator over the list to find the buckets.
-	ScriptList::ScriptItemList *bucket_list;               ///< The current bucket list we're iterator over.
-	ScriptList::ScriptItemList::iterator bucket_list_iter; ///< The iterator over the bucket list.
-
-public:
-	/**
-	 * Create a new sorter.
-	 * @param list The list to sort.
-	 */
-	ScriptListSorterValueAscending(ScriptList *list)
-	{
-		this->list = list;
-		this->End();
-	}
-
-	int64 Begin()
-	{
-		if (this->list->buckets.empty()) return 0;
-		this->has_no_more_items = false;
-
-		this->bucket_iter = this->list->buckets.begin();
-		this->bucket_list = &(*this->bucket_iter).second;
-		this->bucket_list_iter = this->bucket_list->begin();
-		this->item_next = *this->bucket_list_iter;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void End()
-	{
-		this->bucket_list = nullptr;
-		this->has_no_more_items = true;
-		this->item_next = 0;
-	}
-
-	/**
-	 * Find the next item, and store that information.
-	 */
-	void FindNext()
-	{
-		if (this->bucket_list == nullptr) {
-			this->has_no_more_items = true;
-			return;
-		}
-
-		this->bucket_list_iter++;
-		if (this->bucket_list_iter == this->bucket_list->end()) {
-			this->bucket_iter++;
-			if (this->bucket_iter == this->list->buckets.end()) {
-				this->bucket_list = nullptr;
-				return;
-			}
-			this->bucket_list = &(*this->bucket_iter).second;
-			this->bucket_list_iter = this->bucket_list->begin();
-		}
-		this->item_next = *this->bucket_list_iter;
-	}
-
-	int64 Next()
-	{
-		if (this->IsEnd()) return 0;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
+std::vector<ScriptList::Item>::iterator ScriptList::FindItem(int64 item)
+{
+	auto iter = std::lower_bound(this->items.begin(), this->items.end(), item, [](const Item &a, int64 b) { return a.item < b; });
+	if (iter == this->items.end() || iter->item != item || iter->removed) return this->items.end();
+	return iter;
+}
 
-	void Remove(int item)
-	{
-		if (this->IsEnd()) return;
+/** Erase the removed items from the list. */
+void ScriptList::EraseRemovedItems()
+{
+	if (this->removed == 0) return;
 
-		/* If we remove the 'next' item, skip to the next */
-		if (item == this->item_next) {
-			FindNext();
-			return;
-		}
-	}
-};
+	this->items.erase(std::remove_if(this->items.begin(), this->items.end(), [](const Item &item) { return item.removed; }), this->items.end());
+	this->removed = 0;
+}
 
 /**
- * Sort by value, descending.
+ * Remove all items for which the predicate holds.
+ * @param predicate The function telling whether an item has to be removed.
  */
-class ScriptListSorterValueDescending : public ScriptListSorter {
-private:
-	/* Note: We cannot use reverse_iterator.
-	 *       The iterators must only be invalidated when the element they are pointing to is removed.
-	 *       This only holds for forward iterators. */
-	ScriptList::ScriptListBucket::iterator bucket_iter;    ///< The iterator over the list to find the buckets.
-	ScriptList::ScriptItemList *bucket_list;               ///< The current bucket list we're iterator over.
-	ScriptList::ScriptItemList::iterator bucket_list_iter; ///< The iterator over the bucket list.
-
-public:
-	/**
-	 * Create a new sorter.
-	 * @param list The list to sort.
-	 */
-	ScriptListSorterValueDescending(ScriptList *list)
-	{
-		this->list = list;
-		this->End();
-	}
-
-	int64 Begin()
-	{
-		if (this->list->buckets.empty()) return 0;
-		this->has_no_more_items = false;
-
-		/* Go to the end of the bucket-list */
-		this->bucket_iter = this->list->buckets.end();
-		--this->bucket_iter;
-		this->bucket_list = &(*this->bucket_iter).second;
-
-		/* Go to the end of the items in the bucket */
-		this->bucket_list_iter = this->bucket_list->end();
-		--this->bucket_list_iter;
-		this->item_next = *this->bucket_list_iter;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void End()
-	{
-		this->bucket_list = nullptr;
-		this->has_no_more_items = true;
-		this->item_next = 0;
-	}
-
-	/**
-	 * Find the next item, and store that information.
-	 */
-	void FindNext()
-	{
-		if (this->bucket_list == nullptr) {
-			this->has_no_more_items = true;
-			return;
-		}
-
-		if (this->bucket_list_iter == this->bucket_list->begin()) {
-			if (this->bucket_iter == this->list->buckets.begin()) {
-				this->bucket_list = nullptr;
-				return;
-			}
-			this->bucket_iter--;
-			this->bucket_list = &(*this->bucket_iter).second;
-			/* Go to the end of the items in the bucket */
-			this->bucket_list_iter = this->bucket_list->end();
-			--this->bucket_list_iter;
-		} else {
-			this->bucket_list_iter--;
-		}
-		this->item_next = *this->bucket_list_iter;
-	}
-
-	int64 Next()
-	{
-		if (this->IsEnd()) return 0;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void Remove(int item)
-	{
-		if (this->IsEnd()) return;
-
-		/* If we remove the 'next' item, skip to the next */
-		if (item == this->item_next) {
-			FindNext();
-			return;
-		}
-	}
-};
+template <typename Tpredicate>
+void ScriptList::RemoveItemsIf(Tpredicate predicate)
+{
+	this->EraseRemovedItems();
+	this->items.erase(std::remove_if(this->items.begin(), this->items.end(), predicate), this->items.end());
+}
 
 /**
- * Sort by item, ascending.
+ * Get the items of the list in the order of the current sorter.
+ * @return The sorted items.
  */
-class ScriptListSorterItemAscending : public ScriptListSorter {
-private:
-	ScriptList::ScriptListMap::iterator item_iter; ///< The iterator over the items in the map.
-
-public:
-	/**
-	 * Create a new sorter.
-	 * @param list The list to sort.
-	 */
-	ScriptListSorterItemAscending(ScriptList *list)
-	{
-		this->list = list;
-		this->End();
-	}
-
-	int64 Begin()
-	{
-		if (this->list->items.empty()) return 0;
-		this->has_no_more_items = false;
-
-		this->item_iter = this->list->items.begin();
-		this->item_next = (*this->item_iter).first;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void End()
-	{
-		this->has_no_more_items = true;
-	}
+std::vector<int64> ScriptList::GetSortedItems()
+{
+	this->EraseRemovedItems();
 
-	/**
-	 * Find the next item, and store that information.
-	 */
-	void FindNext()
-	{
-		if (this->item_iter == this->list->items.end()) {
-			this->has_no_more_items = true;
-			return;
-		}
-		this->item_iter++;
-		if (this->item_iter != this->list->items.end()) item_next = (*this->item_iter).first;
-	}
+	std::vector<int64> result;
+	result.reserve(this->items.size());
 
-	int64 Next()
-	{
-		if (this->IsEnd()) return 0;
+	if (this->sorter_type == SORT_BY_VALUE) {
+		std::vector<std::pair<int64, int64>> values;
+		values.reserve(this->items.size());
+		for (const Item &item : this->items) values.emplace_back(item.value, item.item);
+		std::sort(values.begin(), values.end());
 
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
+		for (const auto &value : values) result.push_back(value.second);
+	} else {
+		for (const Item &item : this->items) result.push_back(item.item);
 	}
 
-	void Remove(int item)
-	{
-		if (this->IsEnd()) return;
+	/* Descending is the exact reverse; also for items with the same value. */
+	if (!this->sort_ascending) std::reverse(result.begin(), result.end());
 
-		/* If we remove the 'next' item, skip to the next */
-		if (item == this->item_next) {
-			FindNext();
-			return;
-		}
-	}
-};
+	return result;
+}
 
 /**
- * Sort by item, descending.
+ * Get the next item of the iteration that is still in the list.
+ * @return The item, or 0 when the iteration went beyond the last item.
  */
-class ScriptListSorterItemDescending : public ScriptListSorter {
-private:
-	/* Note: We cannot use reverse_iterator.
-	 *       The iterators must only be invalidated when the element they are pointing to is removed.
-	 *       This only holds for forward iterators. */
-	ScriptList::ScriptListMap::iterator item_iter; ///< The iterator over the items in the map.
-
-public:
-	/**
-	 * Create a new sorter.
-	 * @param list The list to sort.
-	 */
-	ScriptListSorterItemDescending(ScriptList *list)
-	{
-		this->list = list;
-		this->End();
-	}
-
-	int64 Begin()
-	{
-		if (this->list->items.empty()) return 0;
-		this->has_no_more_items = false;
-
-		this->item_iter = this->list->items.end();
-		--this->item_iter;
-		this->item_next = (*this->item_iter).first;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void End()
-	{
-		this->has_no_more_items = true;
-	}
-
-	/**
-	 * Find the next item, and store that information.
-	 */
-	void FindNext()
-	{
-		if (this->item_iter == this->list->items.end()) {
-			this->has_no_more_items = true;
-			return;
-		}
-		if (this->item_iter == this->list->items.begin()) {
-			/* Use 'end' as marker for 'beyond begin' */
-			this->item_iter = this->list->items.end();
-		} else {
-			this->item_iter--;
-		}
-		if (this->item_iter != this->list->items.end()) item_next = (*this->item_iter).first;
-	}
-
-	int64 Next()
-	{
-		if (this->IsEnd()) return 0;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void Remove(int item)
-	{
-		if (this->IsEnd()) return;
-
-		/* If we remove the 'next' item, skip to the next */
-		if (item == this->item_next) {
-			FindNext();
-			return;
-		}
-	}
-};
-
-
-
-ScriptList::ScriptList()
+int64 ScriptList::NextIterationItem()
 {
-	/* Default sorter */
-	this->sorter         = new ScriptListSorterValueDescending(this);
-	this->sorter_type    = SORT_BY_VALUE;
-	this->sort_ascending = false;
-	this->initialized    = false;
-	this->modifications  = 0;
-}
+	while (this->iteration_pos < this->iteration.size()) {
+		int64 item = this->iteration[this->iteration_pos++];
+		if (this->HasItem(item)) return item;
+	}
 
-ScriptList::~ScriptList()
-{
-	delete this->sorter;
+	this->iteration_end = true;
+	this->iteration.clear();
+	return 0;
 }
 
 bool ScriptList::HasItem(int64 item)
 {
-	return this->items.count(item) == 1;
+	return this->FindItem(item) != this->items.end();
 }
 
 void ScriptList::Clear()
@@ -429,41 +117,50 @@ void ScriptList::Clear()
 	this->modifications++;
 
 	this->items.clear();
-	this->buckets.clear();
-	this->sorter->End();
+	this->removed = 0;
+	this->iteration.clear();
+	this->iteration_end = true;
 }
 
 void ScriptList::AddItem(int64 item, int64 value)
 {
 	this->modifications++;
 
-	if (this->HasItem(item)) return;
+	auto iter = std::lower_bound(this->items.begin(), this->items.end(), item, [](const Item &a, int64 b) { return a.item < b; });
+	if (iter != this->items.end() && iter->item == item) {
+		if (!iter->removed) return;
 
-	this->items[item] = value;
-	this->buckets[value].insert(item);
+		iter->value = value;
+		iter->removed = false;
+		this->removed--;
+		return;
+	}
+
+	this->items.insert(iter, { item, value, false });
 }
 
 void ScriptList::RemoveItem(int64 item)
 {
 	this->modifications++;
 
-	ScriptListMap::iterator item_iter = this->items.find(item);
-	if (item_iter == this->items.end()) return;
-
-	int64 value = item_iter->second;
+	auto iter = this->FindItem(item);
+	if (iter == this->items.end()) return;
 
-	this->sorter->Remove(item);
-	ScriptListBucket::iterator bucket_iter = this->buckets.find(value);
-	assert(bucket_iter != this->buckets.end());
-	bucket_iter->second.erase(item);
-	if (bucket_iter->second.empty()) this->buckets.erase(bucket_iter);
-	this->items.erase(item_iter);
+	/* Only mark the item, so removing many items one by one does not move
+	 * the rest of the list around every time. */
+	iter->removed = true;
+	this->removed++;
+	if (this->removed > this->items.size() / 2) this->EraseRemovedItems();
 }
 
 int64 ScriptList::Begin()
 {
 	this->initialized = true;
-	return this->sorter->Begin();
+
+	this->iteration = this->GetSortedItems();
+	this->iteration_pos = 0;
+	this->iteration_end = false;
+	return this->NextIterationItem();
 }
 
 int64 ScriptList::Next()
@@ -472,12 +169,14 @@ int64 ScriptList::Next()
 		Debug(script, 0, "Next() is invalid as Begin() is never called");
 		return 0;
 	}
-	return this->sorter->Next();
+	if (this->IsEnd()) return 0;
+
+	return this->NextIterationItem();
 }
 
 bool ScriptList::IsEmpty()
 {
-	return this->items.empty();
+	return this->items.size() == this->removed;
 }
 
 bool ScriptList::IsEnd()
@@ -486,38 +185,28 @@ bool ScriptList::IsEnd()
 		Debug(script, 0, "IsEnd() is invalid as Begin() is never called");
 		return true;
 	}
-	return this->sorter->IsEnd();
+	return this->IsEmpty() || this->iteration_end;
 }
 
 int32 ScriptList::Count()
 {
-	return (int32)this->items.size();
+	return (int32)(this->items.size() - this->removed);
 }
 
 int64 ScriptList::GetValue(int64 item)
 {
-	ScriptListMap::const_iterator item_iter = this->items.find(item);
-	return item_iter == this->items.end() ? 0 : item_iter->second;
+	auto iter = this->FindItem(item);
+	return iter == this->items.end() ? 0 : iter->value;
 }
 
 bool ScriptList::SetValue(int64 item, int64 value)
 {
 	this->modifications++;
 
-	ScriptListMap::iterator item_iter = this->items.find(item);
-	if (item_iter == this->items.end()) return false;
-
-	int64 value_old = item_iter->second;
-	if (value_old == value) return true;
-
-	this->sorter->Remove(item);
-	ScriptListBucket::iterator bucket_iter = this->buckets.find(value_old);
-	assert(bucket_iter != this->buckets.end());
-	bucket_iter->second.erase(item);
-	if (bucket_iter->second.empty()) this->buckets.erase(bucket_iter);
-	item_iter->second = value;
-	this->buckets[value].insert(item);
+	auto iter = this->FindItem(item);
+	if (iter == this->items.end()) return false;
 
+	iter->value = value;
 	return true;
 }
 
@@ -528,47 +217,35 @@ void ScriptList::Sort(SorterType sorter, bool ascending)
 	if (sorter != SORT_BY_VALUE && sorter != SORT_BY_ITEM) return;
 	if (sorter == this->sorter_type && ascending == this->sort_ascending) return;
 
-	delete this->sorter;
-	switch (sorter) {
-		case SORT_BY_ITEM:
-			if (ascending) {
-				this->sorter = new ScriptListSorterItemAscending(this);
-			} else {
-				this->sorter = new ScriptListSorterItemDescending(this);
-			}
-			break;
-
-		case SORT_BY_VALUE:
-			if (ascending) {
-				this->sorter = new ScriptListSorterValueAscending(this);
-			} else {
-				this->sorter = new ScriptListSorterValueDescending(this);
-			}
-			break;
-
-		default: NOT_REACHED();
-	}
 	this->sorter_type    = sorter;
 	this->sort_ascending = ascending;
 	this->initialized    = false;
+	this->iteration.clear();
+	this->iteration_end  = true;
 }
 
 void ScriptList::AddList(ScriptList *list)
 {
 	if (list == this) return;
 
-	if (this->IsEmpty()) {
-		/* If this is empty, we can just take the items of the other list as is. */
-		this->items = list->items;
-		this->buckets = list->buckets;
-		this->modifications++;
-	} else {
-		ScriptListMap *list_items = &list->items;
-		for (ScriptListMap::iterator iter = list_items->begin(); iter != list_items->end(); iter++) {
-			this->AddItem((*iter).first);
-			this->SetValue((*iter).first, (*iter).second);
-		}
+	this->modifications++;
+
+	/* Merge both sorted lists; items in both get the value of the other list. */
+	this->EraseRemovedItems();
+	std::vector<Item> result;
+	result.reserve(this->items.size() + list->items.size());
+
+	auto iter = this->items.begin();
+	for (const Item &item : list->items) {
+		if (item.removed) continue;
+
+		while (iter != this->items.end() && iter->item < item.item) result.push_back(*iter++);
+		if (iter != this->items.end() && iter->item == item.item) iter++;
+		result.push_back(item);
 	}
+	result.insert(result.end(), iter, this->items.end());
+
+	this->items.swap(result);
 }
 
 void ScriptList::SwapList(ScriptList *list)
@@ -576,128 +253,74 @@ void ScriptList::SwapList(ScriptList *list)
 	if (list == this) return;
 
 	this->items.swap(list->items);
-	this->buckets.swap(list->buckets);
-	Swap(this->sorter, list->sorter);
+	this->iteration.swap(list->iteration);
+	Swap(this->removed, list->removed);
+	Swap(this->iteration_pos, list->iteration_pos);
+	Swap(this->iteration_end, list->iteration_end);
 	Swap(this->sorter_type, list->sorter_type);
 	Swap(this->sort_ascending, list->sort_ascending);
 	Swap(this->initialized, list->initialized);
 	Swap(this->modifications, list->modifications);
-	this->sorter->Retarget(this);
-	list->sorter->Retarget(list);
 }
 
 void ScriptList::RemoveAboveValue(int64 value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second > value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](const Item &item) { return item.value > value; });
 }
 
 void ScriptList::RemoveBelowValue(int64 value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second < value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](const Item &item) { return item.value < value; });
 }
 
 void ScriptList::RemoveBetweenValue(int64 start, int64 end)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second > start && (*iter).second < end) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([start, end](const Item &item) { return item.value > start && item.value < end; });
 }
 
 void ScriptList::RemoveValue(int64 value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second == value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](const Item &item) { return item.value == value; });
 }
 
 void ScriptList::RemoveTop(int32 count)
 {
 	this->modifications++;
 
-	if (!this->sort_ascending) {
-		this->Sort(this->sorter_type, !this->sort_ascending);
-		this->RemoveBottom(count);
-		this->Sort(this->sorter_type, !this->sort_ascending);
+	if (count <= 0) return;
+	if (count >= this->Count()) {
+		this->Clear();
 		return;
 	}
 
-	switch (this->sorter_type) {
-		default: NOT_REACHED();
-		case SORT_BY_VALUE:
-			for (ScriptListBucket::iterator iter = this->buckets.begin(); iter != this->buckets.end(); iter = this->buckets.begin()) {
-				ScriptItemList *items = &(*iter).second;
-				size_t size = items->size();
-				for (ScriptItemList::iterator iter = items->begin(); iter != items->end(); iter = items->begin()) {
-					if (--count < 0) return;
-					this->RemoveItem(*iter);
-					/* When the last item is removed from the bucket, the bucket itself is removed.
-					 * This means that the iterators can be invalid after a call to RemoveItem.
-					 */
-					if (--size == 0) break;
-				}
-			}
-			break;
-
-		case SORT_BY_ITEM:
-			for (ScriptListMap::iterator iter = this->items.begin(); iter != this->items.end(); iter = this->items.begin()) {
-				if (--count < 0) return;
-				this->RemoveItem((*iter).first);
-			}
-			break;
-	}
+	std::vector<int64> sorted = this->GetSortedItems();
+	for (auto iter = sorted.begin(); iter != sorted.begin() + count; iter++) this->FindItem(*iter)->removed = true;
+	this->removed = count;
+	this->EraseRemovedItems();
 }
 
 void ScriptList::RemoveBottom(int32 count)
 {
 	this->modifications++;
 
-	if (!this->sort_ascending) {
-		this->Sort(this->sorter_type, !this->sort_ascending);
-		this->RemoveTop(count);
-		this->Sort(this->sorter_type, !this->sort_ascending);
+	if (count <= 0) return;
+	if (count >= this->Count()) {
+		this->Clear();
 		return;
 	}
 
-	switch (this->sorter_type) {
-		default: NOT_REACHED();
-		case SORT_BY_VALUE:
-			for (ScriptListBucket::reverse_iterator iter = this->buckets.rbegin(); iter != this->buckets.rend(); iter = this->buckets.rbegin()) {
-				ScriptItemList *items = &(*iter).second;
-				size_t size = items->size();
-				for (ScriptItemList::reverse_iterator iter = items->rbegin(); iter != items->rend(); iter = items->rbegin()) {
-					if (--count < 0) return;
-					this->RemoveItem(*iter);
-					/* When the last item is removed from the bucket, the bucket itself is removed.
-					 * This means that the iterators can be invalid after a call to RemoveItem.
-					 */
-					if (--size == 0) break;
-				}
-			}
-			break;
-
-		case SORT_BY_ITEM:
-			for (ScriptListMap::reverse_iterator iter = this->items.rbegin(); iter != this->items.rend(); iter = this->items.rbegin()) {
-				if (--count < 0) return;
-				this->RemoveItem((*iter).first);
-			}
-			break;
-	}
+	std::vector<int64> sorted = this->GetSortedItems();
+	for (auto iter = sorted.rbegin(); iter != sorted.rbegin() + count; iter++) this->FindItem(*iter)->removed = true;
+	this->removed = count;
+	this->EraseRemovedItems();
 }
 
 void ScriptList::RemoveList(ScriptList *list)
@@ -707,10 +330,17 @@ void ScriptList::RemoveList(ScriptList *list)
 	if (list == this) {
 		Clear();
 	} else {
-		ScriptListMap *list_items = &list->items;
-		for (ScriptListMap::iterator iter = list_items->begin(); iter != list_items->end(); iter++) {
-			this->RemoveItem((*iter).first);
+		/* Both lists are sorted by item, so walk them side by side. */
+		this->EraseRemovedItems();
+		auto iter = this->items.begin();
+		for (const Item &item : list->items) {
+			if (item.removed) continue;
+
+			iter = std::lower_bound(iter, this->items.end(), item.item, [](const Item &a, int64 b) { return a.item < b; });
+			if (iter == this->items.end()) break;
+			if (iter->item == item.item) iter->removed = true;
 		}
+		this->RemoveItemsIf([](const Item &item) { return item.removed; });
 	}
 }
 
@@ -718,40 +348,28 @@ void ScriptList::KeepAboveValue(int64 value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second <= value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](const Item &item) { return item.value <= value; });
 }
 
 void ScriptList::KeepBelowValue(int64 value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second >= value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](const Item &item) { return item.value >= value; });
 }
 
 void ScriptList::KeepBetweenValue(int64 start, int64 end)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second <= start || (*iter).second >= end) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([start, end](const Item &item) { return item.value <= start || item.value >= end; });
 }
 
 void ScriptList::KeepValue(int64 value)
 {
 	this->modifications++;
 
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second != value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](const Item &item) { return item.value != value; });
 }
 
 void ScriptList::KeepTop(int32 count)
@@ -774,10 +392,7 @@ void ScriptList::KeepList(ScriptList *list)
 
 	this->modifications++;
 
-	ScriptList tmp;
-	tmp.AddList(this);
-	tmp.RemoveList(list);
-	this->RemoveList(&tmp);
+	this->RemoveItemsIf([list](const Item &item) { return !list->HasItem(item.item); });
 }
 
 SQInteger ScriptList::_get(HSQUIRRELVM vm)
@@ -787,10 +402,10 @@ SQInteger ScriptList::_get(HSQUIRRELVM vm)
 	SQInteger idx;
 	sq_getinteger(vm, 2, &idx);
 
-	ScriptListMap::const_iterator item_iter = this->items.find(idx);
+	auto item_iter = this->FindItem(idx);
 	if (item_iter == this->items.end()) return SQ_ERROR;
 
-	sq_pushinteger(vm, item_iter->second);
+	sq_pushinteger(vm, item_iter->value);
 	return 1;
 }
 
@@ -869,14 +484,17 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 	/* Push the function to call */
 	sq_push(vm, 2);
 
-	for (ScriptListMap::iterator iter = this->items.begin(); iter != this->items.end(); iter++) {
+	/* Erase the removed items first, so the list cannot be compacted while
+	 * iterating over it. Valuators are not allowed to change the list. */
+	this->EraseRemovedItems();
+	for (Item &item : this->items) {
 		/* Check for changing of items. */
 		int previous_modification_count = this->modifications;
 
 		/* Push the root table as instance object, this is what squirrel does for meta-functions. */
 		sq_pushroottable(vm);
 		/* Push all arguments for the valuator function. */
-		sq_pushinteger(vm, (*iter).first);
+		sq_pushinteger(vm, item.item);
 		for (int i = 0; i < nparam - 1; i++) {
 			sq_push(vm, i + 3);
 		}
@@ -930,7 +548,7 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 			return sq_throwerror(vm, "modifying valuated list outside of valuator function");
 		}
 
-		this->SetValue((*iter).first, value);
+		item.value = value;
 
 		/* Pop the return value. */
 		sq_poptop(vm);
@@ -12,10 +12,7 @@
 #define SCRIPT_LIST_HPP
 
 #include "script_object.hpp"
-#include <map>
-#include <set>
-
-class ScriptListSorter;
+#include <vector>
 
 /**
  * Class that creates a list which can keep item/value pairs, which you can walk.
@@ -35,20 +32,49 @@ public:
 	static const bool SORT_DESCENDING = false;
 
 private:
-	ScriptListSorter *sorter;     ///< Sorting algorithm
+	/** An item in the list with its value. */
+	struct Item {
+		int64 item;   ///< The item.
+		int64 value;  ///< The value of the item.
+		bool removed; ///< Whether the item has been removed, but is not yet erased from the list.
+	};
+
+	std::vector<Item> items;      ///< The items in the list, sorted by item
+	size_t removed;               ///< Number of removed items that are not yet erased from #items
+	std::vector<int64> iteration; ///< The items in the order of the sorter, as they were when the iteration began
+	size_t iteration_pos;         ///< Position in #iteration of the next item
+	bool iteration_end;           ///< Whether the iteration went beyond the last item
 	SorterType sorter_type;       ///< Sorting type
 	bool sort_ascending;          ///< Whether to sort ascending or descending
 	bool initialized;             ///< Whether an iteration has been started
 	int modifications;            ///< Number of modification that has been done. To prevent changing data while valuating.
 
-public:
-	typedef std::set<int64> ScriptItemList;                   ///< The list of items inside the bucket
-	typedef std::map<int64, ScriptItemList> ScriptListBucket; ///< The bucket list per value
-	typedef std::map<int64, int64> ScriptListMap;             ///< List per item
+	std::vector<Item>::iterator FindItem(int64 item);
+	void EraseRemovedItems();
+	template <typename Tpredicate> void RemoveItemsIf(Tpredicate predicate);
+	std::vector<int64> GetSortedItems();
+	int64 NextIterationItem();
 
-	ScriptListMap items;           ///< The items in the list
-	ScriptListBucket buckets;      ///< The items in the list, sorted by value
+protected:
+	/**
+	 * Give all items the value returned by a valuator in native code, so
+	 *  large lists can be valuated without calling into Squirrel for every item.
+	 * @param valuator The function giving the value of an item.
+	 */
+	template <typename Tvaluator>
+	void ValuateNative(Tvaluator valuator)
+	{
+		this->modifications++;
 
+		for (Item &item : this->items) {
+			if (item.removed) continue;
+			item.value = valuator(item.item);
+			/* Charge the same as #Valuate does per item. */
+			ScriptObject::DecreaseOps(5);
+		}
+	}
+
+public:
 	ScriptList();
 	~ScriptList();
 
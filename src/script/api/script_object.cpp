@@ -35,7 +35,7 @@ static ScriptStorage *GetStorage()
 }
 
 
-/* static */ ScriptInstance *ScriptObject::ActiveInstance::active = nullptr;
+/* static */ thread_local ScriptInstance *ScriptObject::ActiveInstance::active = nullptr;
 
 ScriptObject::ActiveInstance::ActiveInstance(ScriptInstance *instance) : alc_scope(instance->engine)
 {
@@ -269,6 +269,11 @@ ScriptObject::ActiveInstance::~ActiveInstance()
 	return GetStorage()->allow_do_command && squirrel->CanSuspend();
 }
 
+/* static */ void ScriptObject::DecreaseOps(int ops)
+{
+	Squirrel::DecreaseOps(ScriptObject::GetActiveInstance()->engine->GetVM(), ops);
+}
+
 /* static */ void *&ScriptObject::GetEventPointer()
 {
 	return GetStorage()->event_data;
@@ -325,11 +330,21 @@ ScriptObject::ActiveInstance::~ActiveInstance()
 	/* Only set p2 when the command does not come from the network. */
 	if (GetCommandFlags(cmd) & CMD_CLIENT_ID && p2 == 0) p2 = UINT32_MAX;
 
+	/* In singleplayer the commands of AIs are only tested now, and executed
+	 * at the end of the tick; so all AIs see the same state of the game.
+	 * Only AI::GameLoop executes them, so this does not apply to a game
+	 * script, not even when it acts as a company with GSCompanyMode. */
+	bool deferred = !_networking && !_generating_world && ScriptObject::GetRootCompany() != OWNER_DEITY;
+
 	/* Store the command for command callback validation. */
-	if (!estimate_only && _networking && !_generating_world) SetLastCommand(tile, p1, p2, cmd);
+	if (!estimate_only && (_networking || deferred) && !_generating_world) SetLastCommand(tile, p1, p2, cmd);
 
 	/* Try to perform the command. */
-	CommandCost res = ::DoCommandPInternal(tile, p1, p2, cmd, (_networking && !_generating_world) ? ScriptObject::GetActiveInstance()->GetDoCommandCallback() : nullptr, command_text, false, estimate_only);
+	CommandCost res = ::DoCommandPInternal(tile, p1, p2, cmd, (_networking && !_generating_world) ? ScriptObject::GetActiveInstance()->GetDoCommandCallback() : nullptr, command_text, false, estimate_only || deferred);
+
+	/* The test run of a deferred command skipped the check for money, just like
+	 * any estimate; do it here, as it is done before sending a command in network games. */
+	if (deferred && !estimate_only && res.Succeeded() && (GetCommandFlags(cmd) & CMD_NO_TEST) == 0) ::CheckCompanyHasMoney(res);
 
 	/* We failed; set the error and bail out */
 	if (res.Failed()) {
@@ -362,6 +377,11 @@ ScriptObject::ActiveInstance::~ActiveInstance()
 	} else if (_networking) {
 		/* Suspend the script till the command is really executed. */
 		throw Script_Suspend(-(int)GetDoCommandDelay(), callback);
+	} else if (deferred) {
+		/* Suspend the script till the command is executed at the end of the tick. */
+		ScriptInstance *instance = GetActiveInstance();
+		instance->deferred_commands.push_back({ tile, p1, p2, cmd, instance->GetDoCommandCallback(), command_text });
+		throw Script_Suspend(-(int)GetDoCommandDelay(), callback);
 	} else {
 		IncreaseDoCommandCosts(res.GetCost());
 
@@ -23,6 +23,21 @@ ScriptStationList::ScriptStationList(ScriptStation::StationType station_type)
 	}
 }
 
+void ScriptStationList::ValuateCargoWaiting(CargoID cargo_id)
+{
+	this->ValuateNative([cargo_id](int64 station_id) { return ScriptStation::GetCargoWaiting((StationID)station_id, cargo_id); });
+}
+
+void ScriptStationList::ValuateCargoRating(CargoID cargo_id)
+{
+	this->ValuateNative([cargo_id](int64 station_id) { return ScriptStation::GetCargoRating((StationID)station_id, cargo_id); });
+}
+
+void ScriptStationList::ValuateDistanceManhattanToTile(TileIndex tile)
+{
+	this->ValuateNative([tile](int64 station_id) { return ScriptStation::GetDistanceManhattanToTile((StationID)station_id, tile); });
+}
+
 ScriptStationList_Vehicle::ScriptStationList_Vehicle(VehicleID vehicle_id)
 {
 	if (!ScriptVehicle::IsValidVehicle(vehicle_id)) return;
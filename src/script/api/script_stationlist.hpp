@@ -24,6 +24,30 @@ public:
 	 * @param station_type The type of station to make a list of stations for.
 	 */
 	ScriptStationList(ScriptStation::StationType station_type);
+
+	/**
+	 * Set the value of all stations in the list to the amount of a cargo waiting there.
+	 * @param cargo_id The cargo to get the waiting amount of.
+	 * @note This gives the same result as Valuate(ScriptStation.GetCargoWaiting, cargo_id), but is much faster for large lists.
+	 * @see ScriptStation::GetCargoWaiting
+	 */
+	void ValuateCargoWaiting(CargoID cargo_id);
+
+	/**
+	 * Set the value of all stations in the list to their rating of a cargo.
+	 * @param cargo_id The cargo to get the rating of.
+	 * @note This gives the same result as Valuate(ScriptStation.GetCargoRating, cargo_id), but is much faster for large lists.
+	 * @see ScriptStation::GetCargoRating
+	 */
+	void ValuateCargoRating(CargoID cargo_id);
+
+	/**
+	 * Set the value of all stations in the list to their Manhattan distance to a tile.
+	 * @param tile The tile to get the distance to.
+	 * @note This gives the same result as Valuate(ScriptStation.GetDistanceManhattanToTile, tile), but is much faster for large lists.
+	 * @see ScriptStation::GetDistanceManhattanToTile
+	 */
+	void ValuateDistanceManhattanToTile(TileIndex tile);
 };
 
 /**
@@ -10,6 +10,7 @@
 #include "../../stdafx.h"
 #include "script_tilelist.hpp"
 #include "script_industry.hpp"
+#include "script_tile.hpp"
 #include "../../industry.h"
 #include "../../station_base.h"
 
@@ -47,6 +48,26 @@ void ScriptTileList::RemoveTile(TileIndex tile)
 	this->RemoveItem(tile);
 }
 
+void ScriptTileList::ValuateBuildable()
+{
+	this->ValuateNative([](int64 tile) { return ScriptTile::IsBuildable((TileIndex)tile); });
+}
+
+void ScriptTileList::ValuateSlope()
+{
+	this->ValuateNative([](int64 tile) { return ScriptTile::GetSlope((TileIndex)tile); });
+}
+
+void ScriptTileList::ValuateDistanceManhattanToTile(TileIndex tile)
+{
+	this->ValuateNative([tile](int64 t) { return ScriptTile::GetDistanceManhattanToTile((TileIndex)t, tile); });
+}
+
+void ScriptTileList::ValuateCargoAcceptance(CargoID cargo_type, int width, int height, int radius)
+{
+	this->ValuateNative([cargo_type, width, height, radius](int64 tile) { return ScriptTile::GetCargoAcceptance((TileIndex)tile, cargo_type, width, height, radius); });
+}
+
 /**
  * Helper to get list of tiles that will cover an industry's production or acceptance.
  * @param i Industry in question
@@ -51,6 +51,43 @@ public:
 	 * @pre ScriptMap::IsValidTile(tile).
 	 */
 	void RemoveTile(TileIndex tile);
+
+	/**
+	 * Set the value of all tiles in the list to whether they are buildable.
+	 * @note This gives the same result as Valuate(ScriptTile.IsBuildable), but is much faster for large lists.
+	 * @see ScriptTile::IsBuildable
+	 */
+	void ValuateBuildable();
+
+	/**
+	 * Set the value of all tiles in the list to their slope.
+	 * @note This gives the same result as Valuate(ScriptTile.GetSlope), but is much faster for large lists.
+	 * @see ScriptTile::GetSlope
+	 */
+	void ValuateSlope();
+
+	/**
+	 * Set the value of all tiles in the list to their Manhattan distance to a tile.
+	 * @param tile The tile to get the distance to.
+	 * @note This gives the same result as Valuate(ScriptTile.GetDistanceManhattanToTile, tile), but is much faster for large lists.
+	 * @see ScriptTile::GetDistanceManhattanToTile
+	 */
+	void ValuateDistanceManhattanToTile(TileIndex tile);
+
+	/**
+	 * Set the value of all tiles in the list to the acceptance of a cargo by a station built there.
+	 * @param cargo_type The cargo to check the acceptance of.
+	 * @param width The width of the station.
+	 * @param height The height of the station.
+	 * @param radius The radius of the station.
+	 * @pre ScriptCargo::IsValidCargo(cargo_type)
+	 * @pre width > 0.
+	 * @pre height > 0.
+	 * @pre radius >= 0.
+	 * @note This gives the same result as Valuate(ScriptTile.GetCargoAcceptance, cargo_type, width, height, radius), but is much faster for large lists.
+	 * @see ScriptTile::GetCargoAcceptance
+	 */
+	void ValuateCargoAcceptance(CargoID cargo_type, int width, int height, int radius);
 };
 
 /**
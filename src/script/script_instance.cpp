@@ -25,6 +25,7 @@
 
 #include "../company_base.h"
 #include "../company_func.h"
+#include "../command_func.h"
 #include "../fileio_func.h"
 
 #include "../safeguards.h"
@@ -59,7 +60,10 @@ ScriptInstance::ScriptInstance(const char *APIName) :
 	suspend(0),
 	is_paused(false),
 	in_shutdown(false),
-	callback(nullptr)
+	callback(nullptr),
+	total_time(0),
+	last_time(0),
+	time_suspends(0)
 {
 	this->storage = new ScriptStorage();
 	this->engine  = new Squirrel(APIName);
@@ -166,6 +170,25 @@ void ScriptInstance::Died()
 }
 
 void ScriptInstance::GameLoop()
+{
+	auto start = std::chrono::steady_clock::now();
+
+	uint max_time = _settings_game.script.script_max_time_per_tick;
+	this->RunGameLoop(max_time == 0 ? std::chrono::steady_clock::time_point::max() : start + std::chrono::milliseconds(max_time));
+
+	this->last_time = std::chrono::steady_clock::now() - start;
+	this->total_time += this->last_time;
+}
+
+void ScriptInstance::EndTimeLimit()
+{
+	if (this->engine == nullptr) return;
+
+	if (this->engine->IsDeadlinePassed()) this->time_suspends++;
+	this->engine->SetSuspendDeadline(std::chrono::steady_clock::time_point::max());
+}
+
+void ScriptInstance::RunGameLoop(std::chrono::steady_clock::time_point deadline)
 {
 	ScriptObject::ActiveInstance active(this);
 
@@ -221,6 +244,7 @@ void ScriptInstance::GameLoop()
 			}
 			ScriptObject::SetAllowDoCommand(true);
 			/* Start the script by calling Start() */
+			this->engine->SetSuspendDeadline(deadline);
 			if (!this->engine->CallMethod(*this->instance, "Start",  _settings_game.script.script_max_opcode_till_suspend) || !this->engine->IsSuspended()) this->Died();
 		} catch (Script_Suspend &e) {
 			this->suspend  = e.GetSuspendTime();
@@ -231,6 +255,7 @@ void ScriptInstance::GameLoop()
 			this->engine->ResumeError();
 			this->Died();
 		}
+		this->EndTimeLimit();
 
 		this->is_started = true;
 		return;
@@ -241,6 +266,7 @@ void ScriptInstance::GameLoop()
 	}
 
 	/* Continue the VM */
+	this->engine->SetSuspendDeadline(deadline);
 	try {
 		if (!this->engine->Resume(_settings_game.script.script_max_opcode_till_suspend)) this->Died();
 	} catch (Script_Suspend &e) {
@@ -252,6 +278,7 @@ void ScriptInstance::GameLoop()
 		this->engine->ResumeError();
 		this->Died();
 	}
+	this->EndTimeLimit();
 }
 
 void ScriptInstance::CollectGarbage()
@@ -710,6 +737,17 @@ bool ScriptInstance::DoCommandCallback(const CommandCost &result, TileIndex tile
 	return true;
 }
 
+void ScriptInstance::ApplyDeferredCommands()
+{
+	/* The callbacks can defer new commands; those are for the next tick. */
+	std::vector<CommandContainer> commands;
+	commands.swap(this->deferred_commands);
+
+	for (const CommandContainer &command : commands) {
+		::DoCommandP(&command, false);
+	}
+}
+
 void ScriptInstance::InsertEvent(class ScriptEvent *event)
 {
 	ScriptObject::ActiveInstance active(this);
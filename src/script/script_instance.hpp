@@ -12,6 +12,7 @@
 
 #include <squirrel.h>
 #include "script_suspend.hpp"
+#include <chrono>
 
 #include "../command_type.h"
 #include "../company_type.h"
@@ -185,6 +186,12 @@ public:
 	 */
 	bool DoCommandCallback(const CommandCost &result, TileIndex tile, uint32 p1, uint32 p2, uint32 cmd);
 
+	/**
+	 * Execute the commands the script deferred till the end of the tick.
+	 * @pre _current_company is the company of the script.
+	 */
+	void ApplyDeferredCommands();
+
 	/**
 	 * Insert an event for this script.
 	 * @param event The event to insert.
@@ -200,6 +207,26 @@ public:
 
 	size_t GetAllocatedMemory() const;
 
+	/**
+	 * Get the wall-clock time the script ran, including the time spent in
+	 *  the native functions it called.
+	 * @return The total running time of the script.
+	 */
+	std::chrono::microseconds GetTotalTime() const { return std::chrono::duration_cast<std::chrono::microseconds>(this->total_time); }
+
+	/**
+	 * Get the wall-clock time the script ran in its last game loop.
+	 * @return The running time of the last game loop.
+	 */
+	std::chrono::microseconds GetLastTime() const { return std::chrono::duration_cast<std::chrono::microseconds>(this->last_time); }
+
+	/**
+	 * Get the number of times the script got suspended because it used
+	 *  up the time it is allowed to run each tick.
+	 * @return The number of suspends on time.
+	 */
+	uint32 GetTimeSuspends() const { return this->time_suspends; }
+
 	/**
 	 * Indicate whether this instance is currently being destroyed.
 	 */
@@ -256,6 +283,21 @@ private:
 	bool in_shutdown;                     ///< Is this instance currently being destructed?
 	Script_SuspendCallbackProc *callback; ///< Callback that should be called in the next tick the script runs.
 	size_t last_allocated_memory;         ///< Last known allocated memory value (for display for crashed scripts)
+	std::chrono::steady_clock::duration total_time; ///< Wall-clock time the script ran in total.
+	std::chrono::steady_clock::duration last_time;  ///< Wall-clock time the script ran in its last game loop.
+	uint32 time_suspends;                 ///< Number of times the script was suspended because its time for the tick was used up.
+	std::vector<CommandContainer> deferred_commands; ///< Commands to execute at the end of the tick, see #ApplyDeferredCommands.
+
+	/**
+	 * Run the script for one game loop.
+	 * @param deadline The moment the script has to suspend.
+	 */
+	void RunGameLoop(std::chrono::steady_clock::time_point deadline);
+
+	/**
+	 * Stop limiting the time the VM may run, and account whether it ran out of time.
+	 */
+	void EndTimeLimit();
 
 	/**
 	 * Call the script Load function if it exists and data was loaded
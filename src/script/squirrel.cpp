@@ -14,6 +14,7 @@
 #include "../string_func.h"
 #include "script_fatalerror.hpp"
 #include "../settings_type.h"
+#include "../company_func.h"
 #include <sqstdaux.h>
 #include <../squirrel/sqpcheader.h>
 #include <../squirrel/sqvm.h>
@@ -21,6 +22,7 @@
 
 #include <stdarg.h>
 #include <map>
+#include <mutex>
 
 /**
  * In the memory allocator for Squirrel we want to directly use malloc/realloc, so when the OS
@@ -180,7 +182,7 @@ struct ScriptAllocator {
  */
 #include "../safeguards.h"
 
-ScriptAllocator *_squirrel_allocator = nullptr;
+thread_local ScriptAllocator *_squirrel_allocator = nullptr;
 
 /* See 3rdparty/squirrel/squirrel/sqmem.cpp for the default allocator implementation, which this overrides */
 #ifndef SQUIRREL_DEFAULT_ALLOCATOR
@@ -189,6 +191,60 @@ void *sq_vm_realloc(void *p, SQUnsignedInteger oldsize, SQUnsignedInteger size)
 void sq_vm_free(void *p, SQUnsignedInteger size) { _squirrel_allocator->Free(p, size); }
 #endif
 
+static std::mutex _script_game_mutex;                              ///< The lock on the game, see #ScriptGameLock.
+static bool _script_concurrent = false;                            ///< Whether scripts run concurrently, so the lock has to be taken.
+static thread_local uint _script_game_lock_depth = 0;              ///< Number of times this thread holds the lock.
+static thread_local CompanyID _script_thread_company = INVALID_COMPANY; ///< Current company of this thread while it does not hold the lock.
+
+/** Take the lock on the game, and make it run as the current company of this thread. */
+static void AcquireScriptGameLock()
+{
+	_script_game_mutex.lock();
+	_current_company = _script_thread_company;
+}
+
+/** Remember the current company of this thread, and release the lock on the game. */
+static void ReleaseScriptGameLock()
+{
+	_script_thread_company = _current_company;
+	_script_game_mutex.unlock();
+}
+
+ScriptGameLock::ScriptGameLock() : locked(_script_concurrent)
+{
+	if (this->locked && _script_game_lock_depth++ == 0) AcquireScriptGameLock();
+}
+
+ScriptGameLock::~ScriptGameLock()
+{
+	if (this->locked && --_script_game_lock_depth == 0) ReleaseScriptGameLock();
+}
+
+/**
+ * Set whether scripts run concurrently. Only call this while no script is running.
+ * @param concurrent Whether scripts run concurrently from now on.
+ */
+/* static */ void ScriptGameLock::SetConcurrent(bool concurrent)
+{
+	_script_concurrent = concurrent;
+}
+
+ScriptGameUnlock::ScriptGameUnlock() : unlocked(_script_concurrent && _script_game_lock_depth == 1)
+{
+	if (!this->unlocked) return;
+
+	_script_game_lock_depth = 0;
+	ReleaseScriptGameLock();
+}
+
+ScriptGameUnlock::~ScriptGameUnlock()
+{
+	if (!this->unlocked) return;
+
+	AcquireScriptGameLock();
+	_script_game_lock_depth = 1;
+}
+
 size_t Squirrel::GetAllocatedMemory() const noexcept
 {
 	assert(this->allocator != nullptr);
@@ -198,6 +254,7 @@ size_t Squirrel::GetAllocatedMemory() const noexcept
 
 void Squirrel::CompileError(HSQUIRRELVM vm, const SQChar *desc, const SQChar *source, SQInteger line, SQInteger column)
 {
+	ScriptGameLock lock;
 	SQChar buf[1024];
 
 	seprintf(buf, lastof(buf), "Error %s:" OTTD_PRINTF64 "/" OTTD_PRINTF64 ": %s", source, line, column, desc);
@@ -215,6 +272,7 @@ void Squirrel::CompileError(HSQUIRRELVM vm, const SQChar *desc, const SQChar *so
 
 void Squirrel::ErrorPrintFunc(HSQUIRRELVM vm, const SQChar *s, ...)
 {
+	ScriptGameLock lock;
 	va_list arglist;
 	SQChar buf[1024];
 
@@ -233,6 +291,8 @@ void Squirrel::ErrorPrintFunc(HSQUIRRELVM vm, const SQChar *s, ...)
 
 void Squirrel::RunError(HSQUIRRELVM vm, const SQChar *error)
 {
+	ScriptGameLock lock;
+
 	/* Set the print function to something that prints to stderr */
 	SQPRINTFUNCTION pf = sq_getprintfunc(vm);
 	sq_setprintfunc(vm, &Squirrel::ErrorPrintFunc);
@@ -271,6 +331,7 @@ SQInteger Squirrel::_RunError(HSQUIRRELVM vm)
 
 void Squirrel::PrintFunc(HSQUIRRELVM vm, const SQChar *s, ...)
 {
+	ScriptGameLock lock;
 	va_list arglist;
 	SQChar buf[1024];
 
@@ -299,7 +360,11 @@ void Squirrel::AddMethod(const char *method_name, SQFUNCTION proc, uint nparam,
 		memcpy(ptr, userdata, size);
 	}
 
-	sq_newclosure(this->vm, proc, size != 0 ? 1 : 0);
+	/* Call the function through #_CallLocked, so it runs with the lock on the game. */
+	void *proc_ptr = sq_newuserdata(vm, sizeof(proc));
+	memcpy(proc_ptr, &proc, sizeof(proc));
+
+	sq_newclosure(this->vm, &Squirrel::_CallLocked, size != 0 ? 2 : 1);
 	if (nparam != 0) sq_setparamscheck(this->vm, nparam, params);
 	sq_setnativeclosurename(this->vm, -1, method_name);
 	sq_newslot(this->vm, -3, SQFalse);
@@ -389,12 +454,45 @@ bool Squirrel::Resume(int suspend)
 		suspend = -this->overdrawn_ops;
 	}
 
-	this->crashed = !sq_resumecatch(this->vm, suspend);
+	{
+		ScriptGameUnlock unlock;
+		this->crashed = !sq_resumecatch(this->vm, suspend);
+	}
 	this->overdrawn_ops = -this->vm->_ops_till_suspend;
 	this->allocator->CheckLimit();
 	return this->vm->_suspended != 0;
 }
 
+/* static */ SQInteger Squirrel::_CallLocked(HSQUIRRELVM vm)
+{
+	SQUserPointer ptr = nullptr;
+	sq_getuserdata(vm, -1, &ptr, 0);
+	SQFUNCTION proc;
+	memcpy(&proc, ptr, sizeof(proc));
+
+	/* Remove the function, so the stack is as if it was called directly. */
+	sq_poptop(vm);
+
+	ScriptGameLock lock;
+	return proc(vm);
+}
+
+/* static */ bool Squirrel::_SuspendCheck(HSQUIRRELVM vm)
+{
+	Squirrel *engine = (Squirrel *)sq_getforeignptr(vm);
+	if (engine->suspend_deadline == std::chrono::steady_clock::time_point::max()) return false;
+	if (std::chrono::steady_clock::now() < engine->suspend_deadline) return false;
+
+	engine->deadline_passed = true;
+	return true;
+}
+
+void Squirrel::SetSuspendDeadline(std::chrono::steady_clock::time_point deadline)
+{
+	this->suspend_deadline = deadline;
+	this->deadline_passed = false;
+}
+
 void Squirrel::ResumeError()
 {
 	assert(!this->crashed);
@@ -431,7 +529,10 @@ bool Squirrel::CallMethod(HSQOBJECT instance, const char *method_name, HSQOBJECT
 	}
 	/* Call the method */
 	sq_pushobject(this->vm, instance);
-	if (SQ_FAILED(sq_call(this->vm, 1, ret == nullptr ? SQFalse : SQTrue, SQTrue, suspend))) return false;
+	{
+		ScriptGameUnlock unlock;
+		if (SQ_FAILED(sq_call(this->vm, 1, ret == nullptr ? SQFalse : SQTrue, SQTrue, suspend))) return false;
+	}
 	if (ret != nullptr) sq_getstackobj(vm, -1, ret);
 	/* Reset the top, but don't do so for the script main function, as we need
 	 *  a correct stack when resuming. */
@@ -540,6 +641,8 @@ void Squirrel::Initialize()
 	this->print_func = nullptr;
 	this->crashed = false;
 	this->overdrawn_ops = 0;
+	this->suspend_deadline = std::chrono::steady_clock::time_point::max();
+	this->deadline_passed = false;
 	this->vm = sq_open(1024);
 
 	/* Handle compile-errors ourself, so we can display it nicely */
@@ -551,6 +654,9 @@ void Squirrel::Initialize()
 	sq_newclosure(this->vm, &Squirrel::_RunError, 0);
 	sq_seterrorhandler(this->vm);
 
+	/* Suspend the VM when a native function made it run out of time */
+	sq_setsuspendcheck(this->vm, &Squirrel::_SuspendCheck);
+
 	/* Set the foreign pointer, so we can always find this instance from within the VM */
 	sq_setforeignptr(this->vm, this);
 
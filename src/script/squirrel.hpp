@@ -11,6 +11,7 @@
 #define SQUIRREL_HPP
 
 #include <squirrel.h>
+#include <chrono>
 
 /** The type of script we're working with, i.e. for who is it? */
 enum ScriptType {
@@ -32,6 +33,8 @@ private:
 	bool crashed;            ///< True if the squirrel script made an error.
 	int overdrawn_ops;       ///< The amount of operations we have overdrawn.
 	const char *APIName;     ///< Name of the API used for this squirrel.
+	std::chrono::steady_clock::time_point suspend_deadline; ///< The moment after which the VM suspends when a native function returns.
+	bool deadline_passed;    ///< True if the VM got suspended because the deadline passed.
 	std::unique_ptr<ScriptAllocator> allocator; ///< Allocator object used by this script.
 
 	/**
@@ -39,6 +42,17 @@ private:
 	 */
 	static SQInteger _RunError(HSQUIRRELVM vm);
 
+	/**
+	 * The suspend check handler. It suspends the VM when the deadline passed.
+	 */
+	static bool _SuspendCheck(HSQUIRRELVM vm);
+
+	/**
+	 * The handler of all native functions added with #AddMethod. It calls the
+	 * real function, which is the last free variable, with the lock on the game.
+	 */
+	static SQInteger _CallLocked(HSQUIRRELVM vm);
+
 	/**
 	 * Get the API name.
 	 */
@@ -139,6 +153,19 @@ public:
 	 */
 	bool Resume(int suspend = -1);
 
+	/**
+	 * Set the moment after which the VM is suspended as soon as a native
+	 *  function returns, regardless of the operations that are left.
+	 * @param deadline The moment, or std::chrono::steady_clock::time_point::max() for no deadline.
+	 */
+	void SetSuspendDeadline(std::chrono::steady_clock::time_point deadline);
+
+	/**
+	 * Did the VM get suspended because the deadline passed?
+	 * @return True if the deadline passed since it was set.
+	 */
+	bool IsDeadlinePassed() { return this->deadline_passed; }
+
 	/**
 	 * Resume the VM with an error so it prints a stack trace.
 	 */
@@ -283,7 +310,7 @@ public:
 };
 
 
-extern ScriptAllocator *_squirrel_allocator;
+extern thread_local ScriptAllocator *_squirrel_allocator;
 
 class ScriptAllocatorScope {
 	ScriptAllocator *old_allocator;
@@ -302,4 +329,33 @@ public:
 	}
 };
 
+/**
+ * Lock on the game for scripts running concurrently, see #SetConcurrent.
+ * Only the Squirrel code of scripts runs concurrently: the game and the
+ * script API are only used by the thread holding this lock. The lock can
+ * be held recursively. The current company is kept per thread; it is the
+ * one of the thread holding the lock.
+ */
+class ScriptGameLock {
+	bool locked; ///< Whether this took the lock, i.e. scripts run concurrently.
+
+public:
+	ScriptGameLock();
+	~ScriptGameLock();
+
+	static void SetConcurrent(bool concurrent);
+};
+
+/**
+ * Release the #ScriptGameLock while running the Squirrel code of a script,
+ * when the lock is not held for anything else.
+ */
+class ScriptGameUnlock {
+	bool unlocked; ///< Whether this released the lock.
+
+public:
+	ScriptGameUnlock();
+	~ScriptGameUnlock();
+};
+
 #endif /* SQUIRREL_HPP */
@@ -361,6 +361,7 @@ struct ScriptSettings {
 	uint8  settings_profile;                 ///< difficulty profile to set initial settings of scripts, esp. random AIs
 	uint32 script_max_opcode_till_suspend;   ///< max opcode calls till scripts will suspend
 	uint32 script_max_memory_megabytes;      ///< limit on memory a single script instance may have allocated
+	uint16 script_max_time_per_tick;         ///< max milliseconds a single script may run each tick, or 0 for no limit
 };
 
 /** Settings related to the new pathfinder. */
@@ -160,6 +160,158 @@ static bool _smallmap_show_heightmap = false;
 static IndustryType _smallmap_industry_highlight = INVALID_INDUSTRYTYPE;
 /** State of highlight blinking */
 static bool _smallmap_industry_highlight_state;
+
+/**
+ * Cache of the colours of the smallmap. Every entry holds the colours that
+ * #SmallMapWindow::GetTileColours determined for a square of zoom x zoom tiles,
+ * and stays valid until a tile of the square is marked dirty. Everything is
+ * recomposed when something changes that affects all colours, like the map
+ * type or the zoom level.
+ */
+class SmallMapColourCache {
+public:
+	/** Everything that affects the colours of all entries. */
+	struct Key {
+		int map_type;                    ///< Displayed map type.
+		int zoom;                        ///< Number of tiles along each side of an entry.
+		uint offset_x;                   ///< X coordinate of the first tile of the first entry.
+		uint offset_y;                   ///< Y coordinate of the first tile of the first entry.
+		uint map_size_x;                 ///< Size of the map along the X axis.
+		uint map_size_y;                 ///< Size of the map along the Y axis.
+		byte land_colour;                ///< Colour scheme of the land.
+		bool show_heightmap;             ///< Whether the heightmap is shown in the non-contour map types.
+		IndustryType highlight;          ///< Industry type that is highlighted.
+		bool highlight_state;            ///< Whether the highlighted industries are currently drawn in white.
+
+		bool operator==(const Key &other) const
+		{
+			return this->map_type == other.map_type && this->zoom == other.zoom &&
+					this->offset_x == other.offset_x && this->offset_y == other.offset_y &&
+					this->map_size_x == other.map_size_x && this->map_size_y == other.map_size_y &&
+					this->land_colour == other.land_colour && this->show_heightmap == other.show_heightmap &&
+					this->highlight == other.highlight && this->highlight_state == other.highlight_state;
+		}
+	};
+
+private:
+	static const uint CHUNK_BITS = 6;                 ///< Chunks contain 2^CHUNK_BITS entries along each side.
+	static const uint CHUNK_SIZE = 1 << CHUNK_BITS;   ///< Number of entries along each side of a chunk.
+
+	/** A square of entries, only allocated once any of them is drawn. */
+	struct Chunk {
+		uint32 colours[CHUNK_SIZE * CHUNK_SIZE];      ///< Colours of the entries.
+		std::bitset<CHUNK_SIZE * CHUNK_SIZE> valid;   ///< Entries with up to date colours.
+	};
+
+	Key key = {};                                     ///< State the cached colours belong to.
+	uint chunks_x = 0;                                ///< Number of chunks along the X axis.
+	std::vector<std::unique_ptr<Chunk>> chunks;       ///< The chunks, \c nullptr for chunks without any cached colours.
+
+	/**
+	 * Find the position of an entry.
+	 * @param x X coordinate of a tile of the entry.
+	 * @param y Y coordinate of a tile of the entry.
+	 * @param[out] index Index of the entry in its chunk.
+	 * @return Index of the chunk, or \c SIZE_MAX if the tile does not belong to any entry.
+	 */
+	size_t FindEntry(uint x, uint y, uint *index) const
+	{
+		/* Nothing is cached before the first smallmap is drawn, or after the cache is cleared. */
+		if (this->chunks.empty() || this->key.zoom == 0) return SIZE_MAX;
+		if (x < this->key.offset_x || y < this->key.offset_y) return SIZE_MAX;
+		uint ex = (x - this->key.offset_x) / this->key.zoom;
+		uint ey = (y - this->key.offset_y) / this->key.zoom;
+		if ((ex >> CHUNK_BITS) >= this->chunks_x) return SIZE_MAX;
+		size_t chunk = (size_t)(ey >> CHUNK_BITS) * this->chunks_x + (ex >> CHUNK_BITS);
+		if (chunk >= this->chunks.size()) return SIZE_MAX;
+		*index = (ey & (CHUNK_SIZE - 1)) * CHUNK_SIZE + (ex & (CHUNK_SIZE - 1));
+		return chunk;
+	}
+
+public:
+	/**
+	 * Make sure the cache belongs to the given state, dropping all cached colours otherwise.
+	 * @param key The state of the smallmap being drawn.
+	 */
+	void Validate(const Key &key)
+	{
+		if (key == this->key && !this->chunks.empty()) return;
+
+		this->key = key;
+		uint entries_x = CeilDiv(key.map_size_x, key.zoom) + 1;
+		uint entries_y = CeilDiv(key.map_size_y, key.zoom) + 1;
+		this->chunks_x = CeilDiv(entries_x, CHUNK_SIZE);
+		this->chunks.clear();
+		this->chunks.resize((size_t)this->chunks_x * CeilDiv(entries_y, CHUNK_SIZE));
+	}
+
+	/**
+	 * Get the cached colours of the entry starting at the given tile.
+	 * @param x X coordinate of the first tile of the entry.
+	 * @param y Y coordinate of the first tile of the entry.
+	 * @param[out] colours The colours, if they are cached.
+	 * @return Whether the colours are cached.
+	 */
+	bool Lookup(uint x, uint y, uint32 *colours) const
+	{
+		uint index;
+		size_t chunk = this->FindEntry(x, y, &index);
+		if (chunk == SIZE_MAX || this->chunks[chunk] == nullptr || !this->chunks[chunk]->valid.test(index)) return false;
+		*colours = this->chunks[chunk]->colours[index];
+		return true;
+	}
+
+	/**
+	 * Store the colours of the entry starting at the given tile.
+	 * @param x X coordinate of the first tile of the entry.
+	 * @param y Y coordinate of the first tile of the entry.
+	 * @param colours The colours of the entry.
+	 */
+	void Store(uint x, uint y, uint32 colours)
+	{
+		uint index;
+		size_t chunk = this->FindEntry(x, y, &index);
+		if (chunk == SIZE_MAX) return;
+		if (this->chunks[chunk] == nullptr) this->chunks[chunk].reset(new Chunk());
+		this->chunks[chunk]->colours[index] = colours;
+		this->chunks[chunk]->valid.set(index);
+	}
+
+	/**
+	 * Drop the cached colours of the entry containing a tile.
+	 * @param tile The tile that has changed.
+	 */
+	void MarkTileDirty(TileIndex tile)
+	{
+		uint index;
+		size_t chunk = this->FindEntry(TileX(tile), TileY(tile), &index);
+		if (chunk == SIZE_MAX || this->chunks[chunk] == nullptr) return;
+		this->chunks[chunk]->valid.reset(index);
+	}
+
+	/** Drop all cached colours and free their memory. */
+	void Clear()
+	{
+		this->chunks.clear();
+	}
+};
+
+static SmallMapColourCache _smallmap_colour_cache;
+
+/**
+ * Tell the smallmap that a tile has changed, so its colours get determined again.
+ * @param tile The tile that has changed.
+ */
+void InvalidateSmallMapTile(TileIndex tile)
+{
+	_smallmap_colour_cache.MarkTileDirty(tile);
+}
+
+/** Tell the smallmap that the colours of all tiles have to be determined again. */
+void InvalidateSmallMapColours()
+{
+	_smallmap_colour_cache.Clear();
+}
 /** For connecting company ID to position in owner list (small map legend) */
 static uint _company_to_list_pos[MAX_COMPANIES];
 
@@ -857,7 +1009,11 @@ void SmallMapWindow::DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch,
 		}
 		ta.ClampToMap(); // Clamp to map boundaries (may contain MP_VOID tiles!).
 
-		uint32 val = this->GetTileColours(ta);
+		uint32 val;
+		if (!_smallmap_colour_cache.Lookup(xc, yc, &val)) {
+			val = this->GetTileColours(ta);
+			_smallmap_colour_cache.Store(xc, yc, val);
+		}
 		uint8 *val8 = (uint8 *)&val;
 		int idx = std::max(0, -start_pos);
 		for (int pos = std::max(0, start_pos); pos < end_pos; pos++) {
@@ -983,6 +1139,19 @@ void SmallMapWindow::DrawSmallMap(DrawPixelInfo *dpi) const
 	int tile_x = this->scroll_x / (int)TILE_SIZE + tile.x;
 	int tile_y = this->scroll_y / (int)TILE_SIZE + tile.y;
 
+	SmallMapColourCache::Key key;
+	key.map_type = this->map_type;
+	key.zoom = this->zoom;
+	key.offset_x = (tile_x % this->zoom + this->zoom) % this->zoom;
+	key.offset_y = (tile_y % this->zoom + this->zoom) % this->zoom;
+	key.map_size_x = MapSizeX();
+	key.map_size_y = MapSizeY();
+	key.land_colour = _settings_client.gui.smallmap_land_colour;
+	key.show_heightmap = _smallmap_show_heightmap;
+	key.highlight = this->map_type == SMT_INDUSTRY ? _smallmap_industry_highlight : INVALID_INDUSTRYTYPE;
+	key.highlight_state = key.highlight != INVALID_INDUSTRYTYPE && _smallmap_industry_highlight_state;
+	_smallmap_colour_cache.Validate(key);
+
 	void *ptr = blitter->MoveTo(dpi->dst_ptr, -dx - 4, 0);
 	int x = - dx - 4;
 	int y = 0;
@@ -1090,6 +1259,7 @@ SmallMapWindow::SmallMapWindow(WindowDesc *desc, int window_number) : Window(des
 	this->SetZoomLevel(ZLC_INITIALIZE, nullptr);
 	this->SmallMapCenterOnCurrentPos();
 	this->SetOverlayCargoMask();
+	InvalidateSmallMapColours();
 }
 
 SmallMapWindow::~SmallMapWindow()
@@ -1100,6 +1270,7 @@ SmallMapWindow::~SmallMapWindow()
 /* virtual */ void SmallMapWindow::Close()
 {
 	this->BreakIndustryChainLink();
+	InvalidateSmallMapColours();
 	this->Window::Close();
 }
 
@@ -1186,6 +1357,9 @@ void SmallMapWindow::RebuildColourIndexIfNecessary()
 	/* Width of the legend blob. */
 	this->legend_width = (FONT_HEIGHT_SMALL - ScaleFontTrad(1)) * 8 / 5;
 
+	/* The legends, and with it the colours of the map, might have changed. */
+	InvalidateSmallMapColours();
+
 	/* The width of a column is the minimum width of all texts + the size of the blob + some spacing */
 	this->column_width = min_width + this->legend_width + WD_FRAMERECT_LEFT + WD_FRAMERECT_RIGHT;
 }
@@ -1493,6 +1667,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 						this->SelectLegendItem(click_pos, _legend_land_owners, _smallmap_company_count, NUM_NO_COMPANY_ENTRIES);
 					}
 				}
+				InvalidateSmallMapColours();
 				this->SetDirty();
 			}
 			break;
@@ -1518,6 +1693,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 				tbl->show_on_map = (widget == WID_SM_ENABLE_ALL);
 			}
 			if (this->map_type == SMT_LINKSTATS) this->SetOverlayCargoMask();
+			InvalidateSmallMapColours();
 			this->SetDirty();
 			break;
 		}
@@ -1564,6 +1740,7 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 
 		default: NOT_REACHED();
 	}
+	InvalidateSmallMapColours();
 	this->SetDirty();
 }
 
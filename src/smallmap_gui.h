@@ -26,6 +26,8 @@ void BuildIndustriesLegend();
 void ShowSmallMap();
 void BuildLandLegend();
 void BuildOwnerLegend();
+void InvalidateSmallMapTile(TileIndex tile);
+void InvalidateSmallMapColours();
 
 /** Structure for holding relevant data for legends in small map */
 struct LegendAndColour {
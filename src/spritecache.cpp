@@ -33,7 +33,8 @@ struct SpriteCache {
 	size_t file_pos;
 	SpriteFile *file;    ///< The file the sprite in this entry can be found in.
 	uint32 id;
-	int16 lru;
+	SpriteID lru_prev;   ///< Previous (more recently used) sprite in the LRU list of the cache.
+	SpriteID lru_next;   ///< Next (less recently used) sprite in the LRU list of the cache.
 	SpriteType type;     ///< In some cases a single sprite is misused by two NewGRFs. Once as real sprite and once as recolour sprite. If the recolour sprite gets into the cache it might be drawn as real sprite which causes enormous trouble.
 	bool warned;         ///< True iff the user has been warned about incorrect use of this sprite
 };
@@ -104,16 +105,22 @@ SpriteFile &OpenCachedSpriteFile(const std::string &filename, Subdirectory subdi
 }
 
 struct MemBlock {
-	size_t size;
+	size_t size;  ///< Size of the block including this header; the lower bits are used as flags.
+	size_t owner; ///< Sprite the block is allocated to, only valid while the block is in use.
 	byte data[];
 };
 
-static uint _sprite_lru_counter;
+/** Marker for the ends of the LRU list and for blocks without owner. */
+static const SpriteID SPRITE_LRU_END = UINT32_MAX;
+
+static SpriteID _sprite_lru_head = SPRITE_LRU_END; ///< Most recently used sprite in the cache.
+static SpriteID _sprite_lru_tail = SPRITE_LRU_END; ///< Least recently used sprite in the cache, i.e. the first to be evicted.
 static MemBlock *_spritecache_ptr;
 static uint _allocated_sprite_cache_size = 0;
-static int _compact_cache_counter;
+static SpriteCacheStats _spritecache_stats;
+static bool _spritecache_fragmented = false; ///< Whether an allocation failed only because the free memory is scattered.
 
-static void CompactSpriteCache();
+static void DeleteEntryFromSpriteCache(uint item);
 static void *AllocSprite(size_t mem_req);
 
 /**
@@ -630,14 +637,17 @@ bool LoadNextSprite(int load_index, SpriteFile &file, uint file_sprite_id)
 	}
 
 	SpriteCache *sc = AllocateSpriteCache(load_index);
+	/* Release the sprite this one replaces, if it is cached. */
+	if (sc->ptr != nullptr) DeleteEntryFromSpriteCache(load_index);
 	sc->file = &file;
 	sc->file_pos = file_pos;
 	sc->ptr = data;
-	sc->lru = 0;
 	sc->id = file_sprite_id;
 	sc->type = type;
 	sc->warned = false;
 
+	if (data != nullptr) ((MemBlock *)data - 1)->owner = load_index;
+
 	return true;
 }
 
@@ -647,6 +657,8 @@ void DupSprite(SpriteID old_spr, SpriteID new_spr)
 	SpriteCache *scnew = AllocateSpriteCache(new_spr); // may reallocate: so put it first
 	SpriteCache *scold = GetSpriteCache(old_spr);
 
+	if (scnew->ptr != nullptr) DeleteEntryFromSpriteCache(new_spr);
+
 	scnew->file = scold->file;
 	scnew->file_pos = scold->file_pos;
 	scnew->ptr = nullptr;
@@ -656,106 +668,267 @@ void DupSprite(SpriteID old_spr, SpriteID new_spr)
 }
 
 /**
- * S_FREE_MASK is used to mask-out lower bits of MemBlock::size
- * If they are non-zero, the block is free.
- * S_FREE_MASK has to ensure MemBlock is correctly aligned -
+ * The lower bits of MemBlock::size are used as flags. They are free as
+ * S_FREE_MASK ensures MemBlock is correctly aligned -
  * it means 8B (S_FREE_MASK == 7) on 64bit systems!
  */
 static const size_t S_FREE_MASK = sizeof(size_t) - 1;
+static const size_t S_FREE      = 1; ///< Flag of MemBlock::size, set when the block is free.
+static const size_t S_PREV_FREE = 2; ///< Flag of MemBlock::size, set when the block directly in front of it is free.
 
 /* to make sure nobody adds things to MemBlock without checking S_FREE_MASK first */
-static_assert(sizeof(MemBlock) == sizeof(size_t));
+static_assert(sizeof(MemBlock) == 2 * sizeof(size_t));
 /* make sure it's a power of two */
 static_assert((sizeof(size_t) & (sizeof(size_t) - 1)) == 0);
+static_assert((S_FREE | S_PREV_FREE) <= S_FREE_MASK);
+
+/**
+ * Free blocks are kept in a doubly linked list per size class, so a fitting
+ * block can be found without walking the whole cache. The links are stored
+ * in the unused data of the free block. The size of a free block is repeated
+ * in its last bytes, so the block behind it can find and merge with it.
+ */
+struct FreeBlockLinks {
+	MemBlock *prev; ///< Previous free block in the same size class.
+	MemBlock *next; ///< Next free block in the same size class.
+};
+
+/** Smallest block size; it needs to hold the administration of a free block. */
+static const size_t S_MIN_BLOCK_SIZE = sizeof(MemBlock) + sizeof(FreeBlockLinks) + sizeof(size_t);
+/** Number of bits used to split every power of two in multiple size classes. */
+static const uint S_CLASS_SUB_BITS = 2;
+/** Number of size classes for free blocks. */
+static const uint S_NUM_CLASSES = (sizeof(size_t) * 8) << S_CLASS_SUB_BITS;
+
+static MemBlock *_free_blocks[S_NUM_CLASSES];         ///< First free block of every size class.
+static uint32 _free_block_classes[S_NUM_CLASSES / 32]; ///< Bitmask of the size classes that have free blocks.
+static size_t _spritecache_free_bytes;                 ///< Total size of the free blocks.
+
+static inline size_t GetBlockSize(const MemBlock *block)
+{
+	return block->size & ~S_FREE_MASK;
+}
 
 static inline MemBlock *NextBlock(MemBlock *block)
 {
-	return (MemBlock*)((byte*)block + (block->size & ~S_FREE_MASK));
+	return (MemBlock*)((byte*)block + GetBlockSize(block));
 }
 
-static size_t GetSpriteCacheUsage()
+/**
+ * Get the free block directly in front of a block.
+ * @param block The block to look in front of.
+ * @return The free block.
+ * @pre The block has the S_PREV_FREE flag set.
+ */
+static inline MemBlock *PrevFreeBlock(MemBlock *block)
 {
-	size_t tot_size = 0;
-	MemBlock *s;
+	assert(block->size & S_PREV_FREE);
+	size_t prev_size = *((size_t *)block - 1);
+	return (MemBlock*)((byte*)block - prev_size);
+}
 
-	for (s = _spritecache_ptr; s->size != 0; s = NextBlock(s)) {
-		if (!(s->size & S_FREE_MASK)) tot_size += s->size;
-	}
+static inline FreeBlockLinks *GetFreeBlockLinks(MemBlock *block)
+{
+	return (FreeBlockLinks *)block->data;
+}
 
-	return tot_size;
+/**
+ * Get the size class of a block.
+ * @param size Size of the block.
+ * @return The size class.
+ */
+static inline uint GetSizeClass(size_t size)
+{
+	uint bit = FindLastBit(size);
+	return (bit << S_CLASS_SUB_BITS) | (uint)((size >> (bit - S_CLASS_SUB_BITS)) & ((1 << S_CLASS_SUB_BITS) - 1));
+}
+
+/**
+ * Get the first size class in which every block is at least the given size.
+ * @param size Minimum size of the block.
+ * @return The size class.
+ */
+static inline uint GetFittingSizeClass(size_t size)
+{
+	uint bit = FindLastBit(size);
+	size_t rest = size & (((size_t)1 << (bit - S_CLASS_SUB_BITS)) - 1);
+	return GetSizeClass(size) + (rest != 0 ? 1 : 0);
 }
 
+/**
+ * Mark a block as free and add it to the free list of its size class.
+ * @param block The block to add.
+ * @param size The size of the block.
+ * @pre Neither of the blocks around it are free.
+ */
+static void InsertFreeBlock(MemBlock *block, size_t size)
+{
+	block->size = size | S_FREE;
+	*(size_t *)((byte*)block + size - sizeof(size_t)) = size;
+	assert(!(NextBlock(block)->size & S_FREE));
+	NextBlock(block)->size |= S_PREV_FREE;
+
+	uint size_class = GetSizeClass(size);
+	FreeBlockLinks *links = GetFreeBlockLinks(block);
+	links->prev = nullptr;
+	links->next = _free_blocks[size_class];
+	if (links->next != nullptr) GetFreeBlockLinks(links->next)->prev = block;
+	_free_blocks[size_class] = block;
+	SetBit(_free_block_classes[size_class / 32], size_class % 32);
+
+	_spritecache_free_bytes += size;
+}
 
-void IncreaseSpriteLRU()
+/**
+ * Remove a free block from the free list of its size class.
+ * @param block The block to remove.
+ */
+static void RemoveFreeBlock(MemBlock *block)
 {
-	/* Increase all LRU values */
-	if (_sprite_lru_counter > 16384) {
-		SpriteID i;
+	assert(block->size & S_FREE);
+	size_t size = GetBlockSize(block);
+	uint size_class = GetSizeClass(size);
+	FreeBlockLinks *links = GetFreeBlockLinks(block);
+	if (links->prev != nullptr) {
+		GetFreeBlockLinks(links->prev)->next = links->next;
+	} else {
+		_free_blocks[size_class] = links->next;
+		if (links->next == nullptr) ClrBit(_free_block_classes[size_class / 32], size_class % 32);
+	}
+	if (links->next != nullptr) GetFreeBlockLinks(links->next)->prev = links->prev;
 
-		Debug(sprite, 3, "Fixing lru {}, inuse={}", _sprite_lru_counter, GetSpriteCacheUsage());
+	_spritecache_free_bytes -= size;
+}
 
-		for (i = 0; i != _spritecache_items; i++) {
-			SpriteCache *sc = GetSpriteCache(i);
-			if (sc->ptr != nullptr) {
-				if (sc->lru >= 0) {
-					sc->lru = -1;
-				} else if (sc->lru != -32768) {
-					sc->lru--;
-				}
-			}
-		}
-		_sprite_lru_counter = 0;
+/**
+ * Find a free block that is large enough.
+ * @param size Minimum size of the block.
+ * @return The free block, or \c nullptr if there is none.
+ */
+static MemBlock *FindFreeBlock(size_t size)
+{
+	/* All blocks in these size classes are large enough. */
+	for (uint size_class = GetFittingSizeClass(size); size_class < S_NUM_CLASSES; size_class = Align(size_class + 1, 32)) {
+		uint32 classes = _free_block_classes[size_class / 32] >> (size_class % 32);
+		if (classes != 0) return _free_blocks[size_class + FindFirstBit(classes)];
 	}
 
-	/* Compact sprite cache every now and then. */
-	if (++_compact_cache_counter >= 740) {
-		CompactSpriteCache();
-		_compact_cache_counter = 0;
+	/* Some blocks in the size class of the requested size might be large enough too. */
+	for (MemBlock *block = _free_blocks[GetSizeClass(size)]; block != nullptr; block = GetFreeBlockLinks(block)->next) {
+		if (GetBlockSize(block) >= size) return block;
 	}
+	return nullptr;
 }
 
 /**
- * Called when holes in the sprite cache should be removed.
- * That is accomplished by moving the cached data.
+ * Mark a block as free and merge it with the free blocks around it.
+ * @param block The block to free.
  */
-static void CompactSpriteCache()
+static void FreeBlock(MemBlock *block)
 {
-	MemBlock *s;
+	assert(!(block->size & S_FREE));
+	size_t size = GetBlockSize(block);
+
+	if (block->size & S_PREV_FREE) {
+		MemBlock *prev = PrevFreeBlock(block);
+		RemoveFreeBlock(prev);
+		size += GetBlockSize(prev);
+		block = prev;
+	}
 
-	Debug(sprite, 3, "Compacting sprite cache, inuse={}", GetSpriteCacheUsage());
+	MemBlock *next = (MemBlock*)((byte*)block + size);
+	if (next->size & S_FREE) {
+		RemoveFreeBlock(next);
+		size += GetBlockSize(next);
+	}
 
-	for (s = _spritecache_ptr; s->size != 0;) {
-		if (s->size & S_FREE_MASK) {
-			MemBlock *next = NextBlock(s);
-			MemBlock temp;
-			SpriteID i;
+	InsertFreeBlock(block, size);
+}
 
-			/* Since free blocks are automatically coalesced, this should hold true. */
-			assert(!(next->size & S_FREE_MASK));
+static size_t GetSpriteCacheUsage()
+{
+	/* Everything but the free blocks and the sentinel block is in use. */
+	return _allocated_sprite_cache_size - sizeof(MemBlock) - _spritecache_free_bytes;
+}
 
-			/* If the next block is the sentinel block, we can safely return */
-			if (next->size == 0) break;
+/**
+ * Remove a sprite from the LRU list.
+ * @param item Sprite to remove.
+ */
+static void UnlinkSpriteLRU(SpriteID item)
+{
+	SpriteCache *sc = GetSpriteCache(item);
+	if (sc->lru_prev != SPRITE_LRU_END) {
+		GetSpriteCache(sc->lru_prev)->lru_next = sc->lru_next;
+	} else {
+		_sprite_lru_head = sc->lru_next;
+	}
+	if (sc->lru_next != SPRITE_LRU_END) {
+		GetSpriteCache(sc->lru_next)->lru_prev = sc->lru_prev;
+	} else {
+		_sprite_lru_tail = sc->lru_prev;
+	}
+	_spritecache_stats.cached_sprites--;
+}
 
-			/* Locate the sprite belonging to the next pointer. */
-			for (i = 0; GetSpriteCache(i)->ptr != next->data; i++) {
-				assert(i != _spritecache_items);
-			}
+/**
+ * Add a sprite as most recently used one to the LRU list.
+ * @param item Sprite to add.
+ */
+static void LinkSpriteLRU(SpriteID item)
+{
+	SpriteCache *sc = GetSpriteCache(item);
+	sc->lru_prev = SPRITE_LRU_END;
+	sc->lru_next = _sprite_lru_head;
+	if (_sprite_lru_head != SPRITE_LRU_END) {
+		GetSpriteCache(_sprite_lru_head)->lru_prev = item;
+	} else {
+		_sprite_lru_tail = item;
+	}
+	_sprite_lru_head = item;
+	_spritecache_stats.cached_sprites++;
+}
 
-			GetSpriteCache(i)->ptr = s->data; // Adjust sprite array entry
-			/* Swap this and the next block */
-			temp = *s;
-			memmove(s, next, next->size);
-			s = NextBlock(s);
-			*s = temp;
+/**
+ * Called when holes in the sprite cache should be removed.
+ * That is accomplished by moving all cached data to the front,
+ * so the free memory ends up in a single block at the end.
+ * @note This moves the data of cached sprites, so it must not be called while
+ *       anyone holds a pointer into the cache, e.g. the colour remap while drawing.
+ */
+static void CompactSpriteCache()
+{
+	Debug(sprite, 3, "Compacting sprite cache, inuse={}", GetSpriteCacheUsage());
 
-			/* Coalesce free blocks */
-			while (NextBlock(s)->size & S_FREE_MASK) {
-				s->size += NextBlock(s)->size & ~S_FREE_MASK;
+	byte *dest = (byte*)_spritecache_ptr;
+	MemBlock *s = _spritecache_ptr;
+	while (GetBlockSize(s) != 0) {
+		MemBlock *next = NextBlock(s);
+		if (!(s->size & S_FREE)) {
+			size_t size = GetBlockSize(s);
+			if ((byte*)s != dest) {
+				memmove(dest, s, size);
+
+				/* All blocks in front of it are in use now. */
+				MemBlock *moved = (MemBlock*)dest;
+				moved->size = size;
+				assert(moved->owner < _spritecache_items);
+				GetSpriteCache((uint)moved->owner)->ptr = moved->data; // Adjust sprite array entry
 			}
-		} else {
-			s = NextBlock(s);
+			dest += size;
 		}
+		s = next;
 	}
+
+	/* Whatever is left behind the moved blocks becomes one big free block. */
+	MemSetT(_free_blocks, 0, lengthof(_free_blocks));
+	MemSetT(_free_block_classes, 0, lengthof(_free_block_classes));
+	_spritecache_free_bytes = 0;
+	s->size = 0;
+	if ((byte*)s != dest) InsertFreeBlock((MemBlock*)dest, (byte*)s - dest);
+
+	_spritecache_fragmented = false;
+	_spritecache_stats.compactions++;
 }
 
 /**
@@ -764,82 +937,79 @@ static void CompactSpriteCache()
  */
 static void DeleteEntryFromSpriteCache(uint item)
 {
-	/* Mark the block as free (the block must be in use) */
-	MemBlock *s = (MemBlock*)GetSpriteCache(item)->ptr - 1;
-	assert(!(s->size & S_FREE_MASK));
-	s->size |= S_FREE_MASK;
-	GetSpriteCache(item)->ptr = nullptr;
-
-	/* And coalesce adjacent free blocks */
-	for (s = _spritecache_ptr; s->size != 0; s = NextBlock(s)) {
-		if (s->size & S_FREE_MASK) {
-			while (NextBlock(s)->size & S_FREE_MASK) {
-				s->size += NextBlock(s)->size & ~S_FREE_MASK;
-			}
-		}
-	}
+	SpriteCache *sc = GetSpriteCache(item);
+	/* Recolour sprites are never evicted, so they are not in the LRU list. */
+	if (sc->type != ST_RECOLOUR) UnlinkSpriteLRU(item);
+
+	FreeBlock((MemBlock*)sc->ptr - 1);
+	sc->ptr = nullptr;
 }
 
+/**
+ * Evict the least recently used sprite from the sprite cache.
+ */
 static void DeleteEntryFromSpriteCache()
 {
-	uint best = UINT_MAX;
-	int cur_lru;
-
 	Debug(sprite, 3, "DeleteEntryFromSpriteCache, inuse={}", GetSpriteCacheUsage());
 
-	cur_lru = 0xffff;
-	for (SpriteID i = 0; i != _spritecache_items; i++) {
-		SpriteCache *sc = GetSpriteCache(i);
-		if (sc->type != ST_RECOLOUR && sc->ptr != nullptr && sc->lru < cur_lru) {
-			cur_lru = sc->lru;
-			best = i;
-		}
-	}
-
 	/* Display an error message and die, in case we found no sprite at all.
 	 * This shouldn't really happen, unless all sprites are locked. */
-	if (best == UINT_MAX) error("Out of sprite memory");
+	if (_sprite_lru_tail == SPRITE_LRU_END) error("Out of sprite memory");
 
-	DeleteEntryFromSpriteCache(best);
+	_spritecache_stats.evictions++;
+	DeleteEntryFromSpriteCache(_sprite_lru_tail);
 }
 
 static void *AllocSprite(size_t mem_req)
 {
 	mem_req += sizeof(MemBlock);
 
-	/* Align this to correct boundary. This also makes sure at least one
-	 * bit is not used, so we can use it for other things. */
-	mem_req = Align(mem_req, S_FREE_MASK + 1);
+	/* Align this to correct boundary. This also makes sure the lower
+	 * bits are not used, so we can use them for other things. */
+	mem_req = std::max(Align(mem_req, S_FREE_MASK + 1), S_MIN_BLOCK_SIZE);
 
 	for (;;) {
-		MemBlock *s;
-
-		for (s = _spritecache_ptr; s->size != 0; s = NextBlock(s)) {
-			if (s->size & S_FREE_MASK) {
-				size_t cur_size = s->size & ~S_FREE_MASK;
-
-				/* Is the block exactly the size we need or
-				 * big enough for an additional free block? */
-				if (cur_size == mem_req ||
-						cur_size >= mem_req + sizeof(MemBlock)) {
-					/* Set size and in use */
-					s->size = mem_req;
-
-					/* Do we need to inject a free block too? */
-					if (cur_size != mem_req) {
-						NextBlock(s)->size = (cur_size - mem_req) | S_FREE_MASK;
-					}
-
-					return s->data;
-				}
+		MemBlock *s = FindFreeBlock(mem_req);
+		if (s != nullptr) {
+			RemoveFreeBlock(s);
+			size_t cur_size = GetBlockSize(s);
+
+			/* Set size and in use; blocks around a free block are never free. */
+			if (cur_size - mem_req >= S_MIN_BLOCK_SIZE) {
+				/* Put the remainder back as a new free block. */
+				s->size = mem_req;
+				InsertFreeBlock(NextBlock(s), cur_size - mem_req);
+			} else {
+				s->size = cur_size;
+				NextBlock(s)->size &= ~S_PREV_FREE;
 			}
+			s->owner = SPRITE_LRU_END;
+
+			return s->data;
+		}
+
+		/* No block is large enough. When a good part of the cache is free,
+		 * it is just fragmented; move the holes together at the next
+		 * opportunity instead of throwing away ever more sprites. That
+		 * cannot happen right here, as sprites are allocated while drawing
+		 * and the drawing code holds on to pointers into the cache. */
+		if (_spritecache_free_bytes >= mem_req && _spritecache_free_bytes >= _allocated_sprite_cache_size / 4) {
+			_spritecache_fragmented = true;
 		}
 
-		/* Reached sentinel, but no block found yet. Delete some old entry. */
 		DeleteEntryFromSpriteCache();
 	}
 }
 
+/**
+ * Remove the holes from the sprite cache when allocations failed because of them.
+ * Must only be called while no sprites are being drawn.
+ */
+void CompactSpriteCacheIfFragmented()
+{
+	if (_spritecache_fragmented) CompactSpriteCache();
+}
+
 /**
  * Sprite allocator simply using malloc.
  */
@@ -921,11 +1091,24 @@ void *GetRawSprite(SpriteID sprite, SpriteType type, AllocatorProc *allocator, S
 	if (allocator == nullptr && encoder == nullptr) {
 		/* Load sprite into/from spritecache */
 
-		/* Update LRU */
-		sc->lru = ++_sprite_lru_counter;
+		if (sc->ptr != nullptr) {
+			_spritecache_stats.hits++;
 
-		/* Load the sprite, if it is not loaded, yet */
-		if (sc->ptr == nullptr) sc->ptr = ReadSprite(sc, sprite, type, AllocSprite, nullptr);
+			/* Update LRU; recolour sprites are never evicted, so they are not in it. */
+			if (type != ST_RECOLOUR && _sprite_lru_head != sprite) {
+				UnlinkSpriteLRU(sprite);
+				LinkSpriteLRU(sprite);
+			}
+			return sc->ptr;
+		}
+
+		/* Load the sprite, as it is not loaded yet */
+		_spritecache_stats.misses++;
+		sc->ptr = ReadSprite(sc, sprite, type, AllocSprite, nullptr);
+		if (sc->ptr != nullptr) {
+			((MemBlock*)sc->ptr - 1)->owner = sprite;
+			LinkSpriteLRU(sprite);
+		}
 
 		return sc->ptr;
 	} else {
@@ -980,10 +1163,15 @@ static void GfxInitSpriteCache()
 		}
 	}
 
-	/* A big free block */
-	_spritecache_ptr->size = (_allocated_sprite_cache_size - sizeof(MemBlock)) | S_FREE_MASK;
+	MemSetT(_free_blocks, 0, lengthof(_free_blocks));
+	MemSetT(_free_block_classes, 0, lengthof(_free_block_classes));
+	_spritecache_free_bytes = 0;
+
 	/* Sentinel block (identified by size == 0) */
-	NextBlock(_spritecache_ptr)->size = 0;
+	((MemBlock*)((byte*)_spritecache_ptr + _allocated_sprite_cache_size - sizeof(MemBlock)))->size = 0;
+	/* A big free block */
+	InsertFreeBlock(_spritecache_ptr, _allocated_sprite_cache_size - sizeof(MemBlock));
+	_spritecache_fragmented = false;
 }
 
 void GfxInitSpriteMem()
@@ -995,7 +1183,9 @@ void GfxInitSpriteMem()
 	_spritecache_items = 0;
 	_spritecache = nullptr;
 
-	_compact_cache_counter = 0;
+	_sprite_lru_head = SPRITE_LRU_END;
+	_sprite_lru_tail = SPRITE_LRU_END;
+	_spritecache_stats.cached_sprites = 0;
 	_sprite_files.clear();
 }
 
@@ -1006,12 +1196,21 @@ void GfxInitSpriteMem()
 void GfxClearSpriteCache()
 {
 	/* Clear sprite ptr for all cached items */
-	for (uint i = 0; i != _spritecache_items; i++) {
-		SpriteCache *sc = GetSpriteCache(i);
-		if (sc->type != ST_RECOLOUR && sc->ptr != nullptr) DeleteEntryFromSpriteCache(i);
-	}
+	while (_sprite_lru_head != SPRITE_LRU_END) DeleteEntryFromSpriteCache(_sprite_lru_head);
 
 	VideoDriver::GetInstance()->ClearSystemSprites();
 }
 
+/**
+ * Get statistics about the usage of the sprite cache.
+ * @return The statistics.
+ */
+SpriteCacheStats GetSpriteCacheStats()
+{
+	SpriteCacheStats stats = _spritecache_stats;
+	stats.used_bytes = _spritecache_ptr == nullptr ? 0 : GetSpriteCacheUsage();
+	stats.total_bytes = _allocated_sprite_cache_size;
+	return stats;
+}
+
 /* static */ ReusableBuffer<SpriteLoader::CommonPixel> SpriteLoader::Sprite::buffer[ZOOM_LVL_COUNT];
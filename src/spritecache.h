@@ -26,6 +26,17 @@ extern uint _sprite_cache_size;
 
 typedef void *AllocatorProc(size_t size);
 
+/** Statistics about the usage of the sprite cache. */
+struct SpriteCacheStats {
+	uint64 hits;         ///< Number of requests for sprites that were in the cache already.
+	uint64 misses;       ///< Number of requests for sprites that had to be loaded into the cache.
+	uint64 evictions;    ///< Number of sprites removed from the cache to make room for other sprites.
+	uint64 compactions;  ///< Number of times the cache memory was compacted.
+	uint cached_sprites; ///< Number of sprites in the cache that may be evicted.
+	size_t used_bytes;   ///< Memory of the cache in use.
+	size_t total_bytes;  ///< Total memory of the cache.
+};
+
 void *SimpleSpriteAlloc(size_t size);
 void *GetRawSprite(SpriteID sprite, SpriteType type, AllocatorProc *allocator = nullptr, SpriteEncoder *encoder = nullptr);
 bool SpriteExists(SpriteID sprite);
@@ -51,7 +62,8 @@ static inline const byte *GetNonSprite(SpriteID sprite, SpriteType type)
 
 void GfxInitSpriteMem();
 void GfxClearSpriteCache();
-void IncreaseSpriteLRU();
+void CompactSpriteCacheIfFragmented();
+SpriteCacheStats GetSpriteCacheStats();
 
 SpriteFile &OpenCachedSpriteFile(const std::string &filename, Subdirectory subdir, bool palette_remap);
 
@@ -20,6 +20,7 @@
 #include "bitmap_type.h"
 #include <map>
 #include <set>
+#include <list>
 
 static const byte INITIAL_STATION_RATING = 175;
 
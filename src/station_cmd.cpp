@@ -3810,29 +3810,57 @@ static void StationHandleSmallTick(BaseStation *st)
 {
 	if ((st->facilities & FACIL_WAYPOINT) != 0 || !st->IsInUse()) return;
 
-	byte b = st->delete_ctr + 1;
-	if (b >= STATION_RATING_TICKS) b = 0;
-	st->delete_ctr = b;
+	UpdateStationRating(Station::From(st));
+}
 
-	if (b == 0) UpdateStationRating(Station::From(st));
+/**
+ * Get the lowest station index for which something has to be done this tick,
+ * when it has to be done every \a interval ticks for every station.
+ * @param interval The number of ticks between two runs for the same station.
+ * @return The index of the first station to run for.
+ */
+static inline size_t GetFirstStationTickIndex(uint interval)
+{
+	/* The stations with (_tick_counter + index) % interval == 0 are due. */
+	return (interval - _tick_counter % interval) % interval;
 }
 
 void OnTick_Station()
 {
 	if (_game_mode == GM_EDITOR) return;
 
-	for (BaseStation *st : BaseStation::Iterate()) {
-		StationHandleSmallTick(st);
+	/* Every station only has something to do once in a number of ticks, with
+	 * its index deciding in which tick. So instead of visiting all stations,
+	 * walk through the indices of the stations that are due, in increasing
+	 * order, just like visiting all stations would. */
+	size_t next_rating = GetFirstStationTickIndex(STATION_RATING_TICKS);
+	size_t next_linkgraph = GetFirstStationTickIndex(STATION_LINKGRAPH_TICKS);
+	size_t next_acceptance = GetFirstStationTickIndex(STATION_ACCEPTANCE_TICKS);
+
+	for (;;) {
+		size_t index = std::min({next_rating, next_linkgraph, next_acceptance});
+		if (index >= BaseStation::GetPoolSize()) break;
+
+		bool rating = index == next_rating;
+		bool linkgraph = index == next_linkgraph;
+		bool acceptance = index == next_acceptance;
+		if (rating) next_rating += STATION_RATING_TICKS;
+		if (linkgraph) next_linkgraph += STATION_LINKGRAPH_TICKS;
+		if (acceptance) next_acceptance += STATION_ACCEPTANCE_TICKS;
+
+		BaseStation *st = BaseStation::GetIfValid(index);
+		if (st == nullptr) continue;
+
+		/* Update the station rating every STATION_RATING_TICKS. */
+		if (rating) StationHandleSmallTick(st);
 
 		/* Clean up the link graph about once a week. */
-		if (Station::IsExpected(st) && (_tick_counter + st->index) % STATION_LINKGRAPH_TICKS == 0) {
-			DeleteStaleLinks(Station::From(st));
-		};
+		if (linkgraph && Station::IsExpected(st)) DeleteStaleLinks(Station::From(st));
 
 		/* Run STATION_ACCEPTANCE_TICKS = 250 tick interval trigger for station animation.
 		 * Station index is included so that triggers are not all done
 		 * at the same time. */
-		if ((_tick_counter + st->index) % STATION_ACCEPTANCE_TICKS == 0) {
+		if (acceptance) {
 			/* Stop processing this station if it was deleted */
 			if (!StationHandleBigTick(st)) continue;
 			TriggerStationAnimation(st, st->xy, SAT_250_TICKS);
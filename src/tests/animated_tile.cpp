@@ -0,0 +1,100 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file animated_tile.cpp Test the table of animated tiles. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../animated_tile_func.h"
+#include "../map_func.h"
+
+#include "../safeguards.h"
+
+extern std::vector<TileIndex> _animated_tiles;
+
+/** Adding and deleting tiles dirties them, so there has to be a map. */
+static void InitializeAnimatedTileTest()
+{
+	AllocateMap(64, 64);
+	InitializeAnimatedTiles();
+}
+
+TEST_CASE("AnimatedTiles - tiles are only added once")
+{
+	InitializeAnimatedTileTest();
+
+	AddAnimatedTile(10);
+	AddAnimatedTile(20);
+	AddAnimatedTile(10);
+
+	CHECK(_animated_tiles == std::vector<TileIndex>{ 10, 20 });
+}
+
+TEST_CASE("AnimatedTiles - deleting keeps the order of the other tiles")
+{
+	InitializeAnimatedTileTest();
+
+	for (TileIndex tile = 1; tile <= 6; tile++) AddAnimatedTile(tile);
+	DeleteAnimatedTile(2);
+	DeleteAnimatedTile(4);
+	DeleteAnimatedTile(100);
+
+	/* Deleted tiles keep their slot until the table is rebuilt. */
+	CHECK(_animated_tiles == std::vector<TileIndex>{ 1, INVALID_TILE, 3, INVALID_TILE, 5, 6 });
+
+	RebuildAnimatedTiles();
+	CHECK(_animated_tiles == std::vector<TileIndex>{ 1, 3, 5, 6 });
+}
+
+TEST_CASE("AnimatedTiles - the table is compacted when most tiles are deleted")
+{
+	InitializeAnimatedTileTest();
+
+	for (TileIndex tile = 1; tile <= 4; tile++) AddAnimatedTile(tile);
+	DeleteAnimatedTile(1);
+	DeleteAnimatedTile(3);
+	CHECK(_animated_tiles.size() == 4);
+
+	DeleteAnimatedTile(4);
+	CHECK(_animated_tiles == std::vector<TileIndex>{ 2 });
+}
+
+TEST_CASE("AnimatedTiles - deleted tiles can be added again")
+{
+	InitializeAnimatedTileTest();
+
+	AddAnimatedTile(1);
+	AddAnimatedTile(2);
+	AddAnimatedTile(3);
+	DeleteAnimatedTile(1);
+	AddAnimatedTile(1);
+
+	/* The deleted tile is not found anymore, so it is added at the end. */
+	RebuildAnimatedTiles();
+	CHECK(_animated_tiles == std::vector<TileIndex>{ 2, 3, 1 });
+
+	/* Deleting it again deletes the new entry. */
+	DeleteAnimatedTile(1);
+	RebuildAnimatedTiles();
+	CHECK(_animated_tiles == std::vector<TileIndex>{ 2, 3 });
+}
+
+TEST_CASE("AnimatedTiles - rebuilding removes duplicates from loaded tables")
+{
+	InitializeAnimatedTileTest();
+
+	/* Savegames store the plain table, which might contain a tile twice. */
+	_animated_tiles = { 5, 7, 5, 9 };
+	RebuildAnimatedTiles();
+	CHECK(_animated_tiles == std::vector<TileIndex>{ 5, 7, 9 });
+
+	DeleteAnimatedTile(7);
+	RebuildAnimatedTiles();
+	CHECK(_animated_tiles == std::vector<TileIndex>{ 5, 9 });
+}
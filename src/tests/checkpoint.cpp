@@ -0,0 +1,117 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file checkpoint.cpp Test saving and loading full and delta checkpoints. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../date_func.h"
+#include "../fileio_func.h"
+#include "../fios.h"
+#include "../map_func.h"
+#include "../saveload/saveload.h"
+
+#include "../safeguards.h"
+
+static const char * const FULL_CHECKPOINT = "test_checkpoint_full.sav";   ///< Name of the full checkpoint.
+static const char * const DELTA_CHECKPOINT = "test_checkpoint_delta.sav"; ///< Name of the delta checkpoint.
+static const char * const CHECKPOINT_DIR = "test_checkpoint_dir" PATHSEP;  ///< Directory to save checkpoints in.
+static const char * const MOVED_DIR = "test_checkpoint_moved" PATHSEP;     ///< Directory the checkpoints are moved to.
+
+/** Prepare a (mostly empty) game to make checkpoints of. */
+static void InitializeCheckpointTest()
+{
+	/* Files are opened relative to the working directory, but only when any search path is known. */
+	if (_valid_searchpaths.empty()) _valid_searchpaths.push_back(SP_WORKING_DIR);
+
+	AllocateMap(64, 64);
+	_date = 1000;
+}
+
+/**
+ * Get the date stored in a savegame.
+ * @param filename The savegame.
+ * @return The date, or #INVALID_DATE when the savegame could not be read.
+ */
+static Date GetCheckpointDate(const char *filename)
+{
+	if (SaveOrLoad(filename, SLO_CHECK, DFT_GAME_FILE, NO_DIRECTORY) != SL_OK || _load_check_data.HasErrors()) return INVALID_DATE;
+	return _load_check_data.current_date;
+}
+
+TEST_CASE("Checkpoint - a delta checkpoint loads the changes on top of its base")
+{
+	InitializeCheckpointTest();
+
+	REQUIRE(SaveCheckpoint(FULL_CHECKPOINT, NO_DIRECTORY, true) == SL_OK);
+	_date = 2000;
+	REQUIRE(SaveCheckpoint(DELTA_CHECKPOINT, NO_DIRECTORY, false) == SL_OK);
+
+	CHECK(GetCheckpointDate(FULL_CHECKPOINT) == 1000);
+	CHECK(GetCheckpointDate(DELTA_CHECKPOINT) == 2000);
+
+	std::remove(FULL_CHECKPOINT);
+	std::remove(DELTA_CHECKPOINT);
+}
+
+TEST_CASE("Checkpoint - a checkpoint over its own base is a full checkpoint")
+{
+	InitializeCheckpointTest();
+
+	REQUIRE(SaveCheckpoint(FULL_CHECKPOINT, NO_DIRECTORY, true) == SL_OK);
+	_date = 3000;
+	REQUIRE(SaveCheckpoint(FULL_CHECKPOINT, NO_DIRECTORY, false) == SL_OK);
+	CHECK(GetCheckpointDate(FULL_CHECKPOINT) == 3000);
+
+	/* Later deltas are made against the new full checkpoint. */
+	_date = 4000;
+	REQUIRE(SaveCheckpoint(DELTA_CHECKPOINT, NO_DIRECTORY, false) == SL_OK);
+	CHECK(GetCheckpointDate(DELTA_CHECKPOINT) == 4000);
+
+	std::remove(FULL_CHECKPOINT);
+	std::remove(DELTA_CHECKPOINT);
+}
+
+TEST_CASE("Checkpoint - a delta checkpoint finds its base after moving both")
+{
+	InitializeCheckpointTest();
+	FioCreateDirectory(CHECKPOINT_DIR);
+
+	std::string full = std::string(CHECKPOINT_DIR) + FULL_CHECKPOINT;
+	std::string delta = std::string(CHECKPOINT_DIR) + DELTA_CHECKPOINT;
+	REQUIRE(SaveCheckpoint(full, NO_DIRECTORY, true) == SL_OK);
+	_date = 5000;
+	REQUIRE(SaveCheckpoint(delta, NO_DIRECTORY, false) == SL_OK);
+
+	/* The base is found relative to the delta, not where it was saved. */
+	REQUIRE(std::rename(std::string(CHECKPOINT_DIR).c_str(), std::string(MOVED_DIR).c_str()) == 0);
+	CHECK(GetCheckpointDate((std::string(MOVED_DIR) + DELTA_CHECKPOINT).c_str()) == 5000);
+
+	std::remove((std::string(MOVED_DIR) + FULL_CHECKPOINT).c_str());
+	std::remove((std::string(MOVED_DIR) + DELTA_CHECKPOINT).c_str());
+	std::remove(std::string(MOVED_DIR).c_str());
+}
+
+TEST_CASE("Checkpoint - a checkpoint in another directory than its base is a full checkpoint")
+{
+	InitializeCheckpointTest();
+	FioCreateDirectory(CHECKPOINT_DIR);
+
+	std::string full = std::string(CHECKPOINT_DIR) + FULL_CHECKPOINT;
+	REQUIRE(SaveCheckpoint(full, NO_DIRECTORY, true) == SL_OK);
+	_date = 6000;
+	REQUIRE(SaveCheckpoint(DELTA_CHECKPOINT, NO_DIRECTORY, false) == SL_OK);
+
+	/* It does not need the other checkpoint to load. */
+	std::remove(full.c_str());
+	CHECK(GetCheckpointDate(DELTA_CHECKPOINT) == 6000);
+
+	std::remove(DELTA_CHECKPOINT);
+	std::remove(std::string(CHECKPOINT_DIR).c_str());
+}
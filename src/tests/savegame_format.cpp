@@ -0,0 +1,45 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file savegame_format.cpp Test saving and loading with the compression formats. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../date_func.h"
+#include "../fileio_func.h"
+#include "../fios.h"
+#include "../map_func.h"
+#include "../tile_map.h"
+#include "../saveload/saveload.h"
+
+#include "../safeguards.h"
+
+static const char * const SAVEGAME = "test_savegame_format.sav"; ///< Name of the savegame.
+
+TEST_CASE("SavegameFormat - a savegame of many compressed blocks loads again")
+{
+	/* Files are opened relative to the working directory, but only when any search path is known. */
+	if (_valid_searchpaths.empty()) _valid_searchpaths.push_back(SP_WORKING_DIR);
+
+	/* Enough tiles for the map to span several blocks of the multi-threaded formats. */
+	AllocateMap(512, 512);
+	for (TileIndex t = 0; t < MapSize(); t++) SetTileHeight(t, (t * 7919) % 16);
+	_date = 7000;
+
+	std::string format = GENERATE(as<std::string>(), "lzmamt:2", "lzmamt:9");
+	_savegame_format = format;
+	REQUIRE(SaveOrLoad(SAVEGAME, SLO_SAVE, DFT_GAME_FILE, NO_DIRECTORY, false) == SL_OK);
+
+	CHECK(SaveOrLoad(SAVEGAME, SLO_CHECK, DFT_GAME_FILE, NO_DIRECTORY) == SL_OK);
+	CHECK(!_load_check_data.HasErrors());
+	CHECK(_load_check_data.current_date == 7000);
+
+	_savegame_format.clear();
+	std::remove(SAVEGAME);
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file saveload_buffer.cpp Test reading and skipping savegame data. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../saveload/saveload_buffer.h"
+
+#include "../safeguards.h"
+
+/** Filter serving a savegame of which every byte is the lowest byte of its offset. */
+struct PatternLoadFilter : LoadFilter {
+	size_t size;       ///< Size of the savegame.
+	size_t pos = 0;    ///< Offset of the next byte to read.
+	size_t max_read;   ///< Maximum number of bytes to return per read, so reads end in odd places.
+	int skipped = 0;   ///< Number of times the filter was asked to skip.
+
+	PatternLoadFilter(size_t size, size_t max_read) : LoadFilter(nullptr), size(size), max_read(max_read)
+	{
+	}
+
+	size_t Read(byte *buf, size_t len) override
+	{
+		len = std::min({ len, this->max_read, this->size - this->pos });
+		for (size_t i = 0; i < len; i++) buf[i] = (byte)(this->pos + i);
+		this->pos += len;
+		return len;
+	}
+
+	size_t Skip(size_t len) override
+	{
+		this->skipped++;
+		len = std::min(len, this->size - this->pos);
+		this->pos += len;
+		return len;
+	}
+};
+
+TEST_CASE("ReadBuffer - skipping within the buffer")
+{
+	PatternLoadFilter filter(1000, 1000);
+	std::unique_ptr<ReadBuffer> buffer(new ReadBuffer(&filter));
+
+	CHECK(buffer->ReadByte() == 0);
+	buffer->Skip(10);
+	CHECK(buffer->GetSize() == 11);
+	CHECK(buffer->ReadByte() == 11);
+	CHECK(filter.skipped == 0);
+}
+
+TEST_CASE("ReadBuffer - skipping across the end of what has been read")
+{
+	PatternLoadFilter filter(10000, 1000);
+	std::unique_ptr<ReadBuffer> buffer(new ReadBuffer(&filter));
+
+	CHECK(buffer->ReadByte() == 0);
+	buffer->Skip(2500);
+	CHECK(buffer->GetSize() == 2501);
+	CHECK(buffer->ReadByte() == (byte)2501);
+	CHECK(filter.skipped == 0);
+}
+
+TEST_CASE("ReadBuffer - large skips are left to the filter")
+{
+	const size_t skip = MEMORY_CHUNK_SIZE * 3 + 7;
+	PatternLoadFilter filter(MEMORY_CHUNK_SIZE * 4, 1000);
+	std::unique_ptr<ReadBuffer> buffer(new ReadBuffer(&filter));
+
+	CHECK(buffer->ReadByte() == 0);
+	buffer->Skip(skip);
+	CHECK(filter.skipped == 1);
+	CHECK(buffer->GetSize() == 1 + skip);
+	CHECK(buffer->ReadByte() == (byte)(1 + skip));
+
+	/* Reading continues normally after the skip. */
+	byte data[3];
+	buffer->Read(data, lengthof(data));
+	CHECK(data[0] == (byte)(2 + skip));
+	CHECK(data[2] == (byte)(4 + skip));
+	CHECK(buffer->GetSize() == 5 + skip);
+}
+
+TEST_CASE("ReadBuffer - skipping past the end is an error")
+{
+	PatternLoadFilter small(100, 1000);
+	std::unique_ptr<ReadBuffer> buffer(new ReadBuffer(&small));
+	CHECK_THROWS(buffer->Skip(200));
+
+	PatternLoadFilter large(MEMORY_CHUNK_SIZE, 1000);
+	buffer.reset(new ReadBuffer(&large));
+	CHECK_THROWS(buffer->Skip(MEMORY_CHUNK_SIZE * 2));
+}
@@ -0,0 +1,111 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file script_list.cpp Test the iteration over script lists. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../script/api/script_list.hpp"
+
+#include "../safeguards.h"
+
+/**
+ * Iterate over a list like a foreach in a script does.
+ * @param list The list to iterate over.
+ * @param visit Called for every visited item, before going to the next one.
+ * @return The visited items, in order.
+ */
+template <typename Tvisit>
+static std::vector<int64> Iterate(ScriptList &list, Tvisit visit)
+{
+	std::vector<int64> visited;
+	for (int64 item = list.Begin(); !list.IsEnd(); item = list.Next()) {
+		visited.push_back(item);
+		visit(item);
+	}
+	return visited;
+}
+
+static std::vector<int64> Iterate(ScriptList &list)
+{
+	return Iterate(list, [](int64) {});
+}
+
+TEST_CASE("ScriptList - iteration follows the sorter")
+{
+	ScriptList list;
+	list.AddItem(1, 10);
+	list.AddItem(2, 30);
+	list.AddItem(3, 20);
+	list.AddItem(4, 20);
+
+	/* By default lists are sorted descending by value; equal values are in exactly the reverse order of ascending. */
+	CHECK(Iterate(list) == std::vector<int64>{ 2, 4, 3, 1 });
+
+	list.Sort(ScriptList::SORT_BY_VALUE, ScriptList::SORT_ASCENDING);
+	CHECK(Iterate(list) == std::vector<int64>{ 1, 3, 4, 2 });
+
+	list.Sort(ScriptList::SORT_BY_ITEM, ScriptList::SORT_DESCENDING);
+	CHECK(Iterate(list) == std::vector<int64>{ 4, 3, 2, 1 });
+}
+
+TEST_CASE("ScriptList - items added during iteration are not visited")
+{
+	ScriptList list;
+	list.AddItem(1, 10);
+	list.AddItem(2, 20);
+
+	std::vector<int64> visited = Iterate(list, [&list](int64 item) {
+		list.AddItem(item + 10, 100);
+	});
+	CHECK(visited == std::vector<int64>{ 2, 1 });
+	CHECK(list.Count() == 4);
+}
+
+TEST_CASE("ScriptList - items revalued during iteration keep their position")
+{
+	ScriptList list;
+	list.AddItem(1, 10);
+	list.AddItem(2, 20);
+	list.AddItem(3, 30);
+
+	/* Moving the visited item to the front or the back does not make it visited again or skip others. */
+	std::vector<int64> visited = Iterate(list, [&list](int64 item) {
+		list.SetValue(item, item == 3 ? 0 : 100);
+	});
+	CHECK(visited == std::vector<int64>{ 3, 2, 1 });
+
+	/* The next iteration uses the new values. */
+	CHECK(Iterate(list) == std::vector<int64>{ 2, 1, 3 });
+}
+
+TEST_CASE("ScriptList - items removed during iteration are skipped")
+{
+	ScriptList list;
+	for (int64 item = 1; item <= 5; item++) list.AddItem(item, item);
+
+	std::vector<int64> visited = Iterate(list, [&list](int64 item) {
+		if (item == 5) list.RemoveItem(4);
+		if (item == 3) list.RemoveItem(3);
+	});
+	CHECK(visited == std::vector<int64>{ 5, 3, 2, 1 });
+	CHECK(Iterate(list) == std::vector<int64>{ 5, 2, 1 });
+}
+
+TEST_CASE("ScriptList - removing all items ends the iteration")
+{
+	ScriptList list;
+	list.AddItem(1, 1);
+	list.AddItem(2, 2);
+
+	std::vector<int64> visited = Iterate(list, [&list](int64) {
+		list.Clear();
+	});
+	CHECK(visited == std::vector<int64>{ 2 });
+}
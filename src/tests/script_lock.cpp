@@ -0,0 +1,115 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file script_lock.cpp Test running scripts concurrently with the lock on the game. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../company_func.h"
+#include "../thread.h"
+#include "../script/squirrel.hpp"
+
+#include <atomic>
+
+#include "../safeguards.h"
+
+/** Script calling a native function in a loop. */
+static const char * const TEST_SCRIPT =
+	"function Run() {\n"
+	"	local sum = 0;\n"
+	"	for (local i = 0; i < 5000; i++) {\n"
+	"		sum += i;\n"
+	"		CheckGame();\n"
+	"	}\n"
+	"	return sum;\n"
+	"}\n";
+
+static std::atomic<int> _natives_running; ///< Number of native functions running at the moment.
+static std::atomic<bool> _lock_failed;    ///< Whether a native function ran without the game to itself.
+
+/**
+ * Native function checking it has the game to itself, as the company of the script.
+ * @param vm The VM of the script.
+ * @return The number of return values.
+ */
+static SQInteger CheckGame(HSQUIRRELVM vm)
+{
+	CompanyID company = (CompanyID)(size_t)Squirrel::GetGlobalPointer(vm);
+
+	if (_natives_running++ != 0 || _current_company != company) _lock_failed = true;
+	std::this_thread::yield();
+	if (_current_company != company) _lock_failed = true;
+	_natives_running--;
+
+	return 0;
+}
+
+/**
+ * Create a script engine with the test script.
+ * @param engine The engine.
+ * @param company The company of the script.
+ * @param[out] root The root table of the script.
+ */
+static void InitializeScript(Squirrel &engine, CompanyID company, HSQOBJECT *root)
+{
+	engine.SetGlobalPointer((void *)(size_t)company);
+	engine.AddMethod("CheckGame", &CheckGame);
+
+	ScriptAllocatorScope alloc_scope(&engine);
+	HSQUIRRELVM vm = engine.GetVM();
+	REQUIRE(SQ_SUCCEEDED(sq_compilebuffer(vm, TEST_SCRIPT, strlen(TEST_SCRIPT), "test", SQTrue)));
+	sq_pushroottable(vm);
+	REQUIRE(SQ_SUCCEEDED(sq_call(vm, 1, SQFalse, SQTrue)));
+	sq_pop(vm, 1);
+
+	sq_pushroottable(vm);
+	sq_getstackobj(vm, -1, root);
+	sq_pop(vm, 1);
+}
+
+/**
+ * Run the test script, like the thread of an AI does.
+ * @param engine The engine of the script.
+ * @param company The company of the script.
+ * @param root The root table of the script.
+ * @param[out] ok Whether running the script succeeded.
+ */
+static void RunScript(Squirrel *engine, CompanyID company, HSQOBJECT root, bool *ok)
+{
+	ScriptGameLock lock;
+	_current_company = company;
+	*ok = engine->CallMethod(root, "Run", -1);
+}
+
+TEST_CASE("ScriptGameLock - native functions of concurrent scripts take turns")
+{
+	Squirrel engine_a("test");
+	Squirrel engine_b("test");
+	HSQOBJECT root_a, root_b;
+	InitializeScript(engine_a, (CompanyID)1, &root_a);
+	InitializeScript(engine_b, (CompanyID)2, &root_b);
+
+	CompanyID old_company = _current_company;
+	_natives_running = 0;
+	_lock_failed = false;
+	bool ok_a = false;
+	bool ok_b = false;
+
+	ScriptGameLock::SetConcurrent(true);
+	std::thread thread;
+	bool started = StartNewThread(&thread, "ottd:test", &RunScript, &engine_b, (CompanyID)2, HSQOBJECT(root_b), &ok_b);
+	RunScript(&engine_a, (CompanyID)1, root_a, &ok_a);
+	if (started) thread.join();
+	ScriptGameLock::SetConcurrent(false);
+	_current_company = old_company;
+
+	CHECK(ok_a);
+	CHECK((ok_b || !started));
+	CHECK(!_lock_failed);
+}
@@ -0,0 +1,91 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file sprite_group.cpp Test compiling deterministic sprite groups. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../newgrf_spritegroup.h"
+
+#include "../safeguards.h"
+
+/**
+ * Create a compiled deterministic sprite group with one adjust.
+ * @param operation The operation of the adjust.
+ * @param subroutine The group to resolve for the value of the adjust, or \c nullptr to read variable 0x10.
+ * @param default_group The group to select.
+ * @return The sprite group.
+ */
+static DeterministicSpriteGroup *CreateDeterministicGroup(DeterministicSpriteGroupAdjustOperation operation, const SpriteGroup *subroutine, const SpriteGroup *default_group)
+{
+	REQUIRE(DeterministicSpriteGroup::CanAllocateItem());
+	DeterministicSpriteGroup *group = new DeterministicSpriteGroup();
+	group->var_scope = VSG_SCOPE_SELF;
+	group->size = DSG_SIZE_DWORD;
+	group->calculated_result = false;
+	group->default_group = default_group;
+	group->error_group = default_group;
+
+	DeterministicSpriteGroupAdjust &adjust = group->adjusts.emplace_back();
+	adjust.operation = operation;
+	adjust.type = DSGA_TYPE_NONE;
+	adjust.variable = subroutine == nullptr ? 0x10 : 0x7E;
+	adjust.parameter = 0;
+	adjust.shift_num = 0;
+	adjust.and_mask = UINT32_MAX;
+	adjust.add_val = 0;
+	adjust.divmod_val = 0;
+	adjust.subroutine = subroutine;
+
+	group->Compile();
+	return group;
+}
+
+TEST_CASE("SpriteGroup - a subroutine that stores into persistent storage is not verified")
+{
+	DeterministicSpriteGroup *store = CreateDeterministicGroup(DSGA_OP_STOP, nullptr, nullptr);
+	DeterministicSpriteGroup *group = CreateDeterministicGroup(DSGA_OP_ADD, store, nullptr);
+
+	CHECK(store->stores_persistent);
+	CHECK(group->stores_persistent);
+
+	_spritegroup_pool.CleanPool();
+}
+
+TEST_CASE("SpriteGroup - a subroutine selecting a group that stores into persistent storage is not verified")
+{
+	DeterministicSpriteGroup *store = CreateDeterministicGroup(DSGA_OP_STOP, nullptr, nullptr);
+
+	REQUIRE(RandomizedSpriteGroup::CanAllocateItem());
+	RandomizedSpriteGroup *random = new RandomizedSpriteGroup();
+	random->groups.push_back(nullptr);
+	random->groups.push_back(store);
+
+	DeterministicSpriteGroup *select = CreateDeterministicGroup(DSGA_OP_ADD, nullptr, random);
+	DeterministicSpriteGroup *group = CreateDeterministicGroup(DSGA_OP_ADD, select, nullptr);
+
+	CHECK(!select->stores_persistent);
+	CHECK(group->stores_persistent);
+
+	/* Only a subroutine is resolved twice; a selected group is resolved once. */
+	DeterministicSpriteGroup *selecting = CreateDeterministicGroup(DSGA_OP_ADD, nullptr, select);
+	CHECK(!selecting->stores_persistent);
+
+	_spritegroup_pool.CleanPool();
+}
+
+TEST_CASE("SpriteGroup - a subroutine without persistent storage is verified")
+{
+	DeterministicSpriteGroup *read = CreateDeterministicGroup(DSGA_OP_STO, nullptr, nullptr);
+	DeterministicSpriteGroup *group = CreateDeterministicGroup(DSGA_OP_ADD, read, nullptr);
+
+	CHECK(!group->stores_persistent);
+
+	_spritegroup_pool.CleanPool();
+}
@@ -0,0 +1,77 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file town_growth.cpp Test the schedule of growing towns. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../map_func.h"
+#include "../settings_type.h"
+#include "../town.h"
+
+#include "../safeguards.h"
+
+extern void TownsMonthlyLoop();
+
+/**
+ * Create a single town that is growing and in the growth schedule.
+ * @return The town.
+ */
+static Town *CreateGrowingTown()
+{
+	AllocateMap(64, 64);
+	_town_pool.CleanPool();
+
+	REQUIRE(Town::CanAllocateItem());
+	Town *t = new Town(TileXY(32, 32));
+	SetBit(t->flags, TOWN_IS_GROWING);
+	t->growth_rate = 100;
+	t->grow_counter = 50;
+	RebuildTownGrowthSchedule();
+	return t;
+}
+
+/** Remove the town again, so other tests start without towns. */
+static void RemoveTowns()
+{
+	_town_pool.CleanPool();
+	RebuildTownGrowthSchedule();
+}
+
+TEST_CASE("TownGrowth - the schedule follows a town that stops growing")
+{
+	Town *t = CreateGrowingTown();
+	REQUIRE(IsTownGrowthScheduleValid());
+
+	/* Without funding this stops the growth in the monthly update, after
+	 * the growth rate has been updated with the town still growing. */
+	_settings_game.economy.town_growth_rate = 0;
+	t->fund_buildings_months = 0;
+	TownsMonthlyLoop();
+
+	CHECK(!HasBit(t->flags, TOWN_IS_GROWING));
+	CHECK(IsTownGrowthScheduleValid());
+
+	RemoveTowns();
+}
+
+TEST_CASE("TownGrowth - the schedule follows the new growth rate of a funded town")
+{
+	Town *t = CreateGrowingTown();
+
+	_settings_game.economy.town_growth_rate = 2;
+	t->fund_buildings_months = 3;
+	TownsMonthlyLoop();
+
+	CHECK(HasBit(t->flags, TOWN_IS_GROWING));
+	CHECK(t->growth_rate != 100);
+	CHECK(IsTownGrowthScheduleValid());
+
+	RemoveTowns();
+}
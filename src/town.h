@@ -84,7 +84,8 @@ struct Town : TownPool::PoolItem<&_town_pool> {
 
 	uint16 time_until_rebuild;       ///< time until we rebuild a house
 
-	uint16 grow_counter;             ///< counter to count when to grow, value is smaller than or equal to growth_rate
+	uint16 grow_counter;             ///< counter to count when to grow, value is smaller than or equal to growth_rate; use #GetGrowCounter for the current value
+	uint64 grow_counter_tick;        ///< NOSAVE: Town tick at which #grow_counter was last brought up to date.
 	uint16 growth_rate;              ///< town growth rate
 
 	byte fund_buildings_months;      ///< fund buildings program in action?
@@ -107,6 +108,7 @@ struct Town : TownPool::PoolItem<&_town_pool> {
 	~Town();
 
 	void InitializeLayout(TownLayout layout);
+	uint16 GetGrowCounter() const;
 
 	/**
 	 * Calculate the max town noise.
@@ -151,6 +153,9 @@ void ShowTownViewWindow(TownID town);
 void ExpandTown(Town *t);
 
 void RebuildTownKdtree();
+void UpdateTownGrowCounters();
+void RebuildTownGrowthSchedule();
+bool IsTownGrowthScheduleValid();
 
 
 /**
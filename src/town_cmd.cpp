@@ -49,6 +49,8 @@
 #include "ai/ai.hpp"
 #include "game/game.hpp"
 
+#include <set>
+
 #include "table/strings.h"
 #include "table/town_land.h"
 
@@ -98,10 +100,14 @@ static bool TestTownOwnsBridge(TileIndex tile, const Town *t)
 	return town_owned;
 }
 
+static void UnscheduleTownGrowth(const Town *t);
+
 Town::~Town()
 {
 	if (CleaningPool()) return;
 
+	UnscheduleTownGrowth(this);
+
 	/* Delete town authority window
 	 * and remove from list of sorted towns */
 	CloseWindowById(WC_TOWN_VIEW, this->index);
@@ -810,29 +816,183 @@ static void ChangeTileOwner_Town(TileIndex tile, Owner old_owner, Owner new_owne
 
 static bool GrowTown(Town *t);
 
+/** Number of times the town tick handler has run; not saved as only differences matter. */
+static uint64 _town_ticks = 0;
+/** The towns with a lower index have been handled by the currently running town tick. */
+static TownID _town_tick_cursor = INVALID_TOWN;
+/** Growing towns in order of the town tick at which they grow next, and their index. */
+static std::set<std::pair<uint64, TownID>> _town_growth_schedule;
+
+/**
+ * Get the number of town ticks a town has been handled for so far. This
+ * differs for towns before and after the one being handled right now.
+ * @param t The town to get it for.
+ * @return The number of handled town ticks.
+ */
+static inline uint64 GetTownTicksDone(const Town *t)
+{
+	return t->index < _town_tick_cursor ? _town_ticks : _town_ticks - 1;
+}
+
+/**
+ * Get the current value of the grow counter. For growing towns the counter
+ * is not decreased every tick; instead the value stored in #grow_counter is
+ * the value at the tick #grow_counter_tick.
+ * @return The value the grow counter would have when decreasing it every tick.
+ */
+uint16 Town::GetGrowCounter() const
+{
+	if (!HasBit(this->flags, TOWN_IS_GROWING)) return this->grow_counter;
+	return this->grow_counter - (uint16)(GetTownTicksDone(this) - this->grow_counter_tick);
+}
+
+/**
+ * Get the town tick at which a growing town grows next.
+ * @param t The town to get it for.
+ * @return The town tick.
+ */
+static inline uint64 GetTownGrowthTick(const Town *t)
+{
+	return t->grow_counter_tick + t->grow_counter + 1;
+}
+
+/**
+ * Bring the stored grow counter of a town up to date.
+ * @param t The town to update.
+ */
+static void SyncTownGrowCounter(Town *t)
+{
+	t->grow_counter = t->GetGrowCounter();
+	t->grow_counter_tick = GetTownTicksDone(t);
+}
+
+/**
+ * Remove a town from the growth schedule, if it is in there.
+ * @param t The town to remove.
+ */
+static void UnscheduleTownGrowth(const Town *t)
+{
+	if (HasBit(t->flags, TOWN_IS_GROWING)) _town_growth_schedule.erase({GetTownGrowthTick(t), t->index});
+}
+
+/**
+ * Add a town to the growth schedule, if it is growing.
+ * @param t The town to add.
+ */
+static void ScheduleTownGrowth(const Town *t)
+{
+	if (HasBit(t->flags, TOWN_IS_GROWING)) _town_growth_schedule.insert({GetTownGrowthTick(t), t->index});
+}
+
+/**
+ * Keeps the growth schedule in order for a town whose grow counter or
+ * growing state is changed during the lifetime of this object. Changes
+ * may be nested; only the outermost one for a town touches the schedule,
+ * as the state may still change after an inner one has ended.
+ */
+struct TownGrowCounterChange {
+	static std::vector<const Town *> active; ///< Towns for which a change is in progress.
+
+	Town *t;    ///< The town that is changed.
+	bool outer; ///< Whether this is the outermost change of the town.
+
+	/**
+	 * Prepare a town for changing its grow counter or growing state.
+	 * @param t The town that is changed.
+	 */
+	TownGrowCounterChange(Town *t) : t(t), outer(std::find(active.begin(), active.end(), t) == active.end())
+	{
+		if (!this->outer) return;
+
+		active.push_back(t);
+		UnscheduleTownGrowth(t);
+		SyncTownGrowCounter(t);
+	}
+
+	/** Schedule the next growth with the new state of the town. */
+	~TownGrowCounterChange()
+	{
+		if (!this->outer) return;
+
+		active.erase(std::find(active.begin(), active.end(), this->t));
+		ScheduleTownGrowth(this->t);
+	}
+};
+
+/* static */ std::vector<const Town *> TownGrowCounterChange::active;
+
+/** Store the current grow counter of all towns in Town::grow_counter, e.g. for saving. */
+void UpdateTownGrowCounters()
+{
+	for (Town *t : Town::Iterate()) SyncTownGrowCounter(t);
+}
+
+/** Rebuild the growth schedule from the grow counters of all towns, e.g. after loading. */
+void RebuildTownGrowthSchedule()
+{
+	_town_growth_schedule.clear();
+	_town_tick_cursor = INVALID_TOWN;
+
+	for (Town *t : Town::Iterate()) {
+		t->grow_counter_tick = _town_ticks;
+		ScheduleTownGrowth(t);
+	}
+}
+
+/**
+ * Check whether the growth schedule lists exactly the growing towns, at the tick they grow next.
+ * @return True iff the schedule matches the state of the towns.
+ */
+bool IsTownGrowthScheduleValid()
+{
+	std::set<std::pair<uint64, TownID>> expected;
+	for (const Town *t : Town::Iterate()) {
+		if (HasBit(t->flags, TOWN_IS_GROWING)) expected.insert({GetTownGrowthTick(t), t->index});
+	}
+	return expected == _town_growth_schedule;
+}
+
+/**
+ * Grow a town whose grow counter has run out.
+ * @param t The town to grow.
+ */
 static void TownTickHandler(Town *t)
 {
-	if (HasBit(t->flags, TOWN_IS_GROWING)) {
-		int i = (int)t->grow_counter - 1;
-		if (i < 0) {
-			if (GrowTown(t)) {
-				i = t->growth_rate;
-			} else {
-				/* If growth failed wait a bit before retrying */
-				i = std::min<uint16>(t->growth_rate, TOWN_GROWTH_TICKS - 1);
-			}
-		}
-		t->grow_counter = i;
+	_town_tick_cursor = t->index;
+
+	int i;
+	if (GrowTown(t)) {
+		i = t->growth_rate;
+	} else {
+		/* If growth failed wait a bit before retrying */
+		i = std::min<uint16>(t->growth_rate, TOWN_GROWTH_TICKS - 1);
 	}
+
+	/* Growing might have rescheduled the town already. */
+	UnscheduleTownGrowth(t);
+	t->grow_counter = i;
+	t->grow_counter_tick = _town_ticks;
+	ScheduleTownGrowth(t);
+
+	_town_tick_cursor = t->index + 1;
 }
 
 void OnTick_Town()
 {
 	if (_game_mode == GM_EDITOR) return;
 
-	for (Town *t : Town::Iterate()) {
+	/* The grow counters of all growing towns are decreased implicitly by
+	 * advancing the tick; only towns whose counter runs out are handled,
+	 * in the order of their index. */
+	_town_ticks++;
+
+	while (!_town_growth_schedule.empty() && _town_growth_schedule.begin()->first <= _town_ticks) {
+		Town *t = Town::Get(_town_growth_schedule.begin()->second);
+		_town_growth_schedule.erase(_town_growth_schedule.begin());
 		TownTickHandler(t);
 	}
+
+	_town_tick_cursor = INVALID_TOWN;
 }
 
 /**
@@ -1821,6 +1981,7 @@ static void DoCreateTown(Town *t, TileIndex tile, uint32 townnameparts, TownSize
 	/* Spread growth across ticks so even if there are many
 	 * similar towns they're unlikely to grow all in one tick */
 	t->grow_counter = t->index % TOWN_GROWTH_TICKS;
+	t->grow_counter_tick = GetTownTicksDone(t);
 	t->growth_rate = TownTicksToGameTicks(250);
 	t->show_zone = false;
 
@@ -2862,6 +3023,7 @@ CommandCost CmdTownGrowthRate(TileIndex tile, DoCommandFlag flags, uint32 p1, ui
 	if (t == nullptr) return CMD_ERROR;
 
 	if (flags & DC_EXEC) {
+		TownGrowCounterChange change(t);
 		if (p2 == 0) {
 			/* Just clear the flag, UpdateTownGrowth will determine a proper growth rate */
 			ClrBit(t->flags, TOWN_CUSTOM_GROWTH);
@@ -3196,6 +3358,8 @@ static CommandCost TownActionFundBuildings(Town *t, DoCommandFlag flags)
 	if (!_settings_game.economy.fund_buildings) return CMD_ERROR;
 
 	if (flags & DC_EXEC) {
+		TownGrowCounterChange change(t);
+
 		/* And grow for 3 months */
 		t->fund_buildings_months = 3;
 
@@ -3482,6 +3646,7 @@ static uint GetNormalGrowthRate(Town *t)
 static void UpdateTownGrowthRate(Town *t)
 {
 	if (HasBit(t->flags, TOWN_CUSTOM_GROWTH)) return;
+	TownGrowCounterChange change(t);
 	uint old_rate = t->growth_rate;
 	t->growth_rate = GetNormalGrowthRate(t);
 	UpdateTownGrowCounter(t, old_rate);
@@ -3494,6 +3659,7 @@ static void UpdateTownGrowthRate(Town *t)
  */
 static void UpdateTownGrowth(Town *t)
 {
+	TownGrowCounterChange change(t);
 	UpdateTownGrowthRate(t);
 
 	ClrBit(t->flags, TOWN_IS_GROWING);
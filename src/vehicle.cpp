@@ -365,25 +365,37 @@ byte VehicleRandomBits()
 	return GB(Random(), 0, 8);
 }
 
-/* Size of the hash, 6 = 64 x 64, 7 = 128 x 128. Larger sizes will (in theory) reduce hash
- * lookup times at the expense of memory usage. */
-const int HASH_BITS = 7;
-const int HASH_SIZE = 1 << HASH_BITS;
-const int HASH_MASK = HASH_SIZE - 1;
-const int TOTAL_HASH_SIZE = 1 << (HASH_BITS * 2);
-const int TOTAL_HASH_MASK = TOTAL_HASH_SIZE - 1;
+/* The tile hash covers the whole map without wrapping around, as long as that takes at most
+ * 2^TILE_HASH_MAX_BITS buckets. Larger maps are covered by buckets of multiple tiles, so the
+ * memory usage of the hash stays limited. */
+static const uint TILE_HASH_MAX_BITS = 20;
 
-/* Resolution of the hash, 0 = 1*1 tile, 1 = 2*2 tiles, 2 = 4*4 tiles, etc.
- * Profiling results show that 0 is fastest. */
-const int HASH_RES = 0;
+static uint _tile_hash_bits_x; ///< Number of bits of the X coordinate used in the tile hash.
+static uint _tile_hash_bits_y; ///< Number of bits of the Y coordinate used in the tile hash.
+/* Resolution of the hash, 0 = 1*1 tile, 1 = 2*2 tiles, 2 = 4*4 tiles, etc. */
+static uint _tile_hash_res;
 
-static Vehicle *_vehicle_tile_hash[TOTAL_HASH_SIZE];
+static std::vector<Vehicle *> _vehicle_tile_hash;
+
+/**
+ * Get the bucket of the tile hash for a tile.
+ * @param x The X coordinate of the tile.
+ * @param y The Y coordinate of the tile.
+ * @return The hash bucket.
+ */
+static inline Vehicle **GetTileHashBucket(uint x, uint y)
+{
+	return &_vehicle_tile_hash[GB(x, _tile_hash_res, _tile_hash_bits_x) | (GB(y, _tile_hash_res, _tile_hash_bits_y) << _tile_hash_bits_x)];
+}
 
 static Vehicle *VehicleFromTileHash(int xl, int yl, int xu, int yu, void *data, VehicleFromPosProc *proc, bool find_first)
 {
-	for (int y = yl; ; y = (y + (1 << HASH_BITS)) & (HASH_MASK << HASH_BITS)) {
-		for (int x = xl; ; x = (x + 1) & HASH_MASK) {
-			Vehicle *v = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+	const int mask_x = (1 << _tile_hash_bits_x) - 1;
+	const int mask_y = (1 << _tile_hash_bits_y) - 1;
+
+	for (int y = yl; ; y = (y + 1) & mask_y) {
+		for (int x = xl; ; x = (x + 1) & mask_x) {
+			Vehicle *v = _vehicle_tile_hash[x | (y << _tile_hash_bits_x)];
 			for (; v != nullptr; v = v->hash_tile_next) {
 				Vehicle *a = proc(v, data);
 				if (find_first && a != nullptr) return a;
@@ -413,10 +425,10 @@ static Vehicle *VehicleFromPosXY(int x, int y, void *data, VehicleFromPosProc *p
 	const int COLL_DIST = 6;
 
 	/* Hash area to scan is from xl,yl to xu,yu */
-	int xl = GB((x - COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS);
-	int xu = GB((x + COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS);
-	int yl = GB((y - COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS) << HASH_BITS;
-	int yu = GB((y + COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS) << HASH_BITS;
+	int xl = GB((x - COLL_DIST) / TILE_SIZE, _tile_hash_res, _tile_hash_bits_x);
+	int xu = GB((x + COLL_DIST) / TILE_SIZE, _tile_hash_res, _tile_hash_bits_x);
+	int yl = GB((y - COLL_DIST) / TILE_SIZE, _tile_hash_res, _tile_hash_bits_y);
+	int yu = GB((y + COLL_DIST) / TILE_SIZE, _tile_hash_res, _tile_hash_bits_y);
 
 	return VehicleFromTileHash(xl, yl, xu, yu, data, proc, find_first);
 }
@@ -468,10 +480,7 @@ bool HasVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc)
  */
 static Vehicle *VehicleFromPos(TileIndex tile, void *data, VehicleFromPosProc *proc, bool find_first)
 {
-	int x = GB(TileX(tile), HASH_RES, HASH_BITS);
-	int y = GB(TileY(tile), HASH_RES, HASH_BITS) << HASH_BITS;
-
-	Vehicle *v = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+	Vehicle *v = *GetTileHashBucket(TileX(tile), TileY(tile));
 	for (; v != nullptr; v = v->hash_tile_next) {
 		if (v->tile != tile) continue;
 
@@ -617,9 +626,7 @@ static void UpdateVehicleTileHash(Vehicle *v, bool remove)
 	if (remove) {
 		new_hash = nullptr;
 	} else {
-		int x = GB(TileX(v->tile), HASH_RES, HASH_BITS);
-		int y = GB(TileY(v->tile), HASH_RES, HASH_BITS) << HASH_BITS;
-		new_hash = &_vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
+		new_hash = GetTileHashBucket(TileX(v->tile), TileY(v->tile));
 	}
 
 	if (old_hash == new_hash) return;
@@ -668,11 +675,62 @@ static void UpdateVehicleViewportHash(Vehicle *v, int x, int y, int old_x, int o
 	}
 }
 
+/**
+ * Clear the vehicle hashes, and size the tile hash for the current map.
+ * All vehicles have to be added to the hashes again afterwards.
+ */
 void ResetVehicleHash()
 {
 	for (Vehicle *v : Vehicle::Iterate()) { v->hash_tile_current = nullptr; }
 	memset(_vehicle_viewport_hash, 0, sizeof(_vehicle_viewport_hash));
-	memset(_vehicle_tile_hash, 0, sizeof(_vehicle_tile_hash));
+
+	uint map_bits = MapLogX() + MapLogY();
+	_tile_hash_res = map_bits > TILE_HASH_MAX_BITS ? (map_bits - TILE_HASH_MAX_BITS + 1) / 2 : 0;
+	_tile_hash_bits_x = MapLogX() - _tile_hash_res;
+	_tile_hash_bits_y = MapLogY() - _tile_hash_res;
+	_vehicle_tile_hash.assign((size_t)1 << (_tile_hash_bits_x + _tile_hash_bits_y), nullptr);
+}
+
+/**
+ * Get statistics of the chains in a tile hash with the given layout,
+ * for all vehicles that are currently in the tile hash.
+ * @param bits_x Number of bits of the X coordinate used in the hash.
+ * @param bits_y Number of bits of the Y coordinate used in the hash.
+ * @param res Resolution of the hash, 0 = 1*1 tile, 1 = 2*2 tiles, etc.
+ * @return The statistics.
+ */
+static VehicleTileHashStats CalcVehicleTileHashStats(uint bits_x, uint bits_y, uint res)
+{
+	std::vector<uint> chains((size_t)1 << (bits_x + bits_y), 0);
+	VehicleTileHashStats stats = {};
+	stats.buckets = (uint)chains.size();
+
+	for (const Vehicle *v : Vehicle::Iterate()) {
+		if (v->hash_tile_current == nullptr) continue;
+		chains[GB(TileX(v->tile), res, bits_x) | (GB(TileY(v->tile), res, bits_y) << bits_x)]++;
+		stats.vehicles++;
+	}
+
+	for (uint length : chains) {
+		if (length == 0) continue;
+		stats.used_buckets++;
+		stats.longest_chain = std::max(stats.longest_chain, length);
+		/* Looking up the tile of each of the vehicles in the chain walks the whole chain. */
+		stats.lookup_length += (uint64)length * length;
+	}
+
+	return stats;
+}
+
+/**
+ * Get statistics of the chains in the vehicle tile hash.
+ * @param legacy Get the statistics of the fixed 128x128 tile hash that was used before the hash was sized by the map, for comparison.
+ * @return The statistics.
+ */
+VehicleTileHashStats GetVehicleTileHashStats(bool legacy)
+{
+	if (legacy) return CalcVehicleTileHashStats(7, 7, 0);
+	return CalcVehicleTileHashStats(_tile_hash_bits_x, _tile_hash_bits_y, _tile_hash_res);
 }
 
 void ResetVehicleColourMap()
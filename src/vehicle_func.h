@@ -51,6 +51,17 @@ void VehicleLengthChanged(const Vehicle *u);
 
 byte VehicleRandomBits();
 void ResetVehicleHash();
+
+/** Statistics of the chains of the vehicle tile hash. */
+struct VehicleTileHashStats {
+	uint buckets;         ///< Number of buckets in the hash.
+	uint used_buckets;    ///< Number of buckets with at least one vehicle.
+	uint vehicles;        ///< Number of vehicles in the hash.
+	uint longest_chain;   ///< Number of vehicles in the longest chain.
+	uint64 lookup_length; ///< Sum of the chain lengths walked when looking up the tile of each vehicle.
+};
+
+VehicleTileHashStats GetVehicleTileHashStats(bool legacy);
 void ResetVehicleColourMap();
 
 byte GetBestFittingSubType(Vehicle *v_from, Vehicle *v_for, CargoID dest_cargo_type);
@@ -12,6 +12,8 @@
 #include "../blitter/factory.hpp"
 #include "../saveload/saveload.h"
 #include "../window_func.h"
+#include "../framerate_type.h"
+#include "../debug.h"
 #include "null_v.h"
 
 #include "../safeguards.h"
@@ -29,6 +31,9 @@ const char *VideoDriver_Null::Start(const StringList &parm)
 	this->UpdateAutoResolution();
 
 	this->ticks = GetDriverParamInt(parm, "ticks", 1000);
+	this->warmup_ticks = GetDriverParamInt(parm, "warmup", 0);
+	const char *benchmark = GetDriverParam(parm, "benchmark");
+	this->benchmark = benchmark != nullptr ? benchmark : "";
 	_screen.width  = _screen.pitch = _cur_resolution.width;
 	_screen.height = _cur_resolution.height;
 	_screen.dst_ptr = nullptr;
@@ -48,12 +53,22 @@ void VideoDriver_Null::MainLoop()
 {
 	uint i;
 
-	for (i = 0; i < this->ticks; i++) {
+	for (i = 0; i < this->warmup_ticks + this->ticks; i++) {
+		if (i == this->warmup_ticks && !this->benchmark.empty()) StartFramerateBenchmark();
+
 		::GameLoop();
 		::InputLoop();
 		::UpdateWindows();
 	}
 
+	if (!this->benchmark.empty()) {
+		if (WriteFramerateBenchmarkReport(this->benchmark.c_str())) {
+			Debug(misc, 0, "Benchmark report of {} ticks written to '{}'", this->ticks, this->benchmark);
+		} else {
+			Debug(misc, 0, "Failed to write benchmark report to '{}'", this->benchmark);
+		}
+	}
+
 	/* If requested, make a save just before exit. The normal exit-flow is
 	 * not triggered from this driver, so we have to do this manually. */
 	if (_settings_client.gui.autosave_on_exit) {
@@ -15,7 +15,9 @@
 /** The null video driver. */
 class VideoDriver_Null : public VideoDriver {
 private:
-	uint ticks; ///< Amount of ticks to run.
+	uint ticks;            ///< Amount of ticks to run.
+	uint warmup_ticks;     ///< Amount of ticks to run before the benchmark starts.
+	std::string benchmark; ///< File to write the benchmark report to, if any.
 
 public:
 	const char *Start(const StringList &param) override;
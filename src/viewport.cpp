@@ -88,9 +88,16 @@
 #include "command_func.h"
 #include "network/network_func.h"
 #include "framerate_type.h"
+#include "newgrf_debug.h"
+#include "spritecache.h"
+#include "thread.h"
+#include "smallmap_gui.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <forward_list>
 #include <map>
+#include <mutex>
 #include <stack>
 
 #include "table/strings.h"
@@ -1638,6 +1645,233 @@ static void ViewportDrawParentSprites(const ParentSpriteToSortVector *psd, const
 	}
 }
 
+/** Width and height of the screen tiles a viewport is split into for drawing it on multiple threads, in pixels. */
+static const int VIEWPORT_SCREEN_TILE_SIZE = 256;
+/** Maximum number of threads drawing the screen tiles of a viewport. */
+static const uint VIEWPORT_MAX_DRAW_THREADS = 8;
+
+/** Sprite of a viewport that is ready to be drawn by any thread. */
+struct ViewportSpriteToDraw {
+	PreparedViewportSprite sprite; ///< The sprite with its sprite cache data.
+	const SubSprite *sub;          ///< only draw a rectangular part of the sprite
+	int32 x;                       ///< screen X coordinate of sprite
+	int32 y;                       ///< screen Y coordinate of sprite
+};
+
+/**
+ * Pool of threads drawing the screen tiles of a viewport. Each screen tile
+ * draws all sprites overlapping it in the same order as the single-threaded
+ * drawing, so the result is the same.
+ */
+class ViewportDrawThreads {
+	std::vector<std::thread> threads;           ///< The worker threads.
+	std::mutex lock;                            ///< Lock for the members below.
+	std::condition_variable work_cv;            ///< Signalled when there are new screen tiles to draw.
+	std::condition_variable done_cv;            ///< Signalled when the last thread finished drawing.
+	uint generation = 0;                        ///< Number of the current batch of screen tiles.
+	uint busy = 0;                              ///< Number of threads still working on the current batch.
+	bool exit = false;                          ///< Whether the threads have to stop.
+	bool started = false;                       ///< Whether starting the threads has been tried already.
+
+	std::atomic<size_t> next_tile;              ///< Index of the next screen tile to draw.
+
+public:
+	std::vector<ViewportSpriteToDraw> sprites;  ///< All sprites of the viewport in drawing order.
+	std::vector<DrawPixelInfo> tiles;           ///< Area of each screen tile.
+	std::vector<std::vector<uint>> tile_sprites; ///< Indices of the sprites overlapping each screen tile.
+	std::vector<TimingMeasurement> durations;   ///< Time it took to draw each screen tile.
+
+	~ViewportDrawThreads()
+	{
+		{
+			std::lock_guard<std::mutex> guard(this->lock);
+			this->exit = true;
+		}
+		this->work_cv.notify_all();
+		for (std::thread &thread : this->threads) thread.join();
+	}
+
+	/**
+	 * Start the threads, if not done already.
+	 * @return Whether there are any threads to draw with.
+	 */
+	bool Start()
+	{
+		if (!this->started) {
+			this->started = true;
+			uint num_threads = std::min(std::thread::hardware_concurrency(), VIEWPORT_MAX_DRAW_THREADS);
+			for (uint i = 1; i < num_threads; i++) {
+				std::thread thread;
+				if (!StartNewThread(&thread, "ottd:viewport", &ViewportDrawThreads::WorkerThread, this)) break;
+				this->threads.push_back(std::move(thread));
+			}
+		}
+		return !this->threads.empty();
+	}
+
+	/** Draw all screen tiles, using the worker threads and the current thread. */
+	void Draw()
+	{
+		this->durations.resize(this->tiles.size());
+		this->next_tile = 0;
+		{
+			std::lock_guard<std::mutex> guard(this->lock);
+			this->generation++;
+			this->busy = (uint)this->threads.size();
+		}
+		this->work_cv.notify_all();
+
+		this->DrawTiles();
+
+		std::unique_lock<std::mutex> guard(this->lock);
+		this->done_cv.wait(guard, [this]() { return this->busy == 0; });
+	}
+
+private:
+	/** Draw screen tiles until none are left. */
+	void DrawTiles()
+	{
+		for (size_t i = this->next_tile++; i < this->tiles.size(); i = this->next_tile++) {
+			TimingMeasurement start = GetPerformanceTimer();
+			const DrawPixelInfo *dpi = &this->tiles[i];
+			for (uint index : this->tile_sprites[i]) {
+				const ViewportSpriteToDraw &vs = this->sprites[index];
+				DrawPreparedSpriteViewport(dpi, vs.sprite, vs.x, vs.y, vs.sub);
+			}
+			this->durations[i] = GetPerformanceTimer() - start;
+		}
+	}
+
+	/**
+	 * Main loop of the worker threads.
+	 * @param self The pool the thread belongs to.
+	 */
+	static void WorkerThread(ViewportDrawThreads *self)
+	{
+		uint generation = 0;
+		std::unique_lock<std::mutex> guard(self->lock);
+		for (;;) {
+			self->work_cv.wait(guard, [&]() { return self->exit || self->generation != generation; });
+			if (self->exit) return;
+			generation = self->generation;
+
+			guard.unlock();
+			self->DrawTiles();
+			guard.lock();
+
+			if (--self->busy == 0) self->done_cv.notify_one();
+		}
+	}
+};
+
+static ViewportDrawThreads _vp_draw_threads;
+
+/**
+ * Prepare a sprite for drawing it on multiple threads and register it with
+ * the screen tiles it overlaps.
+ * @param image Image number to draw.
+ * @param pal Palette to use.
+ * @param x Screen X coordinate of the sprite.
+ * @param y Screen Y coordinate of the sprite.
+ * @param sub Only draw a rectangular part of the sprite.
+ * @param columns Number of columns of screen tiles.
+ * @param tile_size Size of the screen tiles, scaled by zoom.
+ * @return False if the sprite cannot be drawn on multiple threads.
+ */
+static bool AddViewportSpriteToDraw(SpriteID image, PaletteID pal, int x, int y, const SubSprite *sub, int columns, int tile_size)
+{
+	ViewportDrawThreads &vdt = _vp_draw_threads;
+	ViewportSpriteToDraw &vs = vdt.sprites.emplace_back();
+	if (!PrepareSpriteViewport(image, pal, vs.sprite)) return false;
+	vs.sub = sub;
+	vs.x = x;
+	vs.y = y;
+
+	/* Screen tiles covered by the sprite; drawing the sprite clips it further. */
+	const Sprite *spr = vs.sprite.sprite;
+	int left = x + spr->x_offs - _vd.dpi.left;
+	int top = y + spr->y_offs - _vd.dpi.top;
+	int right = left + spr->width - 1;
+	int bottom = top + spr->height - 1;
+	if (right < 0 || bottom < 0 || left >= _vd.dpi.width || top >= _vd.dpi.height) return true;
+
+	int rows = (int)vdt.tiles.size() / columns;
+	int first_column = std::max(0, left) / tile_size;
+	int last_column = std::min(columns - 1, right / tile_size);
+	int first_row = std::max(0, top) / tile_size;
+	int last_row = std::min(rows - 1, bottom / tile_size);
+	for (int row = first_row; row <= last_row; row++) {
+		for (int column = first_column; column <= last_column; column++) {
+			vdt.tile_sprites[row * columns + column].push_back((uint)vdt.sprites.size() - 1);
+		}
+	}
+	return true;
+}
+
+/**
+ * Draw the tile sprites and the sorted parent sprites of the viewport by
+ * splitting it into screen tiles that are drawn on multiple threads. The
+ * sprites are looked up in the sprite cache beforehand, so the threads do
+ * not need to touch it.
+ * @param tstdv Tile sprites to draw.
+ * @param psd Sorted parent sprites to draw.
+ * @param csstdv Child sprites of the parent sprites.
+ * @return False if the sprites have not been drawn and have to be drawn on the current thread instead.
+ */
+static bool ViewportDrawSpritesThreaded(const TileSpriteToDrawVector *tstdv, const ParentSpriteToSortVector *psd, const ChildScreenSpriteToDrawVector *csstdv)
+{
+	/* The sprite picker collects sprites while drawing, which cannot be done from multiple threads. */
+	if (_newgrf_debug_sprite_picker.mode != SPM_NONE) return false;
+
+	int tile_size = ScaleByZoom(VIEWPORT_SCREEN_TILE_SIZE, _vd.dpi.zoom);
+	int columns = CeilDiv(_vd.dpi.width, tile_size);
+	int rows = CeilDiv(_vd.dpi.height, tile_size);
+	if (columns * rows < 2) return false;
+	if (!_vp_draw_threads.Start()) return false;
+
+	ViewportDrawThreads &vdt = _vp_draw_threads;
+	Blitter *blitter = BlitterFactory::GetCurrentBlitter();
+	vdt.tiles.resize(columns * rows);
+	vdt.tile_sprites.resize(columns * rows);
+	for (int row = 0; row < rows; row++) {
+		for (int column = 0; column < columns; column++) {
+			DrawPixelInfo &dpi = vdt.tiles[row * columns + column];
+			dpi = _vd.dpi;
+			dpi.left += column * tile_size;
+			dpi.top += row * tile_size;
+			dpi.width = std::min(tile_size, _vd.dpi.width - column * tile_size);
+			dpi.height = std::min(tile_size, _vd.dpi.height - row * tile_size);
+			dpi.dst_ptr = blitter->MoveTo(_vd.dpi.dst_ptr, column * VIEWPORT_SCREEN_TILE_SIZE, row * VIEWPORT_SCREEN_TILE_SIZE);
+			vdt.tile_sprites[row * columns + column].clear();
+		}
+	}
+
+	/* Looking up sprites may load other sprites, which could evict or move
+	 * the sprites looked up before. In that case draw the usual way. */
+	SpriteCacheStats stats = GetSpriteCacheStats();
+	bool prepared = true;
+	vdt.sprites.clear();
+	for (const TileSpriteToDraw &ts : *tstdv) {
+		prepared = prepared && AddViewportSpriteToDraw(ts.image, ts.pal, ts.x, ts.y, ts.sub, columns, tile_size);
+	}
+	for (const ParentSpriteToDraw *ps : *psd) {
+		if (ps->image != SPR_EMPTY_BOUNDING_BOX) prepared = prepared && AddViewportSpriteToDraw(ps->image, ps->pal, ps->x, ps->y, ps->sub, columns, tile_size);
+
+		int child_idx = ps->first_child;
+		while (child_idx >= 0) {
+			const ChildScreenSpriteToDraw *cs = csstdv->data() + child_idx;
+			child_idx = cs->next;
+			prepared = prepared && AddViewportSpriteToDraw(cs->image, cs->pal, ps->left + cs->x, ps->top + cs->y, cs->sub, columns, tile_size);
+		}
+	}
+	SpriteCacheStats new_stats = GetSpriteCacheStats();
+	if (!prepared || new_stats.evictions != stats.evictions || new_stats.compactions != stats.compactions) return false;
+
+	vdt.Draw();
+	PerformanceAccumulator::AddParts(PFE_DRAWWORLD, vdt.durations.data(), vdt.durations.size());
+	return true;
+}
+
 /**
  * Draws the bounding boxes of all ParentSprites
  * @param psd Array of ParentSprites
@@ -1744,14 +1978,16 @@ void ViewportDoDraw(const Viewport *vp, int left, int top, int right, int bottom
 
 	DrawTextEffects(&_vd.dpi);
 
-	if (_vd.tile_sprites_to_draw.size() != 0) ViewportDrawTileSprites(&_vd.tile_sprites_to_draw);
-
 	for (auto &psd : _vd.parent_sprites_to_draw) {
 		_vd.parent_sprites_to_sort.push_back(&psd);
 	}
 
 	_vp_sprite_sorter(&_vd.parent_sprites_to_sort);
-	ViewportDrawParentSprites(&_vd.parent_sprites_to_sort, &_vd.child_screen_sprites_to_draw);
+
+	if (!ViewportDrawSpritesThreaded(&_vd.tile_sprites_to_draw, &_vd.parent_sprites_to_sort, &_vd.child_screen_sprites_to_draw)) {
+		if (_vd.tile_sprites_to_draw.size() != 0) ViewportDrawTileSprites(&_vd.tile_sprites_to_draw);
+		ViewportDrawParentSprites(&_vd.parent_sprites_to_sort, &_vd.child_screen_sprites_to_draw);
+	}
 
 	if (_draw_bounding_boxes) ViewportDrawBoundingBoxes(&_vd.parent_sprites_to_sort);
 	if (_draw_dirty_blocks) ViewportDrawDirtyBlocks();
@@ -1992,6 +2228,7 @@ void MarkTileDirtyByTile(TileIndex tile, int bridge_level_offset, int tile_heigh
 			pt.y - MAX_TILE_EXTENT_TOP - ZOOM_LVL_BASE * TILE_HEIGHT * bridge_level_offset,
 			pt.x + MAX_TILE_EXTENT_RIGHT,
 			pt.y + MAX_TILE_EXTENT_BOTTOM);
+	InvalidateSmallMapTile(tile);
 }
 
 /**